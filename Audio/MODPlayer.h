@@ -0,0 +1,1187 @@
+//----------------------------------------------------------------------------------------------------------------------
+// MOD Player sequencer (pattern and effect processing) that drives SoftSynth voices
+// Copyright (c) 2026 Samuel Gomes
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "../Core/Types.h"
+#include "../Debug/Debug.h"
+#include "../Math/Math.h"
+#include "SoftSynth.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+struct MODPlayer {
+    static constexpr uint8_t NOTE_NONE = 132;              // note will be set to this when there is nothing
+    static constexpr uint8_t NOTE_KEY_OFF = 133;           // key off note
+    static constexpr uint8_t NOTE_NO_VOLUME = 255;         // when a note has no volume, then it will be set to this
+    static constexpr int16_t INSTRUMENT_VOLUME_MAX = 64;   // this is the maximum volume of any MOD instrument
+    static constexpr uint8_t PATTERN_MARKER = 254;         // S3M marker pattern
+    static constexpr uint8_t PATTERN_END = 255;            // S3M end-of-song
+    static constexpr uint8_t S3M_GLOBAL_VOLUME_MAX = 64;   // S3M global volume maximum value
+    static constexpr uint8_t SONG_BPM_DEFAULT = 125;       // default song BPM when it is not specified
+    static constexpr uint32_t AMIGA_PAULA_CLOCK = 14317056; // period to frequency conversion constant
+    static constexpr uint16_t C2SPD_DEFAULT = 8363;        // the C2 speed of an instrument with no finetune
+    static constexpr uint8_t SINE_TABLE_SIZE = 32;         // number of entries in the sine table
+    static constexpr uint8_t INVERT_LOOP_TABLE_SIZE = 16;  // number of entries in the invert loop speed table
+
+    enum Effect : uint8_t {
+        ARPEGGIO = 0,
+        PORTAMENTO_UP,
+        PORTAMENTO_DOWN,
+        PORTAMENTO,
+        VIBRATO,
+        PORTAMENTO_VOLUME_SLIDE,
+        VIBRATO_VOLUME_SLIDE,
+        TREMOLO,
+        PANNING_8,
+        SAMPLE_OFFSET,
+        VOLUME_SLIDE,
+        POSITION_JUMP,
+        VOLUME,
+        PATTERN_BREAK,
+        EXTENDED,
+        SPEED_TEMPO,
+        SPEED,
+        VOLUME_FINE_SLIDE,
+        PORTAMENTO_EXTRA_FINE_DOWN,
+        PORTAMENTO_EXTRA_FINE_UP,
+        TREMOR,
+        VIBRATO_VOLUME_FINE_SLIDE,
+        PORTAMENTO_VOLUME_FINE_SLIDE,
+        CHANNEL_VOLUME,
+        CHANNEL_VOLUME_SLIDE,
+        PANNING_FINE_SLIDE,
+        NOTE_RETRIGGER_VOLUME_SLIDE,
+        PANBRELLO_WAVEFORM,
+        PATTERN_FINE_DELAY,
+        SOUND_CONTROL,
+        HIGH_OFFSET,
+        TEMPO,
+        VIBRATO_FINE,
+        GLOBAL_VOLUME,
+        GLOBAL_VOLUME_SLIDE,
+        PANBRELLO,
+        MIDI_MACRO,
+    };
+
+    enum ExtendedEffect : uint8_t {
+        EXTENDED_FILTER = 0,
+        EXTENDED_PORTAMENTO_FINE_UP,
+        EXTENDED_PORTAMENTO_FINE_DOWN,
+        EXTENDED_GLISSANDO_CONTROL,
+        EXTENDED_VIBRATO_WAVEFORM,
+        EXTENDED_FINETUNE,
+        EXTENDED_PATTERN_LOOP,
+        EXTENDED_TREMOLO_WAVEFORM,
+        EXTENDED_PANNING_4,
+        EXTENDED_NOTE_RETRIGGER,
+        EXTENDED_VOLUME_FINE_SLIDE_UP,
+        EXTENDED_VOLUME_FINE_SLIDE_DOWN,
+        EXTENDED_NOTE_CUT,
+        EXTENDED_NOTE_DELAY,
+        EXTENDED_PATTERN_DELAY,
+        EXTENDED_INVERT_LOOP,
+    };
+
+    struct Note {
+        uint8_t note;       // contains info on 1 note
+        uint8_t instrument; // instrument number to play
+        uint8_t volume;     // volume value. Not used for MODs. 255 = no volume
+        uint8_t effect;     // effect number
+        uint8_t operand;    // effect parameters
+    };
+
+    struct Instrument {
+        uint32_t length;        // sample length in bytes
+        uint16_t c2Spd;         // sample finetune is converted to c2spd
+        uint8_t volume;         // volume: 0 - 64
+        uint32_t loopStart;     // loop start (or just start; usually 0) in bytes
+        uint32_t loopEnd;       // loop end (or just end; usually length) in bytes
+        int32_t playMode;       // the playack mode (supported by SoftSynth)
+        uint8_t bytesPerSample; // 1 for 8-bit, 2 for 16-bit, 4 for 32-bit etc.
+        uint8_t channels;       // number of channels per frame
+    };
+
+    struct Channel {
+        uint8_t instrument;            // instrument number to be mixed
+        int16_t volume;                // channel volume. This is signed because we need -ve values & to clip properly
+        bool restart;                  // set this to true to retrigger the sample
+        uint8_t note;                  // last note set in channel
+        int32_t period;                // this is the period of the playing sample used by various effects
+        int32_t lastPeriod;            // last period set in channel
+        uint32_t startPosition;        // this is starting position of the sample. Usually zero else value from sample offset effect
+        int16_t patternLoopRow;        // this (signed) is the beginning of the loop in the pattern for effect E6x
+        uint8_t patternLoopRowCounter; // this is a loop counter for effect E6x
+        int32_t portamentoTo;          // frequency to porta to value for E3x
+        uint8_t portamentoSpeed;       // porta speed for E3x
+        int8_t vibratoPosition;        // vibrato position in the sine table for E4x (signed)
+        uint8_t vibratoSpeed;          // vibrato speed
+        uint8_t vibratoDepth;          // vibrato depth
+        int8_t tremoloPosition;        // tremolo position in the sine table (signed)
+        uint8_t tremoloSpeed;          // tremolo speed
+        uint8_t tremoloDepth;          // tremolo depth
+        uint8_t waveControl;           // waveform type for vibrato and tremolo (4 bits each)
+        bool useGlissando;             // flag to enable glissando (E3x) for subsequent porta-to-note effect
+        uint8_t invertLoopSpeed;       // invert loop speed for EFx
+        uint16_t invertLoopDelay;      // invert loop delay for EFx
+        uint32_t invertLoopPosition;   // position in the sample where we are for the invert loop effect
+        uint8_t lastVolumeSlide;       // last S3M volume slide value
+        uint8_t lastPortamento;        // last S3M portamento up or down value
+        uint8_t tremorPosition;        // tremor position
+        uint8_t tremorParameters;      // tremor parameters
+        uint8_t retriggerVolumeSlide;  // last retrigger volume slide
+        uint8_t retriggerTickCount;    // last retrigger tick count
+    };
+
+    std::vector<Note> patterns;                   // pattern data stored as (pattern, row, channel)
+    std::vector<uint16_t> orders;                 // order list
+    std::vector<Instrument> instruments;          // instrument info
+    std::vector<Channel> channels;                // channel info
+    std::vector<uint16_t> periodTable;            // Amiga period table
+    std::vector<uint8_t> sineTable;               // sine table used for effects
+    std::vector<uint8_t> invertLoopSpeedTable;    // invert loop speed table for EFx
+    Instrument noInstrument;                      // used when a pattern refers to an instrument that the song does not have
+    uint8_t rows;                                 // number of rows in each pattern
+    uint8_t endJumpOrder;                         // this is used for jumping to an order if global looping is on
+    uint8_t defaultSpeed;                         // default song speed
+    uint8_t defaultBPM;                           // default song BPM
+    bool useST300VolumeSlides;                    // ST3.00 volume slides - if enabled, all volume slides occur every tick
+    int32_t orderPosition;                        // the position in the order list. Signed so that we can properly wrap
+    int16_t patternRow;                           // points to the pattern row to be played. This is signed because sometimes we need to set it to -1
+    uint16_t tickPattern;                         // pattern number for MODPlayer_UpdateRow() & MODPlayer_UpdateTick()
+    int16_t tickPatternRow;                       // pattern row number for MODPlayer_UpdateRow() & MODPlayer_UpdateTick() (signed)
+    bool isLooping;                               // set this to true to loop the song once we reach the max order specified in the song
+    bool isPlaying;                               // this is set to true as long as the song is playing
+    bool isPaused;                                // set this to true to pause playback
+    uint8_t patternDelay;                         // number of times to delay pattern for effect EE
+    uint8_t speed;                                // current song speed
+    uint8_t BPM;                                  // current song BPM
+    uint8_t tick;                                 // current song tick
+    uint32_t tempoTimerValue;                     // (mixer_sample_rate * default_bpm) / 50
+    uint32_t framesPerTick;                       // this is the amount of sample frames we have to mix per tick based on mixerRate & bpm
+    uint32_t activeChannels;                      // the last channel that got a new note on the current row
+    bool useAmigaLPF;                             // use Amiga 12 dB/oct Butterworth low-pass filter
+
+    /// @brief Returns a note from the pattern data. Patterns that the song does not have are empty
+    Note GetNote(uint16_t pattern, int16_t row, uint8_t channel) const {
+        if (pattern >= patterns.size() / (size_t(rows) * channels.size()) or row < 0 or row >= rows or channel >= channels.size())
+            return {NOTE_NONE, 0, NOTE_NO_VOLUME, 0, 0};
+
+        return patterns[(size_t(pattern) * rows + row) * channels.size() + channel];
+    }
+
+    /// @brief Returns an instrument. Instruments that the song does not have have no sample
+    Instrument &GetInstrument(uint8_t instrument) {
+        return instrument < instruments.size() ? instruments[instrument] : noInstrument;
+    }
+
+    /// @brief Returns true once __MODPlayer_SetTables() has loaded the lookup tables
+    bool HasTables() const {
+        return !periodTable.empty() and sineTable.size() >= SINE_TABLE_SIZE and invertLoopSpeedTable.size() >= INVERT_LOOP_TABLE_SIZE;
+    }
+};
+
+static std::unique_ptr<MODPlayer> g_MODPlayer; // global song object (nullptr when no song is loaded)
+
+/// @brief Creates an empty song. Any previous song is discarded. The pattern data, orders, instruments and tables are then set using the
+/// functions below
+/// @return True on success
+inline qb_bool __MODPlayer_Initialize(uint32_t channels, uint16_t orders, uint8_t rows, uint16_t patterns, uint32_t instruments, uint8_t endJumpOrder,
+                                      uint8_t defaultSpeed, uint8_t defaultBPM, qb_bool useST300VolumeSlides) {
+    g_MODPlayer.reset();
+
+    // Channels are addressed using 8-bit numbers (see __MODPlayer_SetNote)
+    if (!channels or channels > UINT8_MAX or !rows) {
+        return QB_FALSE;
+    }
+
+    g_MODPlayer = std::make_unique<MODPlayer>();
+    if (!g_MODPlayer) {
+        return QB_FALSE;
+    }
+
+    auto &song = *g_MODPlayer;
+    song.patterns.assign(size_t(patterns) * rows * channels, {MODPlayer::NOTE_NONE, 0, MODPlayer::NOTE_NO_VOLUME, 0, 0});
+    song.orders.assign(orders, 0);
+    song.instruments.assign(instruments, {});
+    song.channels.assign(channels, {});
+    song.noInstrument = {};
+    song.noInstrument.c2Spd = MODPlayer::C2SPD_DEFAULT;
+    song.noInstrument.bytesPerSample = sizeof(int8_t);
+    song.noInstrument.channels = 1;
+    song.rows = rows;
+    song.endJumpOrder = endJumpOrder;
+    song.defaultSpeed = defaultSpeed;
+    song.defaultBPM = defaultBPM;
+    song.useST300VolumeSlides = useST300VolumeSlides;
+    song.orderPosition = 0;
+    song.patternRow = 0;
+    song.tickPattern = 0;
+    song.tickPatternRow = 0;
+    song.isLooping = false;
+    song.isPlaying = false;
+    song.isPaused = false;
+    song.patternDelay = 0;
+    song.speed = 0;
+    song.BPM = 0;
+    song.tick = 0;
+    song.tempoTimerValue = 0;
+    song.framesPerTick = 0;
+    song.activeChannels = 0;
+    song.useAmigaLPF = false;
+
+    return QB_TRUE;
+}
+
+/// @brief Discards the song
+inline void __MODPlayer_Finalize() {
+    g_MODPlayer.reset();
+}
+
+/// @brief Copies the lookup tables that the effects use. The sine and invert loop speed tables must have at least SINE_TABLE_SIZE and
+/// INVERT_LOOP_TABLE_SIZE entries
+inline void __MODPlayer_SetTables(const uint16_t *periodTable, uint32_t periods, const uint8_t *sineTable, uint32_t sines, const uint8_t *invertLoopSpeedTable,
+                                  uint32_t invertLoopSpeeds) {
+    if (!g_MODPlayer or !periods or sines < MODPlayer::SINE_TABLE_SIZE or invertLoopSpeeds < MODPlayer::INVERT_LOOP_TABLE_SIZE) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    g_MODPlayer->periodTable.assign(periodTable, periodTable + periods);
+    g_MODPlayer->sineTable.assign(sineTable, sineTable + sines);
+    g_MODPlayer->invertLoopSpeedTable.assign(invertLoopSpeedTable, invertLoopSpeedTable + invertLoopSpeeds);
+}
+
+/// @brief Copies the order list
+/// @param orders The order list. This must have as many entries as the song has orders
+inline void __MODPlayer_SetOrders(const uint16_t *orders) {
+    if (!g_MODPlayer) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    std::copy_n(orders, g_MODPlayer->orders.size(), g_MODPlayer->orders.begin());
+}
+
+inline void __MODPlayer_SetInstrument(uint32_t instrument, uint32_t length, uint16_t c2Spd, uint8_t volume, uint32_t loopStart, uint32_t loopEnd, int32_t playMode,
+                                      uint8_t bytesPerSample, uint8_t channels) {
+    if (!g_MODPlayer or instrument >= g_MODPlayer->instruments.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    // FM instruments have no sample format
+    g_MODPlayer->instruments[instrument] = {length,   c2Spd,   volume, loopStart, loopEnd, playMode, std::max<uint8_t>(bytesPerSample, sizeof(int8_t)),
+                                            std::max<uint8_t>(channels, 1)};
+}
+
+inline void __MODPlayer_SetNote(uint16_t pattern, uint8_t row, uint8_t channel, uint8_t note, uint8_t instrument, uint8_t volume, uint8_t effect, uint8_t operand) {
+    if (!g_MODPlayer or row >= g_MODPlayer->rows or channel >= g_MODPlayer->channels.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    auto index = (size_t(pattern) * g_MODPlayer->rows + row) * g_MODPlayer->channels.size() + channel;
+    if (index >= g_MODPlayer->patterns.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    g_MODPlayer->patterns[index] = {note, instrument, volume, effect, operand};
+}
+
+/// @brief This gives us the frequency in hz based on the period
+static inline constexpr uint32_t MODPlayer_GetFrequencyFromPeriod(int32_t period) {
+    return period > 0 ? MODPlayer::AMIGA_PAULA_CLOCK / uint32_t(period) : 0;
+}
+
+/// @brief Sets the voice frequency from a period. A period that slid to zero or below has no frequency, so the voice keeps its current one
+static inline void MODPlayer_SetVoicePeriod(uint8_t chan, int32_t period) {
+    if (period > 0)
+        SoftSynth_SetVoiceFrequency(chan, MODPlayer_GetFrequencyFromPeriod(period));
+}
+
+/// @brief Return C2 speed for a finetune
+static inline constexpr uint16_t MODPlayer_GetC2Spd(uint8_t finetune) {
+    constexpr uint16_t c2Spds[] = {8363, 8413, 8463, 8529, 8581, 8651, 8723, 8757, 7895, 7941, 7985, 8046, 8107, 8169, 8232, 8280};
+
+    return finetune < _countof(c2Spds) ? c2Spds[finetune] : MODPlayer::C2SPD_DEFAULT;
+}
+
+/// @brief We always set the global BPM using this and never directly
+static inline void MODPlayer_SetBPM(MODPlayer &song, uint8_t bpm) {
+    song.BPM = bpm;
+
+    // Calculate the number of samples we have to mix per tick
+    song.framesPerTick = song.tempoTimerValue / bpm;
+}
+
+/// @brief Returns an entry from the period table. Notes past the end of the table have no period
+static inline int32_t MODPlayer_GetPeriod(const MODPlayer &song, uint32_t note) {
+    return note < song.periodTable.size() ? song.periodTable[note] : 0;
+}
+
+/// @brief Binary search the period table to find the closest value
+static inline int32_t MODPlayer_GetClosestPeriod(const MODPlayer &song, int32_t target) {
+    if (target > 27392 or target < 14) {
+        return target;
+    }
+
+    // The table is sorted in descending order
+    int32_t startPos = 0, endPos = int32_t(song.periodTable.size()) - 1;
+    while (startPos + 1 < endPos) {
+        auto midPos = startPos + (endPos - startPos) / 2;
+        if (song.periodTable[midPos] <= target)
+            endPos = midPos;
+        else
+            startPos = midPos;
+    }
+
+    auto rightVal = std::abs(song.periodTable[startPos] - target);
+    auto leftVal = std::abs(song.periodTable[endPos] - target);
+
+    return leftVal <= rightVal ? song.periodTable[endPos] : song.periodTable[startPos];
+}
+
+/// @brief Starts the channel instrument on the channel voice
+static inline void MODPlayer_PlayVoice(MODPlayer &song, uint8_t chan) {
+    auto &channel = song.channels[chan];
+    auto &instrument = song.GetInstrument(channel.instrument);
+
+    SoftSynth_PlayVoice(chan, channel.instrument, SoftSynth_BytesToFrames(channel.startPosition, instrument.bytesPerSample, instrument.channels), instrument.playMode,
+                        SoftSynth_BytesToFrames(instrument.loopStart, instrument.bytesPerSample, instrument.channels),
+                        SoftSynth_BytesToFrames(instrument.loopEnd, instrument.bytesPerSample, instrument.channels));
+}
+
+static inline void MODPlayer_SetVoiceVolume(uint8_t chan, int32_t volume) {
+    SoftSynth_SetVoiceVolume(chan, float(volume) / MODPlayer::INSTRUMENT_VOLUME_MAX);
+}
+
+/// @brief Carry out a tone portamento to a certain note
+static inline void MODPlayer_DoPortamento(MODPlayer &song, uint8_t chan) {
+    auto &channel = song.channels[chan];
+
+    // Slide up/down and clamp to destination
+    if (channel.period < channel.portamentoTo) {
+        channel.period = std::min(channel.period + (channel.portamentoSpeed << 2), channel.portamentoTo);
+    } else if (channel.period > channel.portamentoTo) {
+        channel.period = std::max(channel.period - (channel.portamentoSpeed << 2), channel.portamentoTo);
+    }
+
+    MODPlayer_SetVoicePeriod(chan, channel.useGlissando ? MODPlayer_GetClosestPeriod(song, channel.period) : channel.period);
+}
+
+/// @brief Carry out a [fine] volume slide
+/// Uses +x -y in non-fine mode, else D0x = slide down, Dx0 = slide up, DFx = fine slide down, DxF = fine slide up
+static inline void MODPlayer_DoVolumeSlide(MODPlayer &song, uint8_t chan, uint8_t x, uint8_t y, bool isNotFine) {
+    auto &channel = song.channels[chan];
+
+    if (isNotFine) {
+        channel.volume = channel.volume + x - y;
+    } else {
+        if (!y)
+            channel.volume += x;
+        if (!x)
+            channel.volume -= y;
+    }
+
+    channel.volume = std::clamp<int16_t>(channel.volume, 0, MODPlayer::INSTRUMENT_VOLUME_MAX);
+
+    MODPlayer_SetVoiceVolume(chan, channel.volume);
+}
+
+/// @brief Carry out an S3M tremor command
+static inline void MODPlayer_DoS3MTremor(MODPlayer &song, uint8_t chan) {
+    auto &channel = song.channels[chan];
+    auto onTicks = channel.tremorParameters >> 4;
+    auto ticks = onTicks + (channel.tremorParameters & 0xF);
+
+    if (ticks)
+        channel.tremorPosition %= ticks;
+
+    MODPlayer_SetVoiceVolume(chan, channel.tremorPosition < onTicks ? channel.volume : 0);
+
+    channel.tremorPosition++;
+}
+
+/// @brief Returns the vibrato or tremolo waveform value at a position
+static inline uint32_t MODPlayer_GetWaveform(const MODPlayer &song, int8_t position, uint8_t waveform) {
+    uint8_t temp = position & 31;
+
+    switch (waveform & 3) {
+    case 0: // Sine
+        return song.sineTable[temp];
+
+    case 1: // Saw down
+        temp <<= 3;
+        if (position < 0)
+            temp = 255 - temp;
+        return temp;
+
+    case 2: // Square
+        return 255;
+
+    default: // Random
+        return Math_GetRandomBetween(0, 255);
+    }
+}
+
+/// @brief Carry out a [fine] vibrato at a certain depth and speed
+static inline void MODPlayer_DoVibrato(MODPlayer &song, uint8_t chan, bool isNotFine) {
+    auto &channel = song.channels[chan];
+
+    uint16_t delta = (MODPlayer_GetWaveform(song, channel.vibratoPosition, channel.waveControl) * channel.vibratoDepth) >> 7;
+    if (isNotFine)
+        delta <<= 2; // make vibrato 4 times bigger
+
+    MODPlayer_SetVoicePeriod(chan, channel.vibratoPosition >= 0 ? channel.period + delta : channel.period - delta);
+
+    channel.vibratoPosition += channel.vibratoSpeed;
+    if (channel.vibratoPosition > 31)
+        channel.vibratoPosition -= 64;
+}
+
+/// @brief Carry out a tremolo at a certain depth and speed
+static inline void MODPlayer_DoTremolo(MODPlayer &song, uint8_t chan) {
+    auto &channel = song.channels[chan];
+
+    int32_t delta = (MODPlayer_GetWaveform(song, channel.tremoloPosition, channel.waveControl >> 4) * channel.tremoloDepth) >> 6;
+
+    if (channel.tremoloPosition >= 0) {
+        if (channel.volume + delta > MODPlayer::INSTRUMENT_VOLUME_MAX)
+            delta = MODPlayer::INSTRUMENT_VOLUME_MAX - channel.volume;
+        MODPlayer_SetVoiceVolume(chan, channel.volume + delta);
+    } else {
+        if (channel.volume - delta < 0)
+            delta = channel.volume;
+        MODPlayer_SetVoiceVolume(chan, channel.volume - delta);
+    }
+
+    channel.tremoloPosition += channel.tremoloSpeed;
+    if (channel.tremoloPosition > 31)
+        channel.tremoloPosition -= 64;
+}
+
+/// @brief Carry out an invert loop (EFx) effect
+/// This will trash the sample managed by the SoftSynth. The pokes are queued when the SoftSynth command queue is enabled, so this also works
+/// while the render thread is running
+static inline void MODPlayer_DoInvertLoop(MODPlayer &song, uint8_t chan) {
+    auto &channel = song.channels[chan];
+
+    channel.invertLoopDelay += song.invertLoopSpeedTable[channel.invertLoopSpeed & (MODPlayer::INVERT_LOOP_TABLE_SIZE - 1)];
+
+    auto &instrument = song.GetInstrument(channel.instrument);
+
+    if (channel.invertLoopDelay >= 128 and SoftSynth::Voice::PlayMode::FORWARD_LOOP == instrument.playMode) {
+        channel.invertLoopDelay = 0; // reset delay
+        if (channel.invertLoopPosition < instrument.loopStart)
+            channel.invertLoopPosition = instrument.loopStart;
+        channel.invertLoopPosition++; // increment position by 1
+        if (channel.invertLoopPosition >= instrument.loopEnd)
+            channel.invertLoopPosition = instrument.loopStart;
+
+        auto position = SoftSynth_BytesToFrames(channel.invertLoopPosition, instrument.bytesPerSample, instrument.channels);
+        SoftSynth_PokeSoundFrameByte(channel.instrument, position, int8_t(~SoftSynth_PeekSoundFrameByte(channel.instrument, position)));
+    }
+}
+
+/// @brief Updates a row of notes and play them out on tick 0
+static inline void MODPlayer_UpdateRow(MODPlayer &song) {
+    // The effect flags below are set to true when a pattern jump effect and pattern break effect are triggered
+    auto jumpEffectFlag = false, breakEffectFlag = false;
+
+    // Set the active channel count to zero
+    song.activeChannels = 0;
+
+    // Process all channels
+    for (uint32_t chan = 0; chan < song.channels.size(); chan++) {
+        auto &channel = song.channels[chan];
+        auto note = song.GetNote(song.tickPattern, song.tickPatternRow, chan);
+        uint8_t opX = note.operand >> 4;
+        uint8_t opY = note.operand & 0xF;
+        auto noFrequency = false;
+
+        // Set volume. We never play if sample number is zero. Our sample array is 1 based
+        // ONLY RESET VOLUME IF THERE IS A SAMPLE NUMBER
+        if (note.instrument) {
+            channel.instrument = note.instrument - 1;
+            channel.startPosition = 0; // reset sample offset if sample changes
+
+            // Don't get the volume if delay note, set it when the delay note actually happens
+            if (note.effect != MODPlayer::EXTENDED or opX != MODPlayer::EXTENDED_NOTE_DELAY)
+                channel.volume = song.GetInstrument(channel.instrument).volume;
+        }
+
+        if (note.note < MODPlayer::NOTE_NONE) {
+            channel.lastPeriod = (int64_t(MODPlayer::C2SPD_DEFAULT) * MODPlayer_GetPeriod(song, note.note)) /
+                                 std::max<uint16_t>(song.GetInstrument(channel.instrument).c2Spd, 1);
+            channel.note = note.note;
+            channel.restart = true;
+            song.activeChannels = chan;
+
+            // Retrigger the tremolo waveform. The vibrato position is carried over to the new note
+            if ((channel.waveControl >> 4) < 4)
+                channel.tremoloPosition = 0;
+
+            // ONLY RESET FREQUENCY IF THERE IS A NOTE VALUE AND PORTA NOT SET
+            if (note.effect != MODPlayer::PORTAMENTO and note.effect != MODPlayer::PORTAMENTO_VOLUME_SLIDE and
+                note.effect != MODPlayer::PORTAMENTO_VOLUME_FINE_SLIDE)
+                channel.period = channel.lastPeriod;
+        } else {
+            channel.restart = false;
+        }
+
+        if (note.volume <= MODPlayer::INSTRUMENT_VOLUME_MAX)
+            channel.volume = note.volume;
+        if (note.note == MODPlayer::NOTE_KEY_OFF)
+            channel.volume = 0;
+
+        // Process tick 0 effects
+        switch (note.effect) {
+        case MODPlayer::PORTAMENTO:
+            if (note.operand)
+                channel.portamentoSpeed = note.operand;
+            channel.portamentoTo = channel.lastPeriod;
+            channel.restart = false;
+            break;
+
+        case MODPlayer::PORTAMENTO_VOLUME_SLIDE:
+            channel.portamentoTo = channel.lastPeriod;
+            channel.restart = false;
+            break;
+
+        case MODPlayer::VIBRATO:
+        case MODPlayer::VIBRATO_FINE:
+            if (opX)
+                channel.vibratoSpeed = opX;
+            if (opY)
+                channel.vibratoDepth = opY;
+            break;
+
+        case MODPlayer::TREMOLO:
+            if (opX)
+                channel.tremoloSpeed = opX;
+            if (opY)
+                channel.tremoloDepth = opY;
+            break;
+
+        case MODPlayer::PANNING_8:
+            // Don't care about DMP panning BS. We are doing this Fasttracker style
+            SoftSynth_SetVoiceBalance(chan, (note.operand / 255.0f) * 2.0f - 1.0f); // pan = ((x / 255) * 2) - 1
+            break;
+
+        case MODPlayer::SAMPLE_OFFSET:
+            channel.startPosition = std::min<uint32_t>(note.operand << 8, song.GetInstrument(channel.instrument).length);
+            break;
+
+        case MODPlayer::POSITION_JUMP:
+            song.orderPosition = note.operand;
+            if (song.orderPosition >= int32_t(song.orders.size()))
+                song.orderPosition = song.endJumpOrder;
+            song.patternRow = -1; // This will increment right after & we will start at 0
+            jumpEffectFlag = true;
+            break;
+
+        case MODPlayer::VOLUME:
+            channel.volume = std::min<int16_t>(note.operand, MODPlayer::INSTRUMENT_VOLUME_MAX);
+            break;
+
+        case MODPlayer::PATTERN_BREAK:
+            song.patternRow = (opX * 10) + opY - 1;
+            if (song.patternRow >= song.rows)
+                song.patternRow = -1;
+            if (!breakEffectFlag and !jumpEffectFlag) {
+                song.orderPosition++;
+                if (song.orderPosition >= int32_t(song.orders.size()))
+                    song.orderPosition = song.endJumpOrder;
+            }
+            breakEffectFlag = true;
+            break;
+
+        case MODPlayer::EXTENDED:
+            switch (opX) {
+            case MODPlayer::EXTENDED_FILTER:
+                song.useAmigaLPF = opY != 0;
+                break;
+
+            case MODPlayer::EXTENDED_PORTAMENTO_FINE_UP:
+                channel.period -= opY << 2;
+                break;
+
+            case MODPlayer::EXTENDED_PORTAMENTO_FINE_DOWN:
+                channel.period += opY << 2;
+                break;
+
+            case MODPlayer::EXTENDED_GLISSANDO_CONTROL:
+                channel.useGlissando = opY != 0;
+                break;
+
+            case MODPlayer::EXTENDED_VIBRATO_WAVEFORM:
+                channel.waveControl = (channel.waveControl & 0xF0) | opY;
+                break;
+
+            case MODPlayer::EXTENDED_FINETUNE:
+                if (channel.instrument < song.instruments.size())
+                    song.instruments[channel.instrument].c2Spd = MODPlayer_GetC2Spd(opY);
+                break;
+
+            case MODPlayer::EXTENDED_PATTERN_LOOP:
+                if (!opY) {
+                    channel.patternLoopRow = song.tickPatternRow;
+                } else {
+                    if (!channel.patternLoopRowCounter)
+                        channel.patternLoopRowCounter = opY;
+                    else
+                        channel.patternLoopRowCounter--;
+                    if (channel.patternLoopRowCounter)
+                        song.patternRow = channel.patternLoopRow - 1;
+                }
+                break;
+
+            case MODPlayer::EXTENDED_TREMOLO_WAVEFORM:
+                channel.waveControl = (channel.waveControl & 0xF) | (opY << 4);
+                break;
+
+            case MODPlayer::EXTENDED_PANNING_4:
+                SoftSynth_SetVoiceBalance(chan, (opY / 15.0f) * 2.0f - 1.0f); // pan = (x / 15) * 2 - 1
+                break;
+
+            case MODPlayer::EXTENDED_VOLUME_FINE_SLIDE_UP:
+                channel.volume = std::min<int16_t>(channel.volume + opY, MODPlayer::INSTRUMENT_VOLUME_MAX);
+                break;
+
+            case MODPlayer::EXTENDED_VOLUME_FINE_SLIDE_DOWN:
+                channel.volume = std::max<int16_t>(channel.volume - opY, 0);
+                break;
+
+            case MODPlayer::EXTENDED_NOTE_DELAY:
+                channel.restart = false;
+                noFrequency = true;
+                break;
+
+            case MODPlayer::EXTENDED_PATTERN_DELAY:
+                song.patternDelay = opY;
+                break;
+
+            case MODPlayer::EXTENDED_INVERT_LOOP:
+                channel.invertLoopSpeed = opY;
+                break;
+            }
+            break;
+
+        case MODPlayer::SPEED_TEMPO:
+            if (note.operand < 32)
+                song.speed = note.operand;
+            else
+                MODPlayer_SetBPM(song, note.operand);
+            break;
+
+        case MODPlayer::SPEED:
+            if (note.operand)
+                song.speed = note.operand;
+            break;
+
+        case MODPlayer::VOLUME_FINE_SLIDE:
+            if (note.operand)
+                channel.lastVolumeSlide = note.operand;
+            // DFF is classed as a slide up so it gets priority
+            if (opY == 0xF)
+                channel.volume += opX;
+            else if (opX == 0xF)
+                channel.volume -= opY;
+            // Perform an extra slide if using old fast vol slides!
+            if (song.useST300VolumeSlides) {
+                if (!opY)
+                    channel.volume += opX;
+                if (!opX)
+                    channel.volume -= opY;
+            }
+            channel.volume = std::clamp<int16_t>(channel.volume, 0, MODPlayer::INSTRUMENT_VOLUME_MAX);
+            break;
+
+        case MODPlayer::PORTAMENTO_EXTRA_FINE_DOWN:
+            if (note.operand)
+                channel.lastPortamento = note.operand;
+            if (opX == 0xF)
+                channel.period += opY << 2;
+            else if (opX == 0xE)
+                channel.period += opY;
+            break;
+
+        case MODPlayer::PORTAMENTO_EXTRA_FINE_UP:
+            if (note.operand)
+                channel.lastPortamento = note.operand;
+            if (opX == 0xF)
+                channel.period -= opY << 2;
+            else if (opX == 0xE)
+                channel.period -= opY;
+            break;
+
+        case MODPlayer::TREMOR:
+            if (note.operand)
+                channel.tremorParameters = ((opX << 4) + 1) + (opY + 1);
+            MODPlayer_DoS3MTremor(song, chan);
+            break;
+
+        case MODPlayer::VIBRATO_VOLUME_FINE_SLIDE:
+            if (note.operand)
+                channel.lastVolumeSlide = note.operand;
+            noFrequency = true;
+            break;
+
+        case MODPlayer::CHANNEL_VOLUME:
+            if (note.operand <= MODPlayer::S3M_GLOBAL_VOLUME_MAX)
+                channel.volume = note.operand;
+            break;
+
+        case MODPlayer::NOTE_RETRIGGER_VOLUME_SLIDE:
+            if (note.operand) {
+                channel.retriggerVolumeSlide = opX;
+                channel.retriggerTickCount = opY;
+            }
+            break;
+
+        case MODPlayer::TEMPO:
+            if (note.operand)
+                MODPlayer_SetBPM(song, note.operand);
+            break;
+
+        case MODPlayer::GLOBAL_VOLUME:
+            // ST3 ignores out-of-range values
+            if (note.operand <= MODPlayer::S3M_GLOBAL_VOLUME_MAX)
+                SoftSynth_SetGlobalVolume(float(note.operand) / MODPlayer::S3M_GLOBAL_VOLUME_MAX);
+            break;
+
+        case MODPlayer::PORTAMENTO_VOLUME_FINE_SLIDE:
+        case MODPlayer::CHANNEL_VOLUME_SLIDE:
+        case MODPlayer::PANNING_FINE_SLIDE:
+        case MODPlayer::PANBRELLO_WAVEFORM:
+        case MODPlayer::PATTERN_FINE_DELAY:
+        case MODPlayer::SOUND_CONTROL:
+        case MODPlayer::HIGH_OFFSET:
+        case MODPlayer::GLOBAL_VOLUME_SLIDE:
+        case MODPlayer::PANBRELLO:
+        case MODPlayer::MIDI_MACRO:
+            error(QB_ERROR_FEATURE_UNAVAILABLE);
+            break;
+        }
+
+        MODPlayer_DoInvertLoop(song, chan); // called every row
+
+        if (!noFrequency) {
+            if (note.effect != MODPlayer::TREMOLO)
+                MODPlayer_SetVoiceVolume(chan, channel.volume);
+            if (channel.period > 0)
+                MODPlayer_SetVoicePeriod(chan, channel.period);
+        }
+    }
+
+    // Now play all samples that needs to be played
+    for (uint32_t chan = 0; chan <= song.activeChannels; chan++) {
+        if (song.channels[chan].restart)
+            MODPlayer_PlayVoice(song, chan);
+    }
+}
+
+/// @brief Updates any tick based effects after tick 0
+static inline void MODPlayer_UpdateTick(MODPlayer &song) {
+    // Process all channels
+    for (uint32_t chan = 0; chan < song.channels.size(); chan++) {
+        auto &channel = song.channels[chan];
+
+        // Only process if we have a period set
+        if (channel.period <= 0)
+            continue;
+
+        // We are not processing a new row but tick 1+ effects
+        // So we pick these using tickPattern and tickPatternRow
+        auto note = song.GetNote(song.tickPattern, song.tickPatternRow, chan);
+        uint8_t opX = note.operand >> 4;
+        uint8_t opY = note.operand & 0xF;
+
+        MODPlayer_DoInvertLoop(song, chan); // called every tick
+
+        switch (note.effect) {
+        case MODPlayer::ARPEGGIO:
+            if (note.operand) {
+                auto period = channel.period;
+
+                switch (song.tick % 3) {
+                case 1:
+                    period = MODPlayer_GetPeriod(song, channel.note + opX);
+                    break;
+
+                case 2:
+                    period = MODPlayer_GetPeriod(song, channel.note + opY);
+                    break;
+                }
+
+                // Notes past the end of the period table are skipped
+                if (period > 0)
+                    MODPlayer_SetVoicePeriod(chan, period);
+            }
+            break;
+
+        case MODPlayer::PORTAMENTO_UP:
+            channel.period = std::max(channel.period - (note.operand << 2), 1); // clamp to avoid division by zero
+            MODPlayer_SetVoicePeriod(chan, channel.period);
+            break;
+
+        case MODPlayer::PORTAMENTO_DOWN:
+            channel.period += note.operand << 2;
+            MODPlayer_SetVoicePeriod(chan, channel.period);
+            break;
+
+        case MODPlayer::PORTAMENTO:
+            MODPlayer_DoPortamento(song, chan);
+            break;
+
+        case MODPlayer::VIBRATO:
+            MODPlayer_DoVibrato(song, chan, true);
+            break;
+
+        case MODPlayer::PORTAMENTO_VOLUME_SLIDE:
+            MODPlayer_DoPortamento(song, chan);
+            MODPlayer_DoVolumeSlide(song, chan, opX, opY, true);
+            break;
+
+        case MODPlayer::VIBRATO_VOLUME_SLIDE:
+            MODPlayer_DoVibrato(song, chan, true);
+            MODPlayer_DoVolumeSlide(song, chan, opX, opY, true);
+            break;
+
+        case MODPlayer::TREMOLO:
+            MODPlayer_DoTremolo(song, chan);
+            break;
+
+        case MODPlayer::VOLUME_SLIDE:
+            MODPlayer_DoVolumeSlide(song, chan, opX, opY, true);
+            break;
+
+        case MODPlayer::EXTENDED:
+            switch (opX) {
+            case MODPlayer::EXTENDED_NOTE_RETRIGGER:
+                if (opY and !(song.tick % opY))
+                    MODPlayer_PlayVoice(song, chan);
+                break;
+
+            case MODPlayer::EXTENDED_NOTE_CUT:
+                if (song.tick == opY) {
+                    channel.volume = 0;
+                    MODPlayer_SetVoiceVolume(chan, channel.volume);
+                }
+                break;
+
+            case MODPlayer::EXTENDED_NOTE_DELAY:
+                if (song.tick == opY) {
+                    channel.volume = song.GetInstrument(channel.instrument).volume;
+                    if (note.volume <= MODPlayer::INSTRUMENT_VOLUME_MAX)
+                        channel.volume = note.volume;
+                    MODPlayer_SetVoicePeriod(chan, channel.period);
+                    MODPlayer_SetVoiceVolume(chan, channel.volume);
+                    MODPlayer_PlayVoice(song, chan);
+                }
+                break;
+            }
+            break;
+
+        case MODPlayer::VOLUME_FINE_SLIDE:
+            MODPlayer_DoVolumeSlide(song, chan, channel.lastVolumeSlide >> 4, channel.lastVolumeSlide & 0xF, false);
+            break;
+
+        case MODPlayer::PORTAMENTO_EXTRA_FINE_DOWN:
+            if (channel.lastPortamento < 0xE0)
+                channel.period += channel.lastPortamento << 2;
+            MODPlayer_SetVoicePeriod(chan, channel.period);
+            break;
+
+        case MODPlayer::PORTAMENTO_EXTRA_FINE_UP:
+            if (channel.lastPortamento < 0xE0)
+                channel.period -= channel.lastPortamento << 2;
+            MODPlayer_SetVoicePeriod(chan, channel.period);
+            break;
+
+        case MODPlayer::TREMOR:
+            MODPlayer_DoS3MTremor(song, chan);
+            break;
+
+        case MODPlayer::VIBRATO_VOLUME_FINE_SLIDE:
+            MODPlayer_DoVibrato(song, chan, true);
+            MODPlayer_DoVolumeSlide(song, chan, channel.lastVolumeSlide >> 4, channel.lastVolumeSlide & 0xF, false);
+            break;
+
+        case MODPlayer::PORTAMENTO_VOLUME_FINE_SLIDE:
+            error(QB_ERROR_FEATURE_UNAVAILABLE);
+            break;
+
+        case MODPlayer::NOTE_RETRIGGER_VOLUME_SLIDE:
+            if (channel.retriggerTickCount and !(song.tick % channel.retriggerTickCount)) {
+                if (channel.retriggerVolumeSlide) {
+                    // Parameter  Effect              Parameter   Effect
+                    // 0          No volume change    8           No volume change
+                    // 1          Volume - 1          9           Volume + 1
+                    // 2          Volume - 2          A           Volume + 2
+                    // 3          Volume - 4          B           Volume + 4
+                    // 4          Volume - 8          C           Volume + 8
+                    // 5          Volume - 16         D           Volume + 16
+                    // 6          Volume x 2/3        E           Volume x 1.5
+                    // 7          Volume x 1/2        F           Volume x 2
+                    switch (channel.retriggerVolumeSlide) {
+                    case 0x1:
+                    case 0x2:
+                    case 0x3:
+                    case 0x4:
+                    case 0x5:
+                        channel.volume -= 1 << (channel.retriggerVolumeSlide - 1);
+                        break;
+
+                    case 0x6:
+                        channel.volume = int16_t(std::lrint(channel.volume * (2.0f / 3.0f)));
+                        break;
+
+                    case 0x7:
+                        channel.volume >>= 1;
+                        break;
+
+                    case 0x9:
+                    case 0xA:
+                    case 0xB:
+                    case 0xC:
+                    case 0xD:
+                        channel.volume += 1 << (channel.retriggerVolumeSlide - 9);
+                        break;
+
+                    case 0xE:
+                        channel.volume = int16_t(std::lrint(channel.volume * (3.0f / 2.0f)));
+                        break;
+
+                    case 0xF:
+                        channel.volume <<= 1;
+                        break;
+                    }
+
+                    channel.volume = std::clamp<int16_t>(channel.volume, 0, MODPlayer::INSTRUMENT_VOLUME_MAX);
+
+                    MODPlayer_SetVoiceVolume(chan, channel.volume);
+                }
+
+                MODPlayer_PlayVoice(song, chan);
+            }
+            break;
+
+        case MODPlayer::VIBRATO_FINE:
+            MODPlayer_DoVibrato(song, chan, false);
+            break;
+        }
+    }
+}
+
+/// @brief Starts playback from the beginning of the song
+inline void __MODPlayer_Play() {
+    if (!g_MODPlayer or !g_MODPlayer->HasTables()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    auto &song = *g_MODPlayer;
+
+    // Initialize some important stuff
+    song.tempoTimerValue = (SoftSynth_GetSampleRate() * MODPlayer::SONG_BPM_DEFAULT) / 50;
+    song.orderPosition = 0;
+    song.patternRow = 0;
+    song.speed = song.defaultSpeed;
+    song.tick = song.speed;
+    song.isPaused = false;
+
+    // Set default BPM
+    MODPlayer_SetBPM(song, song.defaultBPM);
+
+    song.isPlaying = true;
+}
+
+/// @brief Stops playback
+inline void __MODPlayer_Stop() {
+    if (g_MODPlayer)
+        g_MODPlayer->isPlaying = false;
+}
+
+/// @brief Moves the song to the order that looping goes back to or stops playback if the song is not looping
+/// @return False if playback stopped
+static inline bool MODPlayer_EndSong(MODPlayer &song) {
+    if (song.isLooping) {
+        song.orderPosition = song.endJumpOrder;
+        song.speed = song.defaultSpeed;
+        song.tick = song.speed;
+
+        return true;
+    }
+
+    song.isPlaying = false;
+
+    return false;
+}
+
+/// @brief Plays one tick of the song. The caller should then mix the returned number of frames
+/// @return The number of frames to mix or zero if the song is not playing (or is paused)
+inline uint32_t __MODPlayer_Update() {
+    // Check conditions for which we should just exit and not process anything
+    // 1. Song is done and we are not looping
+    // 2. Playback was not requested
+    // 3. Playback is paused
+    if (!g_MODPlayer or !g_MODPlayer->isPlaying or g_MODPlayer->orderPosition >= int32_t(g_MODPlayer->orders.size()) or g_MODPlayer->isPaused)
+        return 0;
+
+    auto &song = *g_MODPlayer;
+
+    // The effects index the lookup tables directly
+    if (!song.HasTables()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    auto orders = int32_t(song.orders.size());
+
+    if (song.tick >= song.speed) {
+        // Reset song tick
+        song.tick = 0;
+
+        // Process pattern row if pattern delay is over
+        if (!song.patternDelay) {
+            // Skip marker pattern
+            while (MODPlayer::PATTERN_MARKER == song.orders[song.orderPosition]) {
+                song.orderPosition++;
+                song.patternRow = 0;
+
+                // Check if we need to loop or stop
+                if (song.orderPosition >= orders and !MODPlayer_EndSong(song))
+                    return 0; // bail
+            }
+
+            // Check for end of song marker
+            if (MODPlayer::PATTERN_END == song.orders[song.orderPosition] and !MODPlayer_EndSong(song))
+                return 0; // bail
+
+            // Save the pattern and row for MODPlayer_UpdateTick()
+            // The pattern that we are playing is always tickPattern
+            song.tickPattern = song.orders[song.orderPosition];
+            song.tickPatternRow = song.patternRow;
+
+            // Process the row
+            MODPlayer_UpdateRow(song);
+
+            // Increment the row counter
+            // Note MODPlayer_UpdateTick() should pickup stuff using tickPattern & tickPatternRow
+            // This is because we are already at a new row not processed by MODPlayer_UpdateRow()
+            song.patternRow++;
+
+            // Check if we have finished the pattern and then move to the next one
+            if (song.patternRow >= song.rows) {
+                song.orderPosition++;
+                song.patternRow = 0;
+
+                // Check if we need to loop or stop. If we stop, the remaining samples of this tick are still mixed
+                if (song.orderPosition >= orders)
+                    MODPlayer_EndSong(song);
+            }
+        } else {
+            song.patternDelay--;
+        }
+    } else {
+        MODPlayer_UpdateTick(song);
+    }
+
+    // Increment song tick on each update
+    song.tick++;
+
+    return song.framesPerTick;
+}
+
+inline qb_bool __MODPlayer_IsPlaying() {
+    return TO_QB_BOOL(g_MODPlayer and g_MODPlayer->isPlaying);
+}
+
+inline qb_bool __MODPlayer_IsPaused() {
+    return TO_QB_BOOL(g_MODPlayer and g_MODPlayer->isPaused);
+}
+
+inline void __MODPlayer_SetPaused(qb_bool state) {
+    if (g_MODPlayer)
+        g_MODPlayer->isPaused = state;
+}
+
+inline qb_bool __MODPlayer_IsLooping() {
+    return TO_QB_BOOL(g_MODPlayer and g_MODPlayer->isLooping);
+}
+
+inline void __MODPlayer_SetLooping(qb_bool state) {
+    if (g_MODPlayer)
+        g_MODPlayer->isLooping = state;
+}
+
+/// @brief Moves to the next order positions and wrap if it reaches the end
+inline void __MODPlayer_GoToNextPosition() {
+    if (!g_MODPlayer)
+        return;
+
+    auto &song = *g_MODPlayer;
+    auto orders = int32_t(song.orders.size());
+
+    if (song.isLooping) {
+        song.orderPosition++; // move to the next order
+        if (song.orderPosition >= orders)
+            song.orderPosition = 0; // wrap to first order if we have reached the end
+        song.patternRow = 0;        // reset row position
+    } else if (song.orderPosition < orders - 1) {
+        song.orderPosition++; // else only if have not reached the last order
+        song.patternRow = 0;
+    }
+}
+
+/// @brief Moves to the previous order position and wraps if it reaches the beginning
+inline void __MODPlayer_GoToPreviousPosition() {
+    if (!g_MODPlayer)
+        return;
+
+    auto &song = *g_MODPlayer;
+
+    if (song.isLooping) {
+        song.orderPosition--; // move to the previous order
+        if (song.orderPosition < 0)
+            song.orderPosition = int32_t(song.orders.size()) - 1; // wrap to the last order if we have crossed the beginning
+        song.patternRow = 0;                                      // reset row position
+    } else if (song.orderPosition > 0) {
+        song.orderPosition--; // else only if have not reached the first order
+        song.patternRow = 0;
+    }
+}
+
+/// @brief Moves to a specific order postion
+inline void __MODPlayer_SetPosition(uint16_t position) {
+    if (g_MODPlayer and position < g_MODPlayer->orders.size()) {
+        g_MODPlayer->orderPosition = position;
+        g_MODPlayer->patternRow = 0;
+    }
+}
+
+inline int32_t __MODPlayer_GetPosition() {
+    return g_MODPlayer ? g_MODPlayer->orderPosition : 0;
+}
+
+/// @brief Returns the pattern row that will be played next
+inline int16_t __MODPlayer_GetRow() {
+    return g_MODPlayer ? g_MODPlayer->patternRow : 0;
+}
+
+inline uint8_t __MODPlayer_GetSpeed() {
+    return g_MODPlayer ? g_MODPlayer->speed : 0;
+}
+
+inline uint8_t __MODPlayer_GetBPM() {
+    return g_MODPlayer ? g_MODPlayer->BPM : 0;
+}
@@ -104,3 +104,8 @@ inline void __OPL3_GenerateSamples(float *buffer, uint32_t frames) {
 
     g_OPL3Chip->GenerateSamples(buffer, frames);
 }
+
+/// @brief Returns __OPL3_GenerateSamples as a sample source for a SoftSynth mix bus (see SoftSynth_SetBusSource)
+inline uintptr_t OPL3_GetSampleSource() {
+    return reinterpret_cast<uintptr_t>(&__OPL3_GenerateSamples);
+}
@@ -10,14 +10,45 @@
 #include "../Core/Types.h"
 #include "../Debug/Debug.h"
 #include "../Math/Math.h"
+// verblib's implementation has external linkage, so it must be compiled into exactly one translation unit. Programs that include this header
+// in more than one translation unit should define SOFTSYNTH_NO_VERBLIB_IMPLEMENTATION in all but one of them
+#if !defined(SOFTSYNTH_NO_VERBLIB_IMPLEMENTATION) && !defined(SOFTSYNTH_VERBLIB_IMPLEMENTED)
+    #define SOFTSYNTH_VERBLIB_IMPLEMENTED
+    #define VERBLIB_IMPLEMENTATION
+#endif
+#include "../external/verblib.h"
+#undef VERBLIB_IMPLEMENTATION
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SOFTSYNTH_USE_SSE2 1
+#endif
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define SOFTSYNTH_USE_AVX 1
+#endif
 
 struct SoftSynth {
-    static constexpr auto VOLUME_MIN = 0.0f; // minimum volume
-    static constexpr auto VOLUME_MAX = 1.0f; // maximum volume
+    static constexpr auto VOLUME_MIN = 0.0f;               // minimum volume
+    static constexpr auto VOLUME_MAX = 1.0f;               // maximum volume
+    static constexpr uint32_t MIX_BLOCK_FRAMES = 256;      // the mixer renders voices in spans of at most this many frames
+    static constexpr uint32_t MIX_VOICES_PER_THREAD = 8;   // fewer voices than this per thread are not worth waking a worker for
+    static constexpr uint32_t MAIN_BUS = 0;                // the bus that is mixed straight into the output buffer
+    static constexpr size_t COMMAND_QUEUE_CAPACITY = 4096; // voice changes that can be queued between two updates
 
     struct Voice {
         static const auto NO_SOUND = -1; // used to unbind a sound from a voice
@@ -31,37 +62,95 @@ struct SoftSynth {
 
         /// @brief Various playing modes
         enum PlayMode {
-            FORWARD = 0,  // single-shot forward playback
-            FORWARD_LOOP, // forward-looping playback
+            FORWARD = 0,   // single-shot forward playback
+            FORWARD_LOOP,  // forward-looping playback
+            PINGPONG_LOOP, // bidirectional looping playback (forward to the loop end, then backward to the loop start and so on)
+            REVERSE,       // single-shot backward playback from the start position down to the start frame
         };
 
-        int32_t sound;                // the Sound to be mixed. This is set to -1 once the mixer is done with the Sound
-        uint32_t frequency;           // the frequency of the sound
-        float pitch;                  // the mixer uses this to step through the sound frames correctly
-        float volume;                 // voice volume (0.0 - 1.0)
-        float panPosition;            // stereo pan setting for (-1.0f - 0.0f - 1.0f)
-        std::pair<float, float> gain; // left and right gain (calculated from panPosition)
-        float position;               // sample frame position in the sound buffer
-        uint32_t iPosition;           // sample frame position without the factional value
-        uint32_t startPosition;       // this can be loop start or just start depending on play mode (in frames!)
-        uint32_t endPosition;         // this can be loop end or just end depending on play mode (in frames!)
-        int32_t mode;                 // how should the sound be played?
-        float frame;                  // current frame
-        float oldFrame;               // the previous frame
+        /// @brief Sample interpolation modes. These trade quality against mixing cost
+        enum Interpolation {
+            NEAREST = 0, // no interpolation (sample and hold)
+            LINEAR,      // linear interpolation between two frames
+            CUBIC,       // 4-point cubic Hermite (Catmull-Rom) interpolation
+            SINC,        // 8-tap windowed sinc interpolation using precomputed polyphase tables
+        };
+
+        int32_t sound;                       // the Sound to be mixed. This is set to -1 once the mixer is done with the Sound
+        uint32_t frequency;                  // the frequency of the sound
+        float pitch;                         // the mixer uses this to step through the sound frames correctly
+        float volume;                        // voice volume (0.0 - 1.0)
+        float panPosition;                   // stereo pan setting for (-1.0f - 0.0f - 1.0f)
+        std::pair<float, float> gain;        // left and right gain (calculated from panPosition)
+        float position;                      // sample frame position in the sound buffer
+        uint32_t iPosition;                  // index of the last fetched sample frame (the integer position, rounded up when reversing)
+        uint32_t startPosition;              // this can be loop start or just start depending on play mode (in frames!)
+        uint32_t endPosition;                // this can be loop end or just end depending on play mode (in frames!)
+        int32_t mode;                        // how should the sound be played?
+        float frame;                         // current frame
+        float oldFrame;                      // the previous frame
+        int32_t interpolation;               // how frames in between sample frames are calculated
+        std::pair<float, float> mixGain;     // left and right gain being applied (volume * gain, except during a ramp)
+        std::pair<float, float> mixGainStep; // per frame change of mixGain during a volume / pan ramp
+        uint32_t mixGainFrames;              // frames left in the volume / pan ramp
+        float targetPitch;                   // the pitch a frequency ramp ends at
+        float pitchStep;                     // per frame change of pitch during a frequency ramp
+        uint32_t pitchFrames;                // frames left in the frequency ramp
+        uint32_t bus;                        // the bus the voice is mixed into
+        float reverbSend;                    // how much of the voice is sent to the reverb (0.0 - 1.0)
+        bool isReversing;                    // the voice is playing backwards (REVERSE or the way back of a PINGPONG_LOOP)
 
         /// @brief Initialized the voice (including pan position)
         Voice() {
+            SetPanPosition(PAN_CENTER);            // center the voice only when creating it the first time
+            interpolation = Interpolation::LINEAR; // like balance, this is a voice setting that survives Reset()
+            bus = MAIN_BUS;                        // and so is the bus
+            reverbSend = VOLUME_MIN;               // and the reverb send level
             Reset();
-            SetPanPosition(PAN_CENTER); // center the voice only when creating it the first time
         }
 
-        /// @brief Resets the voice to defaults. Balance is intentionally left out so that we do not reset pan positions set by the user
+        /// @brief Resets the voice to defaults. Balance, interpolation, bus and reverb send are intentionally left out so that we do not reset settings made by
+        /// the user
         void Reset() {
             sound = NO_SOUND;
             volume = VOLUME_MAX;
             frequency = iPosition = startPosition = endPosition = 0;
             position = pitch = frame = oldFrame = 0.0f;
             mode = PlayMode::FORWARD;
+            isReversing = false;
+            SetPitch(0.0f, 0);
+            SetMixGain(0);
+        }
+
+        /// @brief Moves the applied gain to the volume and pan settings
+        /// @param rampFrames The frames to get there in. If this is zero the new gain is applied at once
+        void SetMixGain(uint32_t rampFrames) {
+            auto left = volume * gain.first, right = volume * gain.second;
+
+            if (rampFrames) {
+                mixGainStep = {(left - mixGain.first) / rampFrames, (right - mixGain.second) / rampFrames};
+                mixGainFrames = rampFrames;
+            } else {
+                mixGain = {left, right};
+                mixGainStep = {0.0f, 0.0f};
+                mixGainFrames = 0;
+            }
+        }
+
+        /// @brief Moves the pitch to a new value
+        /// @param value The new pitch
+        /// @param rampFrames The frames to get there in. If this is zero the new pitch is applied at once
+        void SetPitch(float value, uint32_t rampFrames) {
+            targetPitch = value;
+
+            if (rampFrames) {
+                pitchStep = (value - pitch) / rampFrames;
+                pitchFrames = rampFrames;
+            } else {
+                pitch = value;
+                pitchStep = 0.0f;
+                pitchFrames = 0;
+            }
         }
 
         void SetPanPosition(float value) {
@@ -76,15 +165,378 @@ struct SoftSynth {
         }
     };
 
-    std::vector<std::vector<float>> sounds; // managed sounds
-    std::vector<Voice> voices;              // managed voices
-    uint32_t sampleRate;                    // the mixer sampling rate
-    uint32_t activeVoices;                  // active voices
-    float volume;                           // global volume (0.0 - 1.0)
+    /// @brief A mono sound. Samples are 32-bit floating point, or with native storage, the signed 8-bit or 16-bit samples as they were loaded
+    struct Sound {
+        std::vector<uint8_t> data; // the sample frames in the storage format
+        uint8_t bytesPerSample;    // sizeof(int8_t), sizeof(int16_t) or sizeof(float)
+        uint32_t frames;           // the number of sample frames
+
+        Sound() : bytesPerSample(sizeof(float)), frames(0) {}
+
+        static float ToFloat(int8_t sample) {
+            return float(sample) * Voice::MULTIPLIER_8_TO_32;
+        }
+
+        static float ToFloat(int16_t sample) {
+            return float(sample) * Voice::MULTIPLIER_16_TO_32;
+        }
+
+        static float ToFloat(float sample) {
+            return sample;
+        }
+
+        size_t size() const {
+            return frames;
+        }
+
+        bool empty() const {
+            return !frames;
+        }
+
+        template <typename T> const T *GetData() const {
+            return reinterpret_cast<const T *>(data.data());
+        }
+
+        template <typename T> T *GetData() {
+            return reinterpret_cast<T *>(data.data());
+        }
+
+        float GetFrame(size_t position) const {
+            switch (bytesPerSample) {
+            case sizeof(int8_t):
+                return ToFloat(GetData<int8_t>()[position]);
+
+            case sizeof(int16_t):
+                return ToFloat(GetData<int16_t>()[position]);
+
+            default:
+                return GetData<float>()[position];
+            }
+        }
+
+        /// @brief Returns a frame the way GetFrame() reads it back after SetFrame()
+        float RoundTrip(float frame) const {
+            switch (bytesPerSample) {
+            case sizeof(int8_t):
+                return ToFloat(int8_t(std::clamp(frame * Voice::MULTIPLIER_32_TO_8, float(INT8_MIN), float(INT8_MAX))));
+
+            case sizeof(int16_t):
+                return ToFloat(int16_t(std::clamp(frame * Voice::MULTIPLIER_32_TO_16, float(INT16_MIN), float(INT16_MAX))));
+
+            default:
+                return frame;
+            }
+        }
+
+        void SetFrame(size_t position, float frame) {
+            switch (bytesPerSample) {
+            case sizeof(int8_t):
+                GetData<int8_t>()[position] = int8_t(std::clamp(frame * Voice::MULTIPLIER_32_TO_8, float(INT8_MIN), float(INT8_MAX)));
+                break;
+
+            case sizeof(int16_t):
+                GetData<int16_t>()[position] = int16_t(std::clamp(frame * Voice::MULTIPLIER_32_TO_16, float(INT16_MIN), float(INT16_MAX)));
+                break;
+
+            default:
+                GetData<float>()[position] = frame;
+            }
+        }
+    };
+
+    /// @brief Polyphase windowed sinc filter for Interpolation::SINC. Each phase holds the taps for one fractional position
+    struct SincTable {
+        static constexpr uint32_t TAPS = 8;                   // filter length in frames
+        static constexpr uint32_t TAPS_BEFORE = TAPS / 2 - 1; // taps before the current frame
+        static constexpr uint32_t PHASES = 256;               // fractional positions between two frames
+
+        float taps[PHASES][TAPS];
+
+        /// @brief Builds the table using a Blackman windowed sinc. Every phase is normalized to unity gain
+        SincTable() {
+            for (uint32_t phase = 0; phase < PHASES; phase++) {
+                auto fraction = double(phase) / PHASES;
+                auto sum = 0.0;
+                double coefficients[TAPS];
+
+                for (uint32_t tap = 0; tap < TAPS; tap++) {
+                    auto x = double(tap) - TAPS_BEFORE - fraction; // distance from the sampling point
+                    auto sinc = x == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                    auto window = 0.42 + 0.5 * std::cos(M_PI * x / (TAPS / 2)) + 0.08 * std::cos(2.0 * M_PI * x / (TAPS / 2));
+                    coefficients[tap] = sinc * window;
+                    sum += coefficients[tap];
+                }
+
+                for (uint32_t tap = 0; tap < TAPS; tap++)
+                    taps[phase][tap] = float(coefficients[tap] / sum);
+            }
+        }
+
+        /// @brief Returns the shared table. It is built the first time it is needed
+        static const SincTable &Get() {
+            static const SincTable table;
+            return table;
+        }
+    };
+
+    /// @brief A named mix bus. Voices, an optional sample source and external buffers are summed into the bus. The master stage then scales every
+    /// bus by its gain, adds them up and applies the global volume and clipping in a single pass over the output
+    struct Bus {
+        /// @brief Renders stereo interleaved frames into a buffer, overwriting it. __OPL3_GenerateSamples has this signature
+        typedef void (*Source)(float *buffer, uint32_t frames);
+
+        std::string name;          // unique bus name
+        float gain;                // bus gain (0.0 - 1.0)
+        Source source;             // rendered into the bus on every update (nullptr = none)
+        std::vector<float> buffer; // stereo accumulation buffer. This is all zeros between updates unless something is pending
+        bool isPending;            // external buffers were mixed into the bus since the last update
+
+        explicit Bus(const char *name) : name(name), gain(VOLUME_MAX), source(nullptr), isPending(false) {}
+    };
+
+    /// @brief A lock-free single producer / single consumer ring. One thread pushes while another thread pops without any locking
+    template <typename T>
+    class Ring {
+      public:
+        /// @param capacity The number of items the ring can hold. This is rounded up to a power of 2
+        explicit Ring(size_t capacity) : head(0), tail(0) {
+            size_t size = 1;
+            while (size < capacity)
+                size <<= 1;
+
+            items.resize(size);
+            mask = size - 1;
+        }
+
+        size_t GetCapacity() const {
+            return items.size();
+        }
+
+        /// @brief Returns the number of items in the ring. This can be stale when called from the other thread
+        size_t GetSize() const {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        /// @brief Adds an item. Only the producer thread may call this
+        /// @return False if the ring is full
+        bool Push(const T &item) {
+            auto t = tail.load(std::memory_order_relaxed);
+            if (t - head.load(std::memory_order_acquire) == items.size())
+                return false;
+
+            items[t & mask] = item;
+            tail.store(t + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /// @brief Returns the oldest item or nullptr if the ring is empty. Only the consumer thread may call this
+        T *Front() {
+            auto h = head.load(std::memory_order_relaxed);
+            return h == tail.load(std::memory_order_acquire) ? nullptr : &items[h & mask];
+        }
+
+        /// @brief Removes the oldest item. Only the consumer thread may call this and only if Front() returned an item
+        void Pop() {
+            head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /// @brief Adds as many items as there is room for. Only the producer thread may call this
+        /// @return The number of items added
+        size_t Write(const T *source, size_t count) {
+            auto t = tail.load(std::memory_order_relaxed);
+            count = std::min(count, items.size() - (t - head.load(std::memory_order_acquire)));
+
+            auto index = t & mask;
+            auto first = std::min(count, items.size() - index); // items up to the end of the storage. The rest wrap around
+            std::copy_n(source, first, items.data() + index);
+            std::copy_n(source + first, count - first, items.data());
+            tail.store(t + count, std::memory_order_release);
+
+            return count;
+        }
+
+        /// @brief Removes as many items as are available. Only the consumer thread may call this
+        /// @return The number of items removed
+        size_t Read(T *destination, size_t count) {
+            auto h = head.load(std::memory_order_relaxed);
+            count = std::min(count, tail.load(std::memory_order_acquire) - h);
+
+            auto index = h & mask;
+            auto first = std::min(count, items.size() - index);
+            std::copy_n(items.data() + index, first, destination);
+            std::copy_n(items.data(), count - first, destination + first);
+            head.store(h + count, std::memory_order_release);
+
+            return count;
+        }
+
+      private:
+        std::vector<T> items;
+        size_t mask;
+        alignas(64) std::atomic<size_t> head; // next item to pop (only written by the consumer)
+        alignas(64) std::atomic<size_t> tail; // next free slot (only written by the producer)
+    };
+
+    /// @brief A voice change that is queued for the mixer
+    struct Command {
+        enum Type {
+            SET_VOICE_VOLUME = 0,
+            SET_VOICE_BALANCE,
+            SET_VOICE_FREQUENCY,
+            SET_VOICE_INTERPOLATION,
+            SET_VOICE_BUS,
+            SET_VOICE_REVERB_SEND,
+            STOP_VOICE,
+            PLAY_VOICE,
+            POKE_SOUND_FRAME,
+        };
+
+        // Every member has a default so that commands can be built with designated initializers that only name the fields they use
+        int32_t type = SET_VOICE_VOLUME; // one of Type
+        uint32_t voice = 0;              // the voice to change
+        float value = 0.0f;              // volume, balance, send level or sound frame
+        uint32_t parameter = 0;          // frequency, interpolation, bus, or play or poke position
+        int32_t sound = 0;               // the sound to play or poke
+        int32_t mode = 0;                // the play mode
+        uint32_t startPosition = 0;      // play start or loop start frame
+        uint32_t endPosition = 0;        // play end or loop end frame
+        uint64_t time = 0;               // the mixer frame at which the command is applied
+    };
+
+    /// @brief The voice settings as they were last set. The voice getters return these, so that they never read voices that the mixer owns
+    struct VoiceSettings {
+        float volume = VOLUME_MAX;
+        float balance = Voice::PAN_CENTER;
+        uint32_t frequency = 0;
+        int32_t interpolation = Voice::Interpolation::LINEAR;
+        uint32_t bus = MAIN_BUS;
+        float reverbSend = VOLUME_MIN;
+    };
+
+    /// @brief A fixed set of worker threads that run one job at a time. The calling thread takes part as worker 0
+    class WorkerPool {
+      public:
+        using Job = std::function<void(uint32_t worker)>;
+
+        /// @param threads The total number of threads including the calling thread
+        explicit WorkerPool(uint32_t threads) : job(nullptr), generation(0), pending(0), isQuitting(false) {
+            for (uint32_t i = 1; i < threads; i++)
+                workers.emplace_back([this, i]() { Work(i); });
+        }
+
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                isQuitting = true;
+            }
+
+            startCondition.notify_all();
+
+            for (auto &worker : workers)
+                worker.join();
+        }
+
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        uint32_t GetThreads() const {
+            return uint32_t(workers.size()) + 1;
+        }
+
+        /// @brief Runs job on every thread and waits for all of them to finish
+        void Run(const Job &job) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                this->job = &job;
+                pending = uint32_t(workers.size());
+                ++generation;
+            }
+
+            startCondition.notify_all();
+
+            job(0);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            doneCondition.wait(lock, [this]() { return !pending; });
+            this->job = nullptr;
+        }
+
+      private:
+        void Work(uint32_t worker) {
+            uint64_t lastGeneration = 0;
+
+            for (;;) {
+                const Job *currentJob;
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    startCondition.wait(lock, [&]() { return isQuitting or generation != lastGeneration; });
+                    if (isQuitting)
+                        return;
+
+                    lastGeneration = generation;
+                    currentJob = job;
+                }
+
+                (*currentJob)(worker);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!--pending)
+                    doneCondition.notify_one();
+            }
+        }
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable startCondition;
+        std::condition_variable doneCondition;
+        const Job *job;
+        uint64_t generation;
+        uint32_t pending;
+        bool isQuitting;
+    };
+
+    std::vector<Sound> sounds;                     // managed sounds
+    std::vector<Voice> voices;                     // managed voices
+    std::vector<VoiceSettings> voiceSettings;      // what the voice getters return (only used by the calling thread)
+    uint32_t sampleRate;                           // the mixer sampling rate
+    std::atomic<uint32_t> activeVoices;            // active voices
+    std::atomic<float> volume;                     // global volume (0.0 - 1.0)
+    uint32_t rampFrames;                           // frames over which volume, pan and frequency changes are spread (0 = no ramps)
+    bool isNativeStorage;                          // keep 8-bit and 16-bit mono sounds in their source format
+    bool isBitExact;                               // use the scalar mixing kernel that matches the per-frame reference mixer bit for bit
+    std::unique_ptr<WorkerPool> workerPool;        // mixing threads (nullptr when mixing on the calling thread only)
+    std::vector<std::vector<float>> workerBuffers; // stereo accumulation buffers (one per bus) for threads other than the calling thread
+    std::vector<Bus> buses;                        // mix buses. MAIN_BUS always exists
+    std::vector<float *> busTargets;               // per thread and bus buffers that voices are mixed into
+    std::vector<float> sourceBuffer;               // scratch buffer for bus sources
+    std::vector<const float *> masterInputs;       // buses that are summed by the master stage
+    std::vector<float> masterGains;                // gains of masterInputs
+    std::unique_ptr<verblib> reverb;               // reverb that is run on the reverb bus once per update (nullptr when disabled)
+    int32_t reverbBus;                             // the bus that voices send to (-1 until the reverb is first used)
+    bool isReverb;                                 // run the reverb and mix voice sends
+    std::unique_ptr<Ring<Command>> commands;       // voice changes waiting for the mixer (nullptr until the queue is first enabled)
+    bool isCommandQueue;                           // voice changes are queued instead of being applied right away
+    uint32_t commandOffset;                        // frames into the next update at which queued commands are applied
+    std::unordered_map<uint64_t, float> pokes;     // frames poked while the queue is enabled, so that peeks see them before the mixer does
+    std::atomic<uint64_t> renderedFrames;          // frames mixed since initialization. Queued commands are timed against this
+    std::unique_ptr<Ring<float>> renderRing;       // stereo frames mixed ahead by the render thread (nullptr until the thread is first started)
+    std::thread renderThread;                      // background thread that keeps renderRing topped up
+    std::atomic<bool> isRendering;                 // the render thread is running
+    uint32_t renderLatency;                        // frames that the render thread keeps in renderRing
+    uint32_t renderBlockFrames;                    // frames that the render thread mixes at a time
+    std::atomic<uint64_t> renderUnderruns;         // reads that found fewer frames in renderRing than were asked for
 };
 
 static std::unique_ptr<SoftSynth> g_SoftSynth; // global softynth object
 
+/// @brief Returns true while the render thread is mixing. Voice changes, sound pokes and the global volume are safe to make then. Everything
+/// else that the mixer reads (sounds, total voices, buses, the reverb and mixer settings) is locked, and changing it is an error
+static inline bool SoftSynth_IsMixerLocked() {
+    return g_SoftSynth->isRendering.load(std::memory_order_acquire);
+}
+
 static inline constexpr bool SoftSynth_IsChannelsValid(uint8_t channels) {
     return channels >= 1;
 }
@@ -116,11 +568,29 @@ inline qb_bool __SoftSynth_Initialize(uint32_t sampleRate) {
     g_SoftSynth->sampleRate = sampleRate;
     g_SoftSynth->activeVoices = 0;
     g_SoftSynth->volume = 1.0f;
+    g_SoftSynth->isBitExact = false;
+    g_SoftSynth->isNativeStorage = false;
+    g_SoftSynth->rampFrames = 0;
+    g_SoftSynth->buses.emplace_back("main");
+    g_SoftSynth->reverbBus = -1;
+    g_SoftSynth->isReverb = false;
+    g_SoftSynth->isCommandQueue = false;
+    g_SoftSynth->commandOffset = 0;
+    g_SoftSynth->renderedFrames = 0;
+    g_SoftSynth->isRendering = false;
+    g_SoftSynth->renderLatency = 0;
+    g_SoftSynth->renderBlockFrames = 0;
+    g_SoftSynth->renderUnderruns = 0;
 
     return QB_TRUE;
 }
 
+void SoftSynth_StopRenderThread();
+
 inline void __SoftSynth_Finalize() {
+    if (g_SoftSynth)
+        SoftSynth_StopRenderThread();
+
     g_SoftSynth.reset();
 }
 
@@ -156,13 +626,14 @@ uint32_t SoftSynth_GetTotalVoices() {
 }
 
 void SoftSynth_SetTotalVoices(uint32_t voices) {
-    if (!g_SoftSynth or voices < 1) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or voices < 1) {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
         return;
     }
 
     g_SoftSynth->voices.clear();
     g_SoftSynth->voices.resize(voices);
+    g_SoftSynth->voiceSettings.assign(voices, {});
 }
 
 uint32_t SoftSynth_GetActiveVoices() {
@@ -192,15 +663,133 @@ void SoftSynth_SetGlobalVolume(float volume) {
     g_SoftSynth->volume = std::clamp(volume, SoftSynth::VOLUME_MIN, SoftSynth::VOLUME_MAX);
 }
 
+/// @brief Returns true if the mixer is in bit-exact mode
+qb_bool SoftSynth_IsBitExactMixing() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return QB_FALSE;
+    }
+
+    return TO_QB_BOOL(g_SoftSynth->isBitExact);
+}
+
+/// @brief Enables or disables bit-exact mixing. In bit-exact mode voices are mixed with the scalar kernel, which produces exactly the
+/// same output on every build. Otherwise SSE / AVX kernels are used when available and the output may differ in the last bits
+/// @param enable True to enable bit-exact mixing
+void SoftSynth_SetBitExactMixing(qb_bool enable) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    g_SoftSynth->isBitExact = enable;
+}
+
+/// @brief Returns the number of threads used for mixing voices
+uint32_t SoftSynth_GetMixerThreads() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return g_SoftSynth->workerPool ? g_SoftSynth->workerPool->GetThreads() : 1;
+}
+
+/// @brief Sets the number of threads used for mixing voices. With more than one thread the voices are split between a pool of workers that
+/// each mix into their own buffer, and the buffers are then added together. Bit-exact mixing always uses only the calling thread
+/// @param threads The total number of mixing threads including the calling thread. 0 uses one thread per hardware thread
+void SoftSynth_SetMixerThreads(uint32_t threads) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    if (!threads)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    if (threads == SoftSynth_GetMixerThreads())
+        return;
+
+    g_SoftSynth->workerPool.reset();
+    g_SoftSynth->workerBuffers.clear();
+
+    if (threads > 1) {
+        g_SoftSynth->workerPool = std::make_unique<SoftSynth::WorkerPool>(threads);
+        g_SoftSynth->workerBuffers.resize(threads - 1);
+    }
+}
+
+/// @brief Returns the length of volume, pan and frequency ramps in frames
+uint32_t SoftSynth_GetRampFrames() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return g_SoftSynth->rampFrames;
+}
+
+/// @brief Sets the length of volume, pan and frequency ramps. When a playing voice is changed, the mixer moves to the new value linearly over
+/// this many frames instead of jumping to it, which avoids clicks. Starting a voice always applies its settings at once
+/// @param frames The ramp length in frames. 0 turns ramping off
+void SoftSynth_SetRampFrames(uint32_t frames) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    g_SoftSynth->rampFrames = frames;
+}
+
+/// @brief Returns the ramp length to use for a voice. Changes to idle voices do not need a ramp
+static inline uint32_t SoftSynth_GetVoiceRampFrames(const SoftSynth::Voice &voice) {
+    return voice.sound >= 0 ? g_SoftSynth->rampFrames : 0;
+}
+
+/// @brief Returns true if sounds that are loaded keep their source format
+qb_bool SoftSynth_IsNativeSoundStorage() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return QB_FALSE;
+    }
+
+    return TO_QB_BOOL(g_SoftSynth->isNativeStorage);
+}
+
+/// @brief Enables or disables native sound storage for sounds loaded after this call. With native storage, mono 8-bit and 16-bit sounds are
+/// kept as they are (using 1/4 and 1/2 of the memory) and converted to floating point by the mixer as they play. The mixer output is the same
+/// @param enable True to enable native storage
+void SoftSynth_SetNativeSoundStorage(qb_bool enable) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    g_SoftSynth->isNativeStorage = enable;
+}
+
+/// @brief Returns the bytes used by each sample frame of a sound (1 or 2 for sounds in native storage, otherwise 4)
+/// @param sound The sound slot / index
+uint8_t SoftSynth_GetSoundBytesPerSample(int32_t sound) {
+    if (!g_SoftSynth or sound < 0 or size_t(sound) >= g_SoftSynth->sounds.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return g_SoftSynth->sounds[sound].bytesPerSample;
+}
+
 /// @brief Copies and prepares the sound data in memory. Multi-channel sounds are flattened to mono.
-/// All sample types are converted to 32-bit floating point. All integer based samples passed must be signed.
+/// All sample types are converted to 32-bit floating point unless native storage is enabled and the sound is mono. All integer based
+/// samples passed must be signed.
 /// @param sound The sound slot / index
 /// @param source A pointer to the raw sound data
 /// @param bytes The size of the raw sound in bytes
 /// @param bytesPerSample The bytes / samples (this can be 1 for 8-bit, 2 for 16-bit or 3 for 32-bit)
 /// @param channels The number of channels (this must be 1 or more)
 inline void __SoftSynth_LoadSound(int32_t sound, const char *const source, uint32_t bytes, uint8_t bytesPerSample, uint8_t channels) {
-    if (!g_SoftSynth or sound < 0 or !source or !SoftSynth_IsBytesPerSampleValid(bytesPerSample) or !SoftSynth_IsChannelsValid(channels)) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or sound < 0 or !source or !SoftSynth_IsBytesPerSampleValid(bytesPerSample) or
+        !SoftSynth_IsChannelsValid(channels)) {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
         return;
     }
@@ -211,14 +800,30 @@ inline void __SoftSynth_LoadSound(int32_t sound, const char *const source, uint3
     }
 
     auto frames = SoftSynth_BytesToFrames(bytes, bytesPerSample, channels);
-    auto &data = g_SoftSynth->sounds[sound];
+    auto &soundData = g_SoftSynth->sounds[sound];
 
-    data.clear(); // resize to zero frames
+    std::erase_if(g_SoftSynth->pokes, [sound](const auto &poked) { return poked.first >> 32 == uint64_t(sound); });
+
+    // Release the old frames
+    soundData.data.clear();
+    soundData.data.shrink_to_fit();
+    soundData.frames = 0;
 
     if (!frames)
         return; // no need to proceed if we have no frames to load
 
-    data.resize(frames); // resize the buffer
+    // Mono sounds can be kept as they are. Flattening more channels could overflow the sample type
+    if (g_SoftSynth->isNativeStorage and channels == 1) {
+        soundData.bytesPerSample = bytesPerSample;
+        soundData.frames = frames;
+        soundData.data.assign(source, source + size_t(frames) * bytesPerSample);
+        return;
+    }
+
+    soundData.bytesPerSample = sizeof(float);
+    soundData.frames = frames;
+    soundData.data.resize(size_t(frames) * sizeof(float)); // resize the buffer (this zeros the new frames)
+    auto data = soundData.GetData<float>();
 
     switch (bytesPerSample) {
     case sizeof(int8_t): {
@@ -259,30 +864,51 @@ inline void __SoftSynth_LoadSound(int32_t sound, const char *const source, uint3
     }
 }
 
-/// @brief Gets a raw sound frame (in fp32 format)
+static inline void SoftSynth_SubmitCommand(SoftSynth::Command command);
+
+/// @brief Returns the key of a sound frame in SoftSynth::pokes
+static inline constexpr uint64_t SoftSynth_GetPokedFrameKey(int32_t sound, uint32_t position) {
+    return uint64_t(sound) << 32 | position;
+}
+
+/// @brief Gets a raw sound frame (in fp32 format). Frames that were poked while the command queue is enabled are returned as poked, even if
+/// the mixer has not applied them yet. Those are the only frames that the mixer writes to, so this is safe while the render thread runs
 /// @param sound The sound slot / index
 /// @param position The frame position
 /// @return A floating point sample frame
 float SoftSynth_PeekSoundFrameSingle(int32_t sound, uint32_t position) {
-    if (!g_SoftSynth or sound < 0 or sound >= g_SoftSynth->sounds.size() or position >= g_SoftSynth->sounds[sound].size()) {
+    if (!g_SoftSynth or sound < 0 or size_t(sound) >= g_SoftSynth->sounds.size() or position >= g_SoftSynth->sounds[sound].size()) {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
         return 0.0f;
     }
 
-    return g_SoftSynth->sounds[sound][position];
+    if (!g_SoftSynth->pokes.empty()) {
+        auto poked = g_SoftSynth->pokes.find(SoftSynth_GetPokedFrameKey(sound, position));
+        if (poked != g_SoftSynth->pokes.end())
+            return poked->second;
+    }
+
+    return g_SoftSynth->sounds[sound].GetFrame(position);
 }
 
-/// @brief Sets a raw sound frame (in fp32 format)
+/// @brief Sets a raw sound frame (in fp32 format). When the command queue is enabled, the change is queued like a voice change, so that the
+/// mixer never sees a frame change under it
 /// @param sound The sound slot / index
 /// @param position The frame position
 /// @param frame A floating point sample frame
 void SoftSynth_PokeSoundFrameSingle(int32_t sound, uint32_t position, float frame) {
-    if (!g_SoftSynth or sound < 0 or sound >= g_SoftSynth->sounds.size() or position >= g_SoftSynth->sounds[sound].size()) {
+    if (!g_SoftSynth or sound < 0 or size_t(sound) >= g_SoftSynth->sounds.size() or position >= g_SoftSynth->sounds[sound].size()) {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
         return;
     }
 
-    g_SoftSynth->sounds[sound][position] = frame;
+    if (g_SoftSynth->isCommandQueue) {
+        g_SoftSynth->pokes[SoftSynth_GetPokedFrameKey(sound, position)] = g_SoftSynth->sounds[sound].RoundTrip(frame);
+        SoftSynth_SubmitCommand({.type = SoftSynth::Command::POKE_SOUND_FRAME, .value = frame, .parameter = position, .sound = sound});
+        return;
+    }
+
+    g_SoftSynth->sounds[sound].SetFrame(position, frame);
 }
 
 inline int16_t SoftSynth_PeekSoundFrameInteger(int32_t sound, uint32_t position) {
@@ -301,81 +927,582 @@ inline void SoftSynth_PokeSoundFrameByte(int32_t sound, uint32_t position, int8_
     SoftSynth_PokeSoundFrameSingle(sound, position, SoftSynth::Voice::MULTIPLIER_8_TO_32 * frame);
 }
 
-float SoftSynth_GetVoiceVolume(uint32_t voice) {
-    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
-        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
-        return 0.0f;
+/// @brief Applies a voice change. This is called right away or by the mixer when the command is due
+static inline void SoftSynth_ApplyCommand(const SoftSynth::Command &command) {
+    if (SoftSynth::Command::POKE_SOUND_FRAME == command.type) {
+        // Sounds can be reloaded while commands are queued
+        if (command.sound >= 0 and size_t(command.sound) < g_SoftSynth->sounds.size() and command.parameter < g_SoftSynth->sounds[command.sound].size())
+            g_SoftSynth->sounds[command.sound].SetFrame(command.parameter, command.value);
+
+        return;
     }
 
-    return g_SoftSynth->voices[voice].volume;
+    // Voices and sounds can be reset while commands are queued
+    if (command.voice >= g_SoftSynth->voices.size() or
+        (SoftSynth::Command::PLAY_VOICE == command.type and (command.sound < 0 or size_t(command.sound) >= g_SoftSynth->sounds.size())))
+        return;
+
+    auto &v = g_SoftSynth->voices[command.voice];
+
+    switch (command.type) {
+    case SoftSynth::Command::SET_VOICE_VOLUME:
+        v.volume = command.value;
+        v.SetMixGain(SoftSynth_GetVoiceRampFrames(v));
+        break;
+
+    case SoftSynth::Command::SET_VOICE_BALANCE:
+        v.SetPanPosition(command.value);
+        v.SetMixGain(SoftSynth_GetVoiceRampFrames(v));
+        break;
+
+    case SoftSynth::Command::SET_VOICE_FREQUENCY:
+        v.frequency = command.parameter; // save this to avoid a division in GetVoiceFrequency()
+        v.SetPitch((float)command.parameter / (float)g_SoftSynth->sampleRate, SoftSynth_GetVoiceRampFrames(v));
+        break;
+
+    case SoftSynth::Command::SET_VOICE_INTERPOLATION:
+        v.interpolation = command.parameter;
+        break;
+
+    case SoftSynth::Command::SET_VOICE_BUS:
+        v.bus = command.parameter;
+        break;
+
+    case SoftSynth::Command::SET_VOICE_REVERB_SEND:
+        v.reverbSend = command.value;
+        break;
+
+    case SoftSynth::Command::STOP_VOICE:
+        v.Reset();
+        break;
+
+    case SoftSynth::Command::PLAY_VOICE: {
+        auto position = command.parameter;
+        auto &sound = g_SoftSynth->sounds[command.sound];
+
+        v.mode = command.mode;
+        v.isReversing = SoftSynth::Voice::PlayMode::REVERSE == v.mode;
+        v.position = position;                   // if this value is junk then the mixer should deal with it correctly
+        v.iPosition = position;                  // if this value is junk then the mixer should deal with it correctly
+        v.startPosition = command.startPosition; // if this value is junk then the mixer should deal with it correctly
+        v.endPosition = command.endPosition;     // if this value is junk then the mixer should deal with it correctly
+        v.sound = command.sound;
+        // These two need to be setup because both position are iPosition are the same when we start playback
+        // Fetching the initial frame will help avoid clicks and pops
+        v.frame = position < sound.size() ? sound.GetFrame(position) : 0.0f;
+        v.oldFrame = v.frame;
+        // A new sound starts with the current settings. Finish any ramps that are still running
+        v.SetPitch(v.targetPitch, 0);
+        v.SetMixGain(0);
+    } break;
+    }
 }
 
-void SoftSynth_SetVoiceVolume(uint32_t voice, float volume) {
-    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
-        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+/// @brief Keeps the settings that the voice getters return in step with a voice change
+static inline void SoftSynth_UpdateVoiceSettings(const SoftSynth::Command &command) {
+    auto &settings = g_SoftSynth->voiceSettings[command.voice];
+
+    switch (command.type) {
+    case SoftSynth::Command::SET_VOICE_VOLUME:
+        settings.volume = command.value;
+        break;
+
+    case SoftSynth::Command::SET_VOICE_BALANCE:
+        settings.balance = std::clamp(command.value, SoftSynth::Voice::PAN_LEFT, SoftSynth::Voice::PAN_RIGHT);
+        break;
+
+    case SoftSynth::Command::SET_VOICE_FREQUENCY:
+        settings.frequency = command.parameter;
+        break;
+
+    case SoftSynth::Command::SET_VOICE_INTERPOLATION:
+        settings.interpolation = int32_t(command.parameter);
+        break;
+
+    case SoftSynth::Command::SET_VOICE_BUS:
+        settings.bus = command.parameter;
+        break;
+
+    case SoftSynth::Command::SET_VOICE_REVERB_SEND:
+        settings.reverbSend = command.value;
+        break;
+
+    case SoftSynth::Command::STOP_VOICE:
+        // Like Voice::Reset()
+        settings.volume = SoftSynth::VOLUME_MAX;
+        settings.frequency = 0;
+        break;
+    }
+}
+
+/// @brief Queues a voice change for the mixer if the command queue is enabled, or else applies it right away
+static inline void SoftSynth_SubmitCommand(SoftSynth::Command command) {
+    if (SoftSynth::Command::POKE_SOUND_FRAME != command.type)
+        SoftSynth_UpdateVoiceSettings(command);
+
+    if (!g_SoftSynth->isCommandQueue) {
+        SoftSynth_ApplyCommand(command);
         return;
     }
 
-    g_SoftSynth->voices[voice].volume = std::clamp(volume, SoftSynth::VOLUME_MIN, SoftSynth::VOLUME_MAX);
+    command.time = g_SoftSynth->renderedFrames.load(std::memory_order_acquire) + g_SoftSynth->commandOffset;
+
+    // A full queue means that the mixer is not being updated
+    if (!g_SoftSynth->commands->Push(command))
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
 }
 
-float SoftSynth_GetVoiceBalance(uint32_t voice) {
-    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+/// @brief Returns true if voice changes are queued for the mixer
+qb_bool SoftSynth_IsCommandQueueEnabled() {
+    if (!g_SoftSynth) {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
-        return 0.0f;
+        return QB_FALSE;
     }
 
-    return g_SoftSynth->voices[voice].panPosition;
+    return TO_QB_BOOL(g_SoftSynth->isCommandQueue);
 }
 
-void SoftSynth_SetVoiceBalance(uint32_t voice, float balance) {
-    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+/// @brief Enables or disables the command queue. When enabled, voice changes (volume, balance, frequency, interpolation, bus, reverb send, play
+/// and stop) and sound pokes are pushed to a lock-free queue and the mixer applies them at their frame within the next update. This lets the
+/// mixer run on another thread and gives sample-accurate timing. Voice getters and peeks return the last value that was set, even if the mixer
+/// has not applied it yet. Other settings (sounds, total voices, buses etc.) must not be changed while the mixer is running on another thread.
+/// The queue cannot be disabled while the render thread is running. Disabling the queue applies whatever is still queued right away and resets
+/// the command offset
+/// @param enable True to queue voice changes
+void SoftSynth_SetCommandQueueEnabled(qb_bool enable) {
+    if (!g_SoftSynth or (!enable and SoftSynth_IsMixerLocked())) {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
         return;
     }
 
-    g_SoftSynth->voices[voice].SetPanPosition(balance);
+    if (enable and !g_SoftSynth->commands)
+        g_SoftSynth->commands = std::make_unique<SoftSynth::Ring<SoftSynth::Command>>(SoftSynth::COMMAND_QUEUE_CAPACITY);
+
+    if (!enable and g_SoftSynth->commands) {
+        // Queued commands are older than any direct change made from now on, so they must not be applied after them
+        for (auto command = g_SoftSynth->commands->Front(); command; command = g_SoftSynth->commands->Front()) {
+            SoftSynth_ApplyCommand(*command);
+            g_SoftSynth->commands->Pop();
+        }
+
+        g_SoftSynth->commandOffset = 0;
+        g_SoftSynth->pokes.clear();
+    }
+
+    g_SoftSynth->isCommandQueue = enable;
 }
 
-/// @brief Gets the voice frequency
-/// @param voice The voice number to get the frequency for
-/// @return The frequency value
-uint32_t SoftSynth_GetVoiceFrequency(uint32_t voice) {
-    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+uint32_t SoftSynth_GetCommandOffset() {
+    if (!g_SoftSynth) {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
-        return 0.0f;
+        return 0;
     }
 
-    return g_SoftSynth->voices[voice].frequency;
+    return g_SoftSynth->commandOffset;
 }
 
-/// @brief Sets the voice frequency
-/// @param voice The voice number to set the frequency for
-/// @param frequency The frequency to be set (must be > 0)
-void SoftSynth_SetVoiceFrequency(uint32_t voice, uint32_t frequency) {
-    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size() or !frequency) {
+/// @brief Sets the timestamp of the voice changes that are queued after this call
+/// @param frames The frame offset from the start of the next update. Commands that are due beyond that update wait for a later update
+void SoftSynth_SetCommandOffset(uint32_t frames) {
+    if (!g_SoftSynth) {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
         return;
     }
 
-    g_SoftSynth->voices[voice].frequency = frequency; // save this to avoid a division in GetVoiceFrequency()
-    g_SoftSynth->voices[voice].pitch = (float)frequency / (float)g_SoftSynth->sampleRate;
+    g_SoftSynth->commandOffset = frames;
 }
 
-void SoftSynth_StopVoice(uint32_t voice) {
+/// @brief Returns the number of frames mixed since initialization
+uint64_t SoftSynth_GetRenderedFrames() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return g_SoftSynth->renderedFrames.load(std::memory_order_acquire);
+}
+
+float SoftSynth_GetVoiceVolume(uint32_t voice) {
     if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
-        return;
+        return 0.0f;
     }
 
-    g_SoftSynth->voices[voice].Reset();
+    return g_SoftSynth->voiceSettings[voice].volume;
 }
 
-/// @brief Plays a sound using a voice
+void SoftSynth_SetVoiceVolume(uint32_t voice, float volume) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    SoftSynth_SubmitCommand({.type = SoftSynth::Command::SET_VOICE_VOLUME,
+                             .voice = voice,
+                             .value = std::clamp(volume, SoftSynth::VOLUME_MIN, SoftSynth::VOLUME_MAX)});
+}
+
+float SoftSynth_GetVoiceBalance(uint32_t voice) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0.0f;
+    }
+
+    return g_SoftSynth->voiceSettings[voice].balance;
+}
+
+void SoftSynth_SetVoiceBalance(uint32_t voice, float balance) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    SoftSynth_SubmitCommand({.type = SoftSynth::Command::SET_VOICE_BALANCE, .voice = voice, .value = balance});
+}
+
+/// @brief Gets the voice frequency
+/// @param voice The voice number to get the frequency for
+/// @return The frequency value
+uint32_t SoftSynth_GetVoiceFrequency(uint32_t voice) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0.0f;
+    }
+
+    return g_SoftSynth->voiceSettings[voice].frequency;
+}
+
+/// @brief Sets the voice frequency
+/// @param voice The voice number to set the frequency for
+/// @param frequency The frequency to be set (must be > 0)
+void SoftSynth_SetVoiceFrequency(uint32_t voice, uint32_t frequency) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size() or !frequency) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    SoftSynth_SubmitCommand({.type = SoftSynth::Command::SET_VOICE_FREQUENCY, .voice = voice, .parameter = frequency});
+}
+
+/// @brief Gets the voice interpolation mode
+/// @param voice The voice number to get the interpolation mode for
+/// @return One of the SoftSynth::Voice::Interpolation values
+int32_t SoftSynth_GetVoiceInterpolation(uint32_t voice) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return SoftSynth::Voice::Interpolation::LINEAR;
+    }
+
+    return g_SoftSynth->voiceSettings[voice].interpolation;
+}
+
+/// @brief Sets the voice interpolation mode. This can be changed while the voice is playing
+/// @param voice The voice number to set the interpolation mode for
+/// @param interpolation One of the SoftSynth::Voice::Interpolation values
+void SoftSynth_SetVoiceInterpolation(uint32_t voice, int32_t interpolation) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size() or interpolation < SoftSynth::Voice::Interpolation::NEAREST or
+        interpolation > SoftSynth::Voice::Interpolation::SINC) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    SoftSynth_SubmitCommand({.type = SoftSynth::Command::SET_VOICE_INTERPOLATION, .voice = voice, .parameter = uint32_t(interpolation)});
+}
+
+/// @brief Adds one stereo buffer to another
+/// @param output The buffer that receives the sum
+/// @param input The buffer to add
+/// @param samples The number of samples (not frames)
+static inline void SoftSynth_AddBuffer(float *output, const float *input, size_t samples) {
+    size_t i = 0;
+
+#if defined(SOFTSYNTH_USE_AVX)
+    for (; i + 8 <= samples; i += 8)
+        _mm256_storeu_ps(output + i, _mm256_add_ps(_mm256_loadu_ps(output + i), _mm256_loadu_ps(input + i)));
+#endif
+
+#if defined(SOFTSYNTH_USE_SSE2)
+    for (; i + 4 <= samples; i += 4)
+        _mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), _mm_loadu_ps(input + i)));
+#endif
+
+    for (; i < samples; i++)
+        output[i] += input[i];
+}
+
+/// @brief Returns the number of mix buses (including the main bus)
+uint32_t SoftSynth_GetTotalBuses() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return (uint32_t)g_SoftSynth->buses.size();
+}
+
+/// @brief Finds a mix bus by name
+/// @param name The bus name (NUL terminated)
+/// @return The bus number or -1 if there is no bus with that name
+int32_t __SoftSynth_GetBus(const char *name) {
+    if (!g_SoftSynth or !name) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return -1;
+    }
+
+    for (size_t bus = 0; bus < g_SoftSynth->buses.size(); bus++) {
+        if (g_SoftSynth->buses[bus].name == name)
+            return int32_t(bus);
+    }
+
+    return -1;
+}
+
+/// @brief Creates a mix bus. Buses live as long as the SoftSynth object
+/// @param name A unique bus name (NUL terminated). If a bus with this name already exists then that bus is returned
+/// @return The bus number
+int32_t __SoftSynth_CreateBus(const char *name) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or !name or !*name) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return -1;
+    }
+
+    auto bus = __SoftSynth_GetBus(name);
+    if (bus >= 0)
+        return bus;
+
+    g_SoftSynth->buses.emplace_back(name);
+
+    return int32_t(g_SoftSynth->buses.size() - 1);
+}
+
+float SoftSynth_GetBusGain(uint32_t bus) {
+    if (!g_SoftSynth or bus >= g_SoftSynth->buses.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0.0f;
+    }
+
+    return g_SoftSynth->buses[bus].gain;
+}
+
+void SoftSynth_SetBusGain(uint32_t bus, float gain) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or bus >= g_SoftSynth->buses.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    g_SoftSynth->buses[bus].gain = std::clamp(gain, SoftSynth::VOLUME_MIN, SoftSynth::VOLUME_MAX);
+}
+
+/// @brief Attaches a sample source to a bus. The source is asked for as many frames as the mixer renders on every update. Buses with a source
+/// cannot be used with the render thread
+/// @param bus The bus number
+/// @param source A SoftSynth::Bus::Source function pointer (e.g. from OPL3_GetSampleSource) or 0 to detach the current source
+void SoftSynth_SetBusSource(uint32_t bus, uintptr_t source) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or bus >= g_SoftSynth->buses.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    g_SoftSynth->buses[bus].source = reinterpret_cast<SoftSynth::Bus::Source>(source);
+}
+
+uint32_t SoftSynth_GetVoiceBus(uint32_t voice) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return SoftSynth::MAIN_BUS;
+    }
+
+    return g_SoftSynth->voiceSettings[voice].bus;
+}
+
+/// @brief Routes a voice to a mix bus. This can be changed while the voice is playing
+/// @param voice The voice number
+/// @param bus The bus number
+void SoftSynth_SetVoiceBus(uint32_t voice, uint32_t bus) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size() or bus >= g_SoftSynth->buses.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    SoftSynth_SubmitCommand({.type = SoftSynth::Command::SET_VOICE_BUS, .voice = voice, .parameter = bus});
+}
+
+/// @brief Adds an external stereo interleaved buffer to a bus. The frames are mixed in on the next update. Frames beyond what that update
+/// renders are dropped
+/// @param bus The bus number
+/// @param buffer The buffer to add
+/// @param frames The number of frames in the buffer
+void SoftSynth_MixBusBuffer(uint32_t bus, const float *buffer, uint32_t frames) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or bus >= g_SoftSynth->buses.size() or !buffer) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    auto &b = g_SoftSynth->buses[bus];
+    auto samples = size_t(frames) * 2;
+
+    if (b.buffer.size() < samples)
+        b.buffer.resize(samples, 0.0f);
+
+    SoftSynth_AddBuffer(b.buffer.data(), buffer, samples);
+    b.isPending = true;
+}
+
+/// @brief Returns the reverb, creating it and the "reverb" bus the first time it is needed
+/// @return nullptr if the reverb does not support the mixer sample rate
+static inline verblib *SoftSynth_GetReverb() {
+    if (!g_SoftSynth->reverb) {
+        // Creating the reverb adds a bus
+        if (SoftSynth_IsMixerLocked())
+            return nullptr;
+
+        auto reverb = std::make_unique<verblib>();
+        if (!verblib_initialize(reverb.get(), g_SoftSynth->sampleRate, 2))
+            return nullptr;
+
+        g_SoftSynth->reverb = std::move(reverb);
+        g_SoftSynth->reverbBus = __SoftSynth_CreateBus("reverb");
+    }
+
+    return g_SoftSynth->reverb.get();
+}
+
+/// @brief Returns true if the reverb is running
+qb_bool SoftSynth_IsReverbEnabled() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return QB_FALSE;
+    }
+
+    return TO_QB_BOOL(g_SoftSynth->isReverb);
+}
+
+/// @brief Turns the reverb on or off. Voices are sent to the "reverb" bus based on their send level, and the reverb is run once per update on
+/// whatever was summed into that bus. The bus gain is the reverb return level. The reverb works at sample rates of 22050 Hz and above
+/// @param enable True to enable the reverb. A reverb that is enabled again starts without a tail
+void SoftSynth_SetReverbEnabled(qb_bool enable) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    if (enable and !g_SoftSynth->isReverb) {
+        auto reverb = SoftSynth_GetReverb();
+        if (!reverb) {
+            error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+            return;
+        }
+
+        verblib_mute(reverb);
+    }
+
+    g_SoftSynth->isReverb = enable;
+}
+
+/// @brief Returns the reverb bus number. This creates the reverb (but does not enable it) if needed
+int32_t SoftSynth_GetReverbBus() {
+    if (!g_SoftSynth or !SoftSynth_GetReverb()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return -1;
+    }
+
+    return g_SoftSynth->reverbBus;
+}
+
+float SoftSynth_GetReverbRoomSize() {
+    if (!g_SoftSynth or !SoftSynth_GetReverb()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0.0f;
+    }
+
+    return verblib_get_room_size(g_SoftSynth->reverb.get());
+}
+
+/// @brief Sets the reverb room size (0.0 - 1.0)
+void SoftSynth_SetReverbRoomSize(float value) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or !SoftSynth_GetReverb()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    verblib_set_room_size(g_SoftSynth->reverb.get(), std::clamp(value, 0.0f, 1.0f));
+}
+
+float SoftSynth_GetReverbDamping() {
+    if (!g_SoftSynth or !SoftSynth_GetReverb()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0.0f;
+    }
+
+    return verblib_get_damping(g_SoftSynth->reverb.get());
+}
+
+/// @brief Sets the reverb high frequency damping (0.0 - 1.0)
+void SoftSynth_SetReverbDamping(float value) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or !SoftSynth_GetReverb()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    verblib_set_damping(g_SoftSynth->reverb.get(), std::clamp(value, 0.0f, 1.0f));
+}
+
+float SoftSynth_GetReverbWidth() {
+    if (!g_SoftSynth or !SoftSynth_GetReverb()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0.0f;
+    }
+
+    return verblib_get_width(g_SoftSynth->reverb.get());
+}
+
+/// @brief Sets the stereo width of the reverb tail (0.0 - 1.0)
+void SoftSynth_SetReverbWidth(float value) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or !SoftSynth_GetReverb()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    verblib_set_width(g_SoftSynth->reverb.get(), std::clamp(value, 0.0f, 1.0f));
+}
+
+float SoftSynth_GetVoiceReverbSend(uint32_t voice) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0.0f;
+    }
+
+    return g_SoftSynth->voiceSettings[voice].reverbSend;
+}
+
+/// @brief Sets how much of a voice is sent to the reverb. The send is taken after the voice volume and balance
+/// @param voice The voice number
+/// @param level The send level (0.0 - 1.0)
+void SoftSynth_SetVoiceReverbSend(uint32_t voice, float level) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    SoftSynth_SubmitCommand({.type = SoftSynth::Command::SET_VOICE_REVERB_SEND,
+                             .voice = voice,
+                             .value = std::clamp(level, SoftSynth::VOLUME_MIN, SoftSynth::VOLUME_MAX)});
+}
+
+void SoftSynth_StopVoice(uint32_t voice) {
+    if (!g_SoftSynth or voice >= g_SoftSynth->voices.size()) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    SoftSynth_SubmitCommand({.type = SoftSynth::Command::STOP_VOICE, .voice = voice});
+}
+
+/// @brief Plays a sound using a voice
 /// @param voice The voice to use to play the sound
 /// @param sound The sound to play
 /// @param position The position (in frames) in the sound where playback should start
-/// @param mode The playback mode
+/// @param mode The playback mode (REVERSE plays from position down to start)
 /// @param start The playback start frame or loop start frame (based on playMode)
 /// @param end The playback end frame or loop end frame (based on playMode)
 void SoftSynth_PlayVoice(uint32_t voice, int32_t sound, uint32_t position, int32_t mode, uint32_t startPosition, uint32_t endPosition) {
@@ -384,107 +1511,791 @@ void SoftSynth_PlayVoice(uint32_t voice, int32_t sound, uint32_t position, int32
         return;
     }
 
-    g_SoftSynth->voices[voice].mode =
-        mode < SoftSynth::Voice::PlayMode::FORWARD or mode > SoftSynth::Voice::PlayMode::FORWARD_LOOP ? SoftSynth::Voice::PlayMode::FORWARD : mode;
-    g_SoftSynth->voices[voice].position = position;           // if this value is junk then the mixer should deal with it correctly
-    g_SoftSynth->voices[voice].iPosition = position;          // if this value is junk then the mixer should deal with it correctly
-    g_SoftSynth->voices[voice].startPosition = startPosition; // if this value is junk then the mixer should deal with it correctly
-    g_SoftSynth->voices[voice].endPosition = endPosition;     // if this value is junk then the mixer should deal with it correctly
-    g_SoftSynth->voices[voice].sound = sound;
-    // These two need to be setup because both position are iPosition are the same when we start playback
-    // Fetching the initial frame will help avoid clicks and pops
-    g_SoftSynth->voices[voice].frame = position < g_SoftSynth->sounds[sound].size() ? g_SoftSynth->sounds[sound][position] : 0.0f;
-    g_SoftSynth->voices[voice].oldFrame = g_SoftSynth->voices[voice].frame;
+    SoftSynth_SubmitCommand({.type = SoftSynth::Command::PLAY_VOICE,
+                             .voice = voice,
+                             .parameter = position,
+                             .sound = sound,
+                             .mode = mode < SoftSynth::Voice::PlayMode::FORWARD or mode > SoftSynth::Voice::PlayMode::REVERSE
+                                         ? int32_t(SoftSynth::Voice::PlayMode::FORWARD)
+                                         : mode,
+                             .startPosition = startPosition,
+                             .endPosition = endPosition});
 }
 
-/// @brief This mixes and writes the mixed samples to "buffer"
-/// @param buffer A buffer pointer that will receive the mixed samples (the buffer is not cleared before mixing)
+/// @brief Scalar mixing kernel. This matches the original per-frame mixer bit for bit
+/// @param output Stereo interleaved output (2 * frames samples)
+/// @param oldFrames The frame before each output frame
+/// @param newFrames The frame at each output frame
+/// @param fractions The fractional position between the two frames
 /// @param frames The number of frames to mix
-inline void __SoftSynth_Update(float *buffer, uint32_t frames) {
-    if (!g_SoftSynth or !buffer or !frames) {
-        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
-        return;
+static inline void SoftSynth_MixBlockScalar(float *output, const float *oldFrames, const float *newFrames, const float *fractions, uint32_t frames,
+                                            float volume, const std::pair<float, float> &gain) {
+    for (uint32_t i = 0; i < frames; i++) {
+        auto outFrame = std::fma(newFrames[i] - oldFrames[i], fractions[i], oldFrames[i]) * volume;
+        output[0] = std::fma(outFrame, gain.first, output[0]);
+        output[1] = std::fma(outFrame, gain.second, output[1]);
+        output += 2;
     }
+}
 
-    // Get the total voices we need to mix
-    auto voiceCount = g_SoftSynth->voices.size();
+/// @brief SSE / AVX mixing kernel. Interpolation, volume and panning are done on 4 (SSE) or 8 (AVX) frames at a time
+static inline void SoftSynth_MixBlockSIMD(float *output, const float *oldFrames, const float *newFrames, const float *fractions, uint32_t frames,
+                                          float volume, const std::pair<float, float> &gain) {
+    uint32_t i = 0;
+
+#if defined(SOFTSYNTH_USE_AVX)
+    auto volume8 = _mm256_set1_ps(volume);
+    auto gain8 = _mm256_setr_ps(gain.first, gain.second, gain.first, gain.second, gain.first, gain.second, gain.first, gain.second);
+
+    for (; i + 8 <= frames; i += 8) {
+        auto oldFrame = _mm256_loadu_ps(oldFrames + i);
+        auto delta = _mm256_sub_ps(_mm256_loadu_ps(newFrames + i), oldFrame);
+    #if defined(__FMA__)
+        auto outFrame = _mm256_mul_ps(_mm256_fmadd_ps(delta, _mm256_loadu_ps(fractions + i), oldFrame), volume8);
+    #else
+        auto outFrame = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(delta, _mm256_loadu_ps(fractions + i)), oldFrame), volume8);
+    #endif
+
+        // Duplicate each mono frame into a left / right pair. unpack works within 128-bit lanes, so the halves are swapped back in order
+        auto low = _mm256_unpacklo_ps(outFrame, outFrame);  // 0 0 1 1 | 4 4 5 5
+        auto high = _mm256_unpackhi_ps(outFrame, outFrame); // 2 2 3 3 | 6 6 7 7
+        auto first = _mm256_permute2f128_ps(low, high, 0x20);  // 0 0 1 1 2 2 3 3
+        auto second = _mm256_permute2f128_ps(low, high, 0x31); // 4 4 5 5 6 6 7 7
+
+        auto out = output + i * 2;
+    #if defined(__FMA__)
+        _mm256_storeu_ps(out, _mm256_fmadd_ps(first, gain8, _mm256_loadu_ps(out)));
+        _mm256_storeu_ps(out + 8, _mm256_fmadd_ps(second, gain8, _mm256_loadu_ps(out + 8)));
+    #else
+        _mm256_storeu_ps(out, _mm256_add_ps(_mm256_mul_ps(first, gain8), _mm256_loadu_ps(out)));
+        _mm256_storeu_ps(out + 8, _mm256_add_ps(_mm256_mul_ps(second, gain8), _mm256_loadu_ps(out + 8)));
+    #endif
+    }
+#endif
 
-    //  Set the active voice count to zero
-    g_SoftSynth->activeVoices = 0;
+#if defined(SOFTSYNTH_USE_SSE2)
+    auto volume4 = _mm_set1_ps(volume);
+    auto gain4 = _mm_setr_ps(gain.first, gain.second, gain.first, gain.second);
+
+    for (; i + 4 <= frames; i += 4) {
+        auto oldFrame = _mm_loadu_ps(oldFrames + i);
+        auto delta = _mm_sub_ps(_mm_loadu_ps(newFrames + i), oldFrame);
+        auto outFrame = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(delta, _mm_loadu_ps(fractions + i)), oldFrame), volume4);
+
+        auto out = output + i * 2;
+        _mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(_mm_unpacklo_ps(outFrame, outFrame), gain4), _mm_loadu_ps(out)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_mul_ps(_mm_unpackhi_ps(outFrame, outFrame), gain4), _mm_loadu_ps(out + 4)));
+    }
+#endif
+
+    // Leftover frames (or everything if we have no SIMD support)
+    SoftSynth_MixBlockScalar(output + i * 2, oldFrames + i, newFrames + i, fractions + i, frames - i, volume, gain);
+}
+
+/// @brief Scalar mixing kernel for voices with a volume / pan ramp. The gain of frame i is gain + i * step
+static inline void SoftSynth_MixBlockRampScalar(float *output, const float *oldFrames, const float *newFrames, const float *fractions, uint32_t frames,
+                                                const std::pair<float, float> &gain, const std::pair<float, float> &step) {
+    for (uint32_t i = 0; i < frames; i++) {
+        auto outFrame = std::fma(newFrames[i] - oldFrames[i], fractions[i], oldFrames[i]);
+        output[0] += outFrame * (gain.first + float(i) * step.first);
+        output[1] += outFrame * (gain.second + float(i) * step.second);
+        output += 2;
+    }
+}
+
+/// @brief SSE mixing kernel for voices with a volume / pan ramp. The gains of 4 frames are worked out at a time from the start gain and step
+static inline void SoftSynth_MixBlockRampSIMD(float *output, const float *oldFrames, const float *newFrames, const float *fractions, uint32_t frames,
+                                              const std::pair<float, float> &gain, const std::pair<float, float> &step) {
+    uint32_t i = 0;
+
+#if defined(SOFTSYNTH_USE_SSE2)
+    auto gain4 = _mm_setr_ps(gain.first, gain.second, gain.first, gain.second);
+    auto step4 = _mm_setr_ps(step.first, step.second, step.first, step.second);
+    auto indexLow = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);  // frame index of each left / right pair in the low half of a block of 4 frames
+    auto indexHigh = _mm_setr_ps(2.0f, 2.0f, 3.0f, 3.0f); // and in the high half
+    auto four = _mm_set1_ps(4.0f);
+
+    for (; i + 4 <= frames; i += 4) {
+        auto oldFrame = _mm_loadu_ps(oldFrames + i);
+        auto delta = _mm_sub_ps(_mm_loadu_ps(newFrames + i), oldFrame);
+        auto outFrame = _mm_add_ps(_mm_mul_ps(delta, _mm_loadu_ps(fractions + i)), oldFrame);
+
+        auto out = output + i * 2;
+        auto gainLow = _mm_add_ps(gain4, _mm_mul_ps(indexLow, step4));
+        auto gainHigh = _mm_add_ps(gain4, _mm_mul_ps(indexHigh, step4));
+        _mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(_mm_unpacklo_ps(outFrame, outFrame), gainLow), _mm_loadu_ps(out)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_mul_ps(_mm_unpackhi_ps(outFrame, outFrame), gainHigh), _mm_loadu_ps(out + 4)));
+
+        indexLow = _mm_add_ps(indexLow, four);
+        indexHigh = _mm_add_ps(indexHigh, four);
+    }
+#endif
+
+    // Leftover frames (or everything if we have no SIMD support)
+    auto offset = float(i);
+    SoftSynth_MixBlockRampScalar(output + i * 2, oldFrames + i, newFrames + i, fractions + i, frames - i,
+                                 {gain.first + offset * step.first, gain.second + offset * step.second}, step);
+}
+
+/// @brief Converts contiguous sample frames to floating point. This gathers the taps of the multi-frame interpolation filters. The linear and
+/// nearest fetch in SoftSynth_MixVoice() does not use it: that fetch only converts a frame when the position crosses into it, which is a
+/// single convert and multiply, and converting the span up front measured no faster
+static inline void SoftSynth_ConvertFrames(const float *source, float *destination, uint32_t count) {
+    std::copy_n(source, count, destination);
+}
+
+/// @brief Converts contiguous 16-bit sample frames to floating point. The samples are widened 4 at a time with SSE2
+static inline void SoftSynth_ConvertFrames(const int16_t *source, float *destination, uint32_t count) {
+    uint32_t i = 0;
+
+#if defined(SOFTSYNTH_USE_SSE2)
+    auto scale = _mm_set1_ps(SoftSynth::Voice::MULTIPLIER_16_TO_32);
+
+    for (; i + 4 <= count; i += 4) {
+        auto samples = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(source + i));
+        auto widened = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16); // sign extend to 32-bit
+        _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtepi32_ps(widened), scale));
+    }
+#endif
+
+    for (; i < count; i++)
+        destination[i] = SoftSynth::Sound::ToFloat(source[i]);
+}
+
+/// @brief Converts contiguous 8-bit sample frames to floating point. The samples are widened 4 at a time with SSE2
+static inline void SoftSynth_ConvertFrames(const int8_t *source, float *destination, uint32_t count) {
+    uint32_t i = 0;
+
+#if defined(SOFTSYNTH_USE_SSE2)
+    auto scale = _mm_set1_ps(SoftSynth::Voice::MULTIPLIER_8_TO_32);
+
+    for (; i + 4 <= count; i += 4) {
+        int32_t packed;
+        std::memcpy(&packed, source + i, sizeof(packed));
+        auto samples = _mm_cvtsi32_si128(packed);
+        samples = _mm_unpacklo_epi8(samples, samples);
+        auto widened = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 24); // sign extend to 32-bit
+        _mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtepi32_ps(widened), scale));
+    }
+#endif
+
+    for (; i < count; i++)
+        destination[i] = SoftSynth::Sound::ToFloat(source[i]);
+}
+
+/// @brief Returns a sound frame for the interpolation filters. Frames past the loop end are taken from the loop start so that looped sounds
+/// are filtered seamlessly. Frames outside the sound are silent
+template <typename T>
+static inline float SoftSynth_GetVoiceFrame(const SoftSynth::Voice &voice, const T *soundData, size_t soundFrames, int64_t index) {
+    if (SoftSynth::Voice::PlayMode::FORWARD_LOOP == voice.mode and index > int64_t(voice.endPosition) and voice.endPosition > voice.startPosition) {
+        // The mixer maps position endPosition + x to startPosition + x
+        index = voice.startPosition + (index - voice.endPosition) % (int64_t(voice.endPosition) - voice.startPosition);
+    } else if (SoftSynth::Voice::PlayMode::PINGPONG_LOOP == voice.mode and voice.endPosition > voice.startPosition) {
+        // The mixer bounces off the loop end, and off the loop start on the way back (before the loop is reached the frames before the loop
+        // start are played as they are)
+        if (index > int64_t(voice.endPosition))
+            index = std::max(2 * int64_t(voice.endPosition) - index, int64_t(voice.startPosition));
+        else if (voice.isReversing and index < int64_t(voice.startPosition))
+            index = std::min(2 * int64_t(voice.startPosition) - index, int64_t(voice.endPosition));
+    }
+
+    return index >= 0 and index < int64_t(soundFrames) ? SoftSynth::Sound::ToFloat(soundData[index]) : 0.0f;
+}
+
+/// @brief Calculates one frame using a multi-frame interpolation filter
+/// @param voice The voice being mixed
+/// @param soundData The sample frames of the sound the voice is playing
+/// @param soundFrames The number of sample frames
+/// @param position The sample frame position
+/// @return The interpolated frame
+template <typename T>
+static inline float SoftSynth_InterpolateFrame(const SoftSynth::Voice &voice, const T *soundData, size_t soundFrames, float position) {
+    auto iPos = int64_t(position);
+    auto fraction = position - float(iPos);
+
+    // Taps that are all inside the sound (and inside the loop when looping) can be read straight from the buffer
+    auto isLooping = SoftSynth::Voice::PlayMode::FORWARD_LOOP == voice.mode or SoftSynth::Voice::PlayMode::PINGPONG_LOOP == voice.mode;
+    auto lastDirect = isLooping ? std::min(int64_t(voice.endPosition), int64_t(soundFrames) - 1) : int64_t(soundFrames) - 1;
+    auto firstDirect = SoftSynth::Voice::PlayMode::PINGPONG_LOOP == voice.mode and voice.isReversing ? int64_t(voice.startPosition) : 0;
+
+    if (SoftSynth::Voice::Interpolation::CUBIC == voice.interpolation) {
+        float x[4];
+
+        if (iPos - 1 >= firstDirect and iPos + 2 <= lastDirect) {
+            SoftSynth_ConvertFrames(soundData + iPos - 1, x, 4);
+        } else {
+            for (auto i = 0; i < 4; i++)
+                x[i] = SoftSynth_GetVoiceFrame(voice, soundData, soundFrames, iPos - 1 + i);
+        }
+
+        // Catmull-Rom spline through x[1] and x[2]
+        auto a = 0.5f * (x[3] - x[0]) + 1.5f * (x[1] - x[2]);
+        auto b = x[0] - 2.5f * x[1] + 2.0f * x[2] - 0.5f * x[3];
+        auto c = 0.5f * (x[2] - x[0]);
+
+        return ((a * fraction + b) * fraction + c) * fraction + x[1];
+    }
+
+    // Interpolation::SINC
+    constexpr auto TAPS = SoftSynth::SincTable::TAPS;
+    constexpr auto TAPS_BEFORE = int64_t(SoftSynth::SincTable::TAPS_BEFORE);
+
+    auto &taps = SoftSynth::SincTable::Get().taps[uint32_t(fraction * SoftSynth::SincTable::PHASES) & (SoftSynth::SincTable::PHASES - 1)];
+    auto first = iPos - TAPS_BEFORE;
+    float x[TAPS];
+
+    if (first >= firstDirect and first + int64_t(TAPS) - 1 <= lastDirect) {
+        SoftSynth_ConvertFrames(soundData + first, x, TAPS);
+    } else {
+        for (uint32_t i = 0; i < TAPS; i++)
+            x[i] = SoftSynth_GetVoiceFrame(voice, soundData, soundFrames, first + i);
+    }
+
+    auto sum = 0.0f;
+    for (uint32_t i = 0; i < TAPS; i++)
+        sum += x[i] * taps[i];
+
+    return sum;
+}
+
+/// @brief Mixes one voice. The voice is rendered in spans that do not cross the loop / end boundary. The sample positions of a span are
+/// stepped exactly like the per-frame mixer did, then the frames are fetched (and filtered if needed) and handed to a kernel that does the
+/// rest in bulk
+/// @param voice The voice to mix
+/// @param soundData The sample frames of the sound the voice is playing (in the sound's storage format)
+/// @param soundFrames The number of sample frames
+/// @param output Stereo interleaved output buffer
+/// @param send Stereo interleaved reverb send buffer (nullptr if the voice is not sent to the reverb)
+/// @param frames The number of frames to mix
+/// @param isBitExact Use the scalar kernel
+template <typename T>
+static inline void SoftSynth_MixVoice(SoftSynth::Voice &voice, const T *soundData, size_t soundFrames, float *output, float *send, uint32_t frames,
+                                      bool isBitExact) {
+    float positions[SoftSynth::MIX_BLOCK_FRAMES];
+    float oldFrames[SoftSynth::MIX_BLOCK_FRAMES];
+    float newFrames[SoftSynth::MIX_BLOCK_FRAMES];
+    float fractions[SoftSynth::MIX_BLOCK_FRAMES];
+
+    auto startPosition = float(voice.startPosition);
+    auto endPosition = float(voice.endPosition);
+
+    while (frames) {
+        // Check if we crossed either end of the sound and take action based on the playback mode. The direction only changes here, so every
+        // frame of a span is played in the same direction
+        if (voice.isReversing) {
+            if (voice.position < voice.startPosition) {
+                if (SoftSynth::Voice::PlayMode::PINGPONG_LOOP == voice.mode) {
+                    // Bounce off the loop start and preserve fractional position. The last frame index is moved to where it would be in a
+                    // mirrored copy of the loop, so that the next frame is fetched exactly as a forward loop over that copy would
+                    voice.position = std::min(startPosition + (startPosition - voice.position), endPosition);
+                    voice.iPosition = 2 * voice.endPosition - voice.iPosition;
+                    voice.isReversing = false;
+                } else {
+                    voice.sound = SoftSynth::Voice::NO_SOUND;
+                    return;
+                }
+            }
+        } else if (voice.position > voice.endPosition) {
+            if (SoftSynth::Voice::PlayMode::FORWARD_LOOP == voice.mode) {
+                // Reset loop position if we reached the end of the loop and preserve fractional position
+                voice.position = voice.startPosition + (voice.position - voice.endPosition);
+            } else if (SoftSynth::Voice::PlayMode::PINGPONG_LOOP == voice.mode) {
+                // Bounce off the loop end and preserve fractional position (the frame index is mirrored like above)
+                voice.position = std::max(endPosition - (voice.position - endPosition), startPosition);
+                voice.iPosition = 2 * voice.endPosition - voice.iPosition;
+                voice.isReversing = true;
+            } else {
+                // For non-looping sound simply stop playing if we reached the end
+                voice.sound = SoftSynth::Voice::NO_SOUND; // just invalidate the sound leaving other properties intact
+                return;                                   // we have no more samples to mix for this voice
+            }
+        }
+
+        // Spans stop where a ramp ends, so every frame of a span is either ramping or not
+        auto count = std::min(frames, SoftSynth::MIX_BLOCK_FRAMES);
+        if (voice.mixGainFrames)
+            count = std::min(count, voice.mixGainFrames);
+        if (voice.pitchFrames)
+            count = std::min(count, voice.pitchFrames);
+
+        // Step through the positions. The first frame is always mixed (as above, the loop check is done once per frame). The pitch step is
+        // zero unless a frequency ramp is running
+        auto position = voice.position;
+        auto pitch = voice.pitch;
+        auto direction = voice.isReversing ? -1.0f : 1.0f;
+        auto stepPositions = [&](uint32_t stepFrames) {
+            position = voice.position;
+            pitch = voice.pitch;
+
+            for (uint32_t i = 0; i < stepFrames; i++) {
+                positions[i] = position;
+                position += direction * pitch;
+                pitch += voice.pitchStep;
+            }
+        };
+
+        stepPositions(count);
+
+        // Positions only move one way in a span, so the span ends at the first one that is past the boundary
+        if (voice.isReversing) {
+            if (positions[count - 1] < startPosition) {
+                count = uint32_t(std::upper_bound(positions + 1, positions + count, startPosition, std::greater<float>()) - positions);
+                stepPositions(count);
+            }
+        } else if (positions[count - 1] > endPosition) {
+            count = uint32_t(std::upper_bound(positions + 1, positions + count, endPosition) - positions);
+            stepPositions(count);
+        }
+
+        // Fetch the sample frames. Going backwards, the frame at the next integer position down is fetched, so that the voice lags one frame
+        // behind in either direction and a pingpong loop sounds the same as a forward loop over a mirrored copy of the loop
+        if (voice.isReversing) {
+            for (uint32_t i = 0; i < count; i++) {
+                auto iPos = uint32_t(std::ceil(positions[i]));
+                if (iPos != voice.iPosition) {
+                    voice.oldFrame = voice.frame;
+                    voice.iPosition = iPos;
+
+                    if (iPos < soundFrames) {
+                        voice.frame = SoftSynth::Sound::ToFloat(soundData[iPos]);
+                    }
+                }
+
+                oldFrames[i] = voice.oldFrame;
+                newFrames[i] = voice.frame;
+                fractions[i] = float(voice.iPosition) - positions[i];
+            }
+        } else {
+            for (uint32_t i = 0; i < count; i++) {
+                auto iPos = uint32_t(positions[i]);
+                if (iPos != voice.iPosition) // only fetch a new frame if we have really crossed over to the new one
+                {
+                    voice.oldFrame = voice.frame; // save the current frame first
+                    voice.iPosition = iPos;       // save the new integer position
+
+                    if (iPos < soundFrames) // this protects us from segfaults
+                    {
+                        voice.frame = SoftSynth::Sound::ToFloat(soundData[iPos]);
+                    }
+                }
+
+                oldFrames[i] = voice.oldFrame;
+                newFrames[i] = voice.frame;
+                fractions[i] = positions[i] - voice.iPosition;
+            }
+        }
+
+        // The kernels do linear interpolation. For the other modes the frame is worked out here and the kernel interpolates between two copies
+        if (SoftSynth::Voice::Interpolation::NEAREST == voice.interpolation) {
+            std::copy_n(newFrames, count, oldFrames);
+        } else if (SoftSynth::Voice::Interpolation::LINEAR != voice.interpolation) {
+            for (uint32_t i = 0; i < count; i++)
+                oldFrames[i] = newFrames[i] = SoftSynth_InterpolateFrame(voice, soundData, soundFrames, positions[i]);
+        }
+
+        voice.position = position;
+        voice.pitch = pitch;
+
+        if (voice.pitchFrames) {
+            voice.pitchFrames -= count;
+            if (!voice.pitchFrames)
+                voice.SetPitch(voice.targetPitch, 0); // land exactly on the target
+        }
+
+        // Lerp, volume, mixing and panning. The reverb send reuses the frames worked out above and only runs the kernel again
+        if (voice.mixGainFrames) {
+            if (isBitExact) {
+                SoftSynth_MixBlockRampScalar(output, oldFrames, newFrames, fractions, count, voice.mixGain, voice.mixGainStep);
+            } else {
+                SoftSynth_MixBlockRampSIMD(output, oldFrames, newFrames, fractions, count, voice.mixGain, voice.mixGainStep);
+            }
+
+            if (send) {
+                std::pair<float, float> sendGain = {voice.mixGain.first * voice.reverbSend, voice.mixGain.second * voice.reverbSend};
+                std::pair<float, float> sendStep = {voice.mixGainStep.first * voice.reverbSend, voice.mixGainStep.second * voice.reverbSend};
+                if (isBitExact) {
+                    SoftSynth_MixBlockRampScalar(send, oldFrames, newFrames, fractions, count, sendGain, sendStep);
+                } else {
+                    SoftSynth_MixBlockRampSIMD(send, oldFrames, newFrames, fractions, count, sendGain, sendStep);
+                }
+            }
+
+            voice.mixGainFrames -= count;
+            if (voice.mixGainFrames) {
+                voice.mixGain.first += float(count) * voice.mixGainStep.first;
+                voice.mixGain.second += float(count) * voice.mixGainStep.second;
+            } else {
+                voice.SetMixGain(0); // land exactly on the target
+            }
+        } else if (isBitExact) {
+            SoftSynth_MixBlockScalar(output, oldFrames, newFrames, fractions, count, voice.volume, voice.gain);
+            if (send)
+                SoftSynth_MixBlockScalar(send, oldFrames, newFrames, fractions, count, voice.volume * voice.reverbSend, voice.gain);
+        } else {
+            SoftSynth_MixBlockSIMD(output, oldFrames, newFrames, fractions, count, voice.volume, voice.gain);
+            if (send)
+                SoftSynth_MixBlockSIMD(send, oldFrames, newFrames, fractions, count, voice.volume * voice.reverbSend, voice.gain);
+        }
+
+        output += count * 2;
+        if (send)
+            send += count * 2;
+        frames -= count;
+    }
+}
+
+/// @brief Master stage. Scales the output (which holds the main bus) and every other bus by its gain, adds them up, applies the global volume
+/// and clips the result to -1.0 - 1.0. All of this happens in a single pass over the output
+/// @param output Stereo interleaved output that already holds the main bus
+/// @param outputGain The main bus gain
+/// @param inputs The other bus buffers
+/// @param gains The gain for each of inputs
+/// @param count The number of inputs
+/// @param volume The global volume
+/// @param samples The number of samples (not frames)
+static inline void SoftSynth_MixMaster(float *output, float outputGain, const float *const *inputs, const float *gains, size_t count, float volume,
+                                       size_t samples) {
+    size_t i = 0;
+
+#if defined(SOFTSYNTH_USE_AVX)
+    {
+        auto g = _mm256_set1_ps(outputGain), v = _mm256_set1_ps(volume);
+        auto lo = _mm256_set1_ps(-1.0f), hi = _mm256_set1_ps(1.0f);
+
+        for (; i + 8 <= samples; i += 8) {
+            auto sum = _mm256_mul_ps(_mm256_loadu_ps(output + i), g);
+            for (size_t b = 0; b < count; b++)
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(inputs[b] + i), _mm256_set1_ps(gains[b])));
+            _mm256_storeu_ps(output + i, _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(sum, v), lo), hi));
+        }
+    }
+#endif
+
+#if defined(SOFTSYNTH_USE_SSE2)
+    {
+        auto g = _mm_set1_ps(outputGain), v = _mm_set1_ps(volume);
+        auto lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(1.0f);
+
+        for (; i + 4 <= samples; i += 4) {
+            auto sum = _mm_mul_ps(_mm_loadu_ps(output + i), g);
+            for (size_t b = 0; b < count; b++)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(inputs[b] + i), _mm_set1_ps(gains[b])));
+            _mm_storeu_ps(output + i, _mm_min_ps(_mm_max_ps(_mm_mul_ps(sum, v), lo), hi));
+        }
+    }
+#endif
+
+    for (; i < samples; i++) {
+        auto sum = output[i] * outputGain;
+        for (size_t b = 0; b < count; b++)
+            sum += inputs[b][i] * gains[b];
+        output[i] = std::clamp(sum * volume, -1.0f, 1.0f);
+    }
+}
+
+/// @brief Mixes every threads-th voice starting at first
+/// @param targets The buffer for each bus that the voices are mixed into
+/// @param offset The sample offset into the buffers where mixing starts
+/// @return The number of voices that were active
+static inline uint32_t SoftSynth_MixVoices(float *const *targets, size_t offset, uint32_t frames, size_t first, size_t threads) {
+    uint32_t activeVoices = 0;
 
     // We will iterate through each channel completely rather than jumping from channel to channel
     // We are doing this because it is easier for the CPU to access adjacent memory rather than something far away
-    for (size_t v = 0; v < voiceCount; v++) {
+    for (auto v = first; v < g_SoftSynth->voices.size(); v += threads) {
         // Get the current voice we need to work with
         auto &voice = g_SoftSynth->voices[v];
 
-        // Only proceed if we have a valid sound number (>= 0)
-        if (voice.sound >= 0) {
-            // Get the sample data we need to work with
-            auto &soundData = g_SoftSynth->sounds[voice.sound];
-
-            // Cache the total sound frames as we need to use this frequently inside the loop
-            auto soundFrames = soundData.size();
-
-            // Only proceed if we have something to play in the sound
-            if (soundFrames > 0) {
-                // Increment the active voices
-                ++g_SoftSynth->activeVoices;
-
-                // Copy the buffer address
-                auto output = buffer;
-
-                //  Next we go through the channel sample data and mix it to our mixer buffer
-                for (uint32_t s = 0; s < frames; s++) {
-                    // Check if we crossed the end of the sound and take action based on the playback mode
-                    if (voice.position > voice.endPosition) {
-                        if (SoftSynth::Voice::PlayMode::FORWARD_LOOP == voice.mode) {
-                            // Reset loop position if we reached the end of the loop and preserve fractional position
-                            voice.position = voice.startPosition + (voice.position - voice.endPosition);
-                        } else {
-                            // For non-looping sound simply stop playing if we reached the end
-                            voice.sound = SoftSynth::Voice::NO_SOUND; // just invalidate the sound leaving other properties intact
-                            break;                                    // exit the mixing loop as we have no more samples to mix for this channel
-                        }
-                    }
+        // Only proceed if we have a valid sound number (>= 0) and something to play in the sound
+        if (voice.sound >= 0 and !g_SoftSynth->sounds[voice.sound].empty()) {
+            // Increment the active voices
+            ++activeVoices;
 
-                    // Fetch the sample frame to mix
-                    auto iPos = uint32_t(voice.position);
-                    if (iPos != voice.iPosition) // only fetch a new frame if we have really crossed over to the new one
-                    {
-                        voice.oldFrame = voice.frame; // save the current frame first
-                        voice.iPosition = iPos;       // save the new integer position
+            auto &sound = g_SoftSynth->sounds[voice.sound];
+            auto buffer = targets[voice.bus] + offset;
+            auto send = g_SoftSynth->isReverb and voice.reverbSend > 0.0f ? targets[g_SoftSynth->reverbBus] + offset : nullptr;
 
-                        if (iPos < soundFrames) // this protects us from segfaults
-                        {
-                            voice.frame = soundData[iPos];
-                        }
-                    }
+            switch (sound.bytesPerSample) {
+            case sizeof(int8_t):
+                SoftSynth_MixVoice(voice, sound.GetData<int8_t>(), sound.size(), buffer, send, frames, g_SoftSynth->isBitExact);
+                break;
 
-                    // Lerp & volume
-                    auto outFrame = std::fma(voice.frame - voice.oldFrame, voice.position - voice.iPosition, voice.oldFrame) * voice.volume;
+            case sizeof(int16_t):
+                SoftSynth_MixVoice(voice, sound.GetData<int16_t>(), sound.size(), buffer, send, frames, g_SoftSynth->isBitExact);
+                break;
 
-                    // Move to the next sample position based on the pitch
-                    voice.position += voice.pitch;
+            default:
+                SoftSynth_MixVoice(voice, sound.GetData<float>(), sound.size(), buffer, send, frames, g_SoftSynth->isBitExact);
+            }
+        }
+    }
 
-                    // Mixing and panning
-                    *output = std::fma(outFrame, voice.gain.first, *output); // left channel
-                    ++output;
-                    *output = std::fma(outFrame, voice.gain.second, *output); // right channel
-                    ++output;
+    return activeVoices;
+}
+
+/// @brief Mixes frames into buffer. This is shared by __SoftSynth_Update() and the render thread
+static inline void SoftSynth_Render(float *buffer, uint32_t frames) {
+    auto &buses = g_SoftSynth->buses;
+    auto busCount = buses.size();
+    auto samples = size_t(frames) * 2;
+
+    // Bring in the sources and the pending external buffers. Every bus except the main bus is accumulated in its own buffer
+    for (size_t b = 0; b < busCount; b++) {
+        auto &bus = buses[b];
+
+        if (bus.buffer.size() < samples)
+            bus.buffer.resize(samples, 0.0f);
+
+        auto target = b == SoftSynth::MAIN_BUS ? buffer : bus.buffer.data();
+
+        if (b == SoftSynth::MAIN_BUS and bus.isPending)
+            SoftSynth_AddBuffer(buffer, bus.buffer.data(), samples);
+
+        if (bus.source) {
+            // Sources overwrite what they are given, and may not write anything at all if they are not ready
+            g_SoftSynth->sourceBuffer.assign(samples, 0.0f);
+            bus.source(g_SoftSynth->sourceBuffer.data(), frames);
+            SoftSynth_AddBuffer(target, g_SoftSynth->sourceBuffer.data(), samples);
+        }
+    }
+
+    // Only use as many threads as there are voices to keep them busy. Voices are interleaved between the threads so that voices that are
+    // started together (and are likely to be all active or all idle) are spread out
+    auto threads = g_SoftSynth->workerPool and !g_SoftSynth->isBitExact
+                       ? std::clamp<size_t>(g_SoftSynth->voices.size() / SoftSynth::MIX_VOICES_PER_THREAD, 1, g_SoftSynth->workerPool->GetThreads())
+                       : 1;
+
+    // The calling thread mixes straight into the output and the bus buffers. Other threads get a buffer for each bus
+    auto &targets = g_SoftSynth->busTargets;
+    targets.resize(threads * busCount);
+    targets[SoftSynth::MAIN_BUS] = buffer;
+    for (size_t b = 1; b < busCount; b++)
+        targets[b] = buses[b].buffer.data();
+    for (size_t worker = 1; worker < threads; worker++) {
+        auto &workerBuffer = g_SoftSynth->workerBuffers[worker - 1];
+        workerBuffer.resize(samples * busCount); // cleared by the worker
+        for (size_t b = 0; b < busCount; b++)
+            targets[worker * busCount + b] = workerBuffer.data() + b * samples;
+    }
+
+    auto mixSpan = [&](size_t offset, uint32_t spanFrames, bool isFirst) -> uint32_t {
+        if (threads == 1)
+            return SoftSynth_MixVoices(targets.data(), offset, spanFrames, 0, 1);
+
+        std::atomic<uint32_t> activeVoices(0);
+
+        g_SoftSynth->workerPool->Run([&](uint32_t worker) {
+            if (worker >= threads)
+                return;
+
+            if (worker and isFirst)
+                std::fill(g_SoftSynth->workerBuffers[worker - 1].begin(), g_SoftSynth->workerBuffers[worker - 1].end(), 0.0f);
+
+            activeVoices += SoftSynth_MixVoices(targets.data() + worker * busCount, offset, spanFrames, worker, threads);
+        });
+
+        return activeVoices;
+    };
+
+    // Mix the voices. Queued commands split the update at the frames where they are due. Commands are applied in the order they were queued
+    auto time = g_SoftSynth->renderedFrames.load(std::memory_order_relaxed);
+    uint32_t activeVoices = 0;
+
+    for (uint32_t done = 0; done < frames;) {
+        auto spanFrames = frames - done;
+
+        if (g_SoftSynth->commands) {
+            for (auto command = g_SoftSynth->commands->Front(); command; command = g_SoftSynth->commands->Front()) {
+                if (command->time > time + done) {
+                    spanFrames = uint32_t(std::min<uint64_t>(spanFrames, command->time - (time + done)));
+                    break;
                 }
+
+                SoftSynth_ApplyCommand(*command);
+                g_SoftSynth->commands->Pop();
             }
         }
+
+        activeVoices = std::max(activeVoices, mixSpan(size_t(done) * 2, spanFrames, !done));
+        done += spanFrames;
+    }
+
+    g_SoftSynth->activeVoices = activeVoices;
+
+    // One pass per bus to add the worker buffers
+    for (size_t worker = 1; worker < threads; worker++) {
+        for (size_t b = 0; b < busCount; b++)
+            SoftSynth_AddBuffer(targets[b], targets[worker * busCount + b], samples);
+    }
+
+    // The reverb runs once on everything that was sent to it
+    if (g_SoftSynth->isReverb)
+        verblib_process(g_SoftSynth->reverb.get(), targets[g_SoftSynth->reverbBus], targets[g_SoftSynth->reverbBus], frames);
+
+    // Master stage. Silent buses are left out
+    auto &inputs = g_SoftSynth->masterInputs;
+    auto &gains = g_SoftSynth->masterGains;
+    inputs.clear();
+    gains.clear();
+    for (size_t b = 1; b < busCount; b++) {
+        if (buses[b].gain != 0.0f) {
+            inputs.push_back(buses[b].buffer.data());
+            gains.push_back(buses[b].gain);
+        }
+    }
+
+    SoftSynth_MixMaster(buffer, buses[SoftSynth::MAIN_BUS].gain, inputs.data(), gains.data(), inputs.size(), g_SoftSynth->volume, samples);
+
+    // Leave the bus buffers empty for the next update
+    for (auto &bus : buses) {
+        if (bus.isPending or &bus != &buses[SoftSynth::MAIN_BUS])
+            std::fill(bus.buffer.begin(), bus.buffer.end(), 0.0f);
+        bus.isPending = false;
+    }
+
+    g_SoftSynth->renderedFrames.store(time + frames, std::memory_order_release);
+}
+
+/// @brief This mixes and writes the mixed samples to "buffer". Whatever is already in the buffer is treated as part of the main bus. The buses
+/// are then summed in the master stage that applies the global volume and clips the output. While the render thread is running, mixed frames
+/// must be read using __SoftSynth_ReadRenderBuffer() instead
+/// @param buffer A buffer pointer that will receive the mixed samples (the buffer is not cleared before mixing)
+/// @param frames The number of frames to mix
+inline void __SoftSynth_Update(float *buffer, uint32_t frames) {
+    if (!g_SoftSynth or SoftSynth_IsMixerLocked() or !buffer or !frames) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    SoftSynth_Render(buffer, frames);
+}
+
+/// @brief Mixes ahead into the render ring until the render thread is stopped
+static inline void SoftSynth_RenderThread() {
+    auto &synth = *g_SoftSynth;
+    std::vector<float> block(size_t(synth.renderBlockFrames) * 2);
+    // Check back a few times per block so that the ring never drains by more than a fraction of a block
+    auto idle = std::chrono::microseconds(std::max<uint64_t>(1000, uint64_t(synth.renderBlockFrames) * 250000 / synth.sampleRate));
+
+    while (synth.isRendering.load(std::memory_order_acquire)) {
+        if (synth.renderRing->GetSize() / 2 >= synth.renderLatency) {
+            std::this_thread::sleep_for(idle);
+            continue;
+        }
+
+        std::fill(block.begin(), block.end(), 0.0f);
+        SoftSynth_Render(block.data(), synth.renderBlockFrames);
+        synth.renderRing->Write(block.data(), block.size());
     }
+}
 
-    // Make one more pass to apply global volume
-    // TODO: Move this out to SoftSynth.bas so that we do the global volume only once after mixing FM, reverb and stuff
-    // Or probably we can move this to it's own function that can mix several buffers in one go and apply global volume
-    auto output = buffer;
-    for (uint32_t s = 0; s < frames; s++) {
-        *output *= g_SoftSynth->volume; // left channel
-        ++output;
-        *output *= g_SoftSynth->volume; // right channel
-        ++output;
+/// @brief Returns true if the render thread is running
+qb_bool SoftSynth_IsRenderThreadRunning() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return QB_FALSE;
     }
+
+    return TO_QB_BOOL(g_SoftSynth->isRendering.load(std::memory_order_acquire));
+}
+
+/// @brief Starts a background thread that mixes ahead and keeps a lock-free ring topped up. __SoftSynth_ReadRenderBuffer() then only has to copy
+/// mixed frames out of the ring, so mixing no longer costs the calling thread anything. The thread does not feed the output device: the QB64
+/// sound pipe can only be fed from BASIC, so SoftSynth_Update must still be called often enough to keep the device queue from running dry. The
+/// command queue is enabled (and stays enabled) so that voice changes and sound pokes reach the render thread safely. They land up to latency
+/// frames late. Only voices, sound frames and the global volume may be changed while the thread is running (see SoftSynth_IsMixerLocked). Bus
+/// sources would run on the render thread, so buses must not have a source attached
+/// @param latency The number of frames to keep mixed ahead
+/// @param blockFrames The number of frames to mix at a time. This must not be more than latency
+void SoftSynth_StartRenderThread(uint32_t latency, uint32_t blockFrames) {
+    if (!g_SoftSynth or !blockFrames or blockFrames > latency) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    if (g_SoftSynth->isRendering.load(std::memory_order_acquire))
+        return;
+
+    // Sources are written to by their owners (e.g. OPL3 register writes) on the calling thread
+    if (std::any_of(g_SoftSynth->buses.begin(), g_SoftSynth->buses.end(), [](const SoftSynth::Bus &bus) { return bus.source != nullptr; })) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    SoftSynth_SetCommandQueueEnabled(QB_TRUE);
+
+    // The thread tops up once the ring is below latency, so it can hold up to one block more than that
+    auto capacity = (size_t(latency) + blockFrames) * 2;
+    if (!g_SoftSynth->renderRing or g_SoftSynth->renderRing->GetCapacity() < capacity)
+        g_SoftSynth->renderRing = std::make_unique<SoftSynth::Ring<float>>(capacity);
+
+    g_SoftSynth->renderLatency = latency;
+    g_SoftSynth->renderBlockFrames = blockFrames;
+    g_SoftSynth->renderUnderruns = 0;
+    g_SoftSynth->isRendering.store(true, std::memory_order_release);
+    g_SoftSynth->renderThread = std::thread(SoftSynth_RenderThread);
+}
+
+/// @brief Stops the render thread. Frames that are still in the ring can be read afterwards using __SoftSynth_ReadRenderBuffer() (SoftSynth_Update
+/// plays them before it mixes new frames)
+void SoftSynth_StopRenderThread() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return;
+    }
+
+    if (!g_SoftSynth->isRendering.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    g_SoftSynth->renderThread.join();
+}
+
+/// @brief Copies mixed frames from the render ring to a buffer. Frames that the render thread has not mixed yet are filled with silence and
+/// counted as an underrun
+/// @param buffer A stereo interleaved buffer
+/// @param frames The number of frames to copy
+/// @return The number of frames that were mixed
+uint32_t __SoftSynth_ReadRenderBuffer(float *buffer, uint32_t frames) {
+    if (!g_SoftSynth or !g_SoftSynth->renderRing) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    auto samples = size_t(frames) * 2;
+    auto count = g_SoftSynth->renderRing->Read(buffer, samples);
+    if (count < samples) {
+        std::fill(buffer + count, buffer + samples, 0.0f);
+        g_SoftSynth->renderUnderruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return uint32_t(count / 2);
+}
+
+uint32_t SoftSynth_GetRenderLatency() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return g_SoftSynth->renderLatency;
+}
+
+/// @brief Returns the number of frames that are mixed and waiting in the render ring. This is the latency that the ring currently adds
+uint32_t SoftSynth_GetRenderBufferedFrames() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return g_SoftSynth->renderRing ? uint32_t(g_SoftSynth->renderRing->GetSize() / 2) : 0;
+}
+
+/// @brief Returns the number of __SoftSynth_ReadRenderBuffer() calls that ran out of mixed frames since the render thread was started
+uint64_t SoftSynth_GetRenderUnderruns() {
+    if (!g_SoftSynth) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return g_SoftSynth->renderUnderruns.load(std::memory_order_relaxed);
 }
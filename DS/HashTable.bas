@@ -1,5 +1,5 @@
 '-----------------------------------------------------------------------------------------------------------------------
-' C++17 unordered map wrapper library for QB64-PE
+' C++17 hash table library for QB64-PE
 ' Copyright (c) 2025 Samuel Gomes
 '-----------------------------------------------------------------------------------------------------------------------
 
@@ -7,6 +7,38 @@ $INCLUDEONCE
 
 '$INCLUDE:'HashTable.bi'
 
+FUNCTION HashTable_SaveSnapshot%% (t AS _UNSIGNED _OFFSET, fileName AS STRING)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_SaveSnapshot%% ALIAS "HashTable_SaveSnapshot_" (BYVAL t AS _UNSIGNED _OFFSET, fileName AS STRING)
+    END DECLARE
+
+    HashTable_SaveSnapshot = __HashTable_SaveSnapshot(t, String_ToCStr(fileName))
+END FUNCTION
+
+FUNCTION HashTable_OpenSnapshot~%& (fileName AS STRING)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_OpenSnapshot~%& ALIAS "HashTable_OpenSnapshot_" (fileName AS STRING)
+    END DECLARE
+
+    HashTable_OpenSnapshot = __HashTable_OpenSnapshot(String_ToCStr(fileName))
+END FUNCTION
+
+SUB HashTable_GetStats (t AS _UNSIGNED _OFFSET, stats AS HashTable_StatsType)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_GetStats ALIAS "HashTable_GetStats_" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL stats AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    __HashTable_GetStats t, _OFFSET(stats)
+END SUB
+
+SUB HashTable_NumericGetStats (t AS _UNSIGNED _OFFSET, stats AS HashTable_StatsType)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_NumericGetStats ALIAS "HashTable_NumericGetStats_" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL stats AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    __HashTable_NumericGetStats t, _OFFSET(stats)
+END SUB
+
 FUNCTION HashTable_StringContains%% (t AS _UNSIGNED _OFFSET, k AS STRING)
     DECLARE LIBRARY "HashTable"
         FUNCTION __HashTable_StringContains%% ALIAS "HashTable_StringContains_" (BYVAL t AS _UNSIGNED _OFFSET, k AS STRING, BYVAL kSize AS _UNSIGNED _OFFSET)
@@ -178,3 +210,351 @@ FUNCTION HashTable_StringGetUDT%% (t AS _UNSIGNED _OFFSET, k AS STRING, v AS _UN
 
     HashTable_StringGetUDT = __HashTable_StringGetUDT(t, k, LEN(k), v, vSize)
 END FUNCTION
+
+FUNCTION HashTable_IterGetKeyString$ (t AS _UNSIGNED _OFFSET, c AS _UNSIGNED _OFFSET)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_IterGetKeyString$ ALIAS "HashTable_IterGetKeyString_" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL c AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    HashTable_IterGetKeyString = __HashTable_IterGetKeyString(t, c)
+END FUNCTION
+
+FUNCTION HashTable_IterGetValueString$ (t AS _UNSIGNED _OFFSET, c AS _UNSIGNED _OFFSET)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_IterGetValueString$ ALIAS "HashTable_IterGetValueString_" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL c AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    HashTable_IterGetValueString = __HashTable_IterGetValueString(t, c)
+END FUNCTION
+
+SUB HashTable_SetManyByte (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS _BYTE)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_SetManyByte ALIAS "HashTable_SetMany_<int8_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_SetManyByte t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_GetManyByte~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS _BYTE)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_GetManyByte~%& ALIAS "HashTable_GetMany_<int8_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_GetManyByte = __HashTable_GetManyByte(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_SetManyInteger (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS INTEGER)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_SetManyInteger ALIAS "HashTable_SetMany_<int16_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_SetManyInteger t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_GetManyInteger~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS INTEGER)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_GetManyInteger~%& ALIAS "HashTable_GetMany_<int16_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_GetManyInteger = __HashTable_GetManyInteger(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_SetManyLong (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS LONG)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_SetManyLong ALIAS "HashTable_SetMany_<int32_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_SetManyLong t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_GetManyLong~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS LONG)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_GetManyLong~%& ALIAS "HashTable_GetMany_<int32_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_GetManyLong = __HashTable_GetManyLong(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_SetManyInteger64 (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS _INTEGER64)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_SetManyInteger64 ALIAS "HashTable_SetMany_<int64_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_SetManyInteger64 t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_GetManyInteger64~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS _INTEGER64)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_GetManyInteger64~%& ALIAS "HashTable_GetMany_<int64_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_GetManyInteger64 = __HashTable_GetManyInteger64(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_SetManySingle (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS SINGLE)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_SetManySingle ALIAS "HashTable_SetMany_<float>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_SetManySingle t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_GetManySingle~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS SINGLE)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_GetManySingle~%& ALIAS "HashTable_GetMany_<float>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_GetManySingle = __HashTable_GetManySingle(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_SetManyDouble (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS DOUBLE)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_SetManyDouble ALIAS "HashTable_SetMany_<double>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_SetManyDouble t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_GetManyDouble~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS DOUBLE)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_GetManyDouble~%& ALIAS "HashTable_GetMany_<double>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_GetManyDouble = __HashTable_GetManyDouble(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_SetManyOffset (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS _UNSIGNED _OFFSET)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_SetManyOffset ALIAS "HashTable_SetMany_<uintptr_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_SetManyOffset t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_GetManyOffset~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET, v() AS _UNSIGNED _OFFSET)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_GetManyOffset~%& ALIAS "HashTable_GetMany_<uintptr_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_GetManyOffset = __HashTable_GetManyOffset(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+FUNCTION HashTable_RemoveMany~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_RemoveMany~%& ALIAS "HashTable_RemoveMany_" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    HashTable_RemoveMany = __HashTable_RemoveMany(t, _OFFSET(k(LBOUND(k))), UBOUND(k) - LBOUND(k) + 1)
+END FUNCTION
+
+SUB HashTable_RemoveMany (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _OFFSET)
+    DIM ignored AS _UNSIGNED _OFFSET: ignored = HashTable_RemoveMany(t, k())
+END SUB
+
+SUB HashTable_NumericSetManyByte (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS _BYTE)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_NumericSetManyByte ALIAS "HashTable_NumericSetMany_<int8_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_NumericSetManyByte t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_NumericGetManyByte~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS _BYTE)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_NumericGetManyByte~%& ALIAS "HashTable_NumericGetMany_<int8_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_NumericGetManyByte = __HashTable_NumericGetManyByte(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_NumericSetManyInteger (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS INTEGER)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_NumericSetManyInteger ALIAS "HashTable_NumericSetMany_<int16_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_NumericSetManyInteger t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_NumericGetManyInteger~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS INTEGER)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_NumericGetManyInteger~%& ALIAS "HashTable_NumericGetMany_<int16_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_NumericGetManyInteger = __HashTable_NumericGetManyInteger(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_NumericSetManyLong (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS LONG)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_NumericSetManyLong ALIAS "HashTable_NumericSetMany_<int32_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_NumericSetManyLong t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_NumericGetManyLong~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS LONG)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_NumericGetManyLong~%& ALIAS "HashTable_NumericGetMany_<int32_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_NumericGetManyLong = __HashTable_NumericGetManyLong(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_NumericSetManyInteger64 (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS _INTEGER64)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_NumericSetManyInteger64 ALIAS "HashTable_NumericSetMany_<int64_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_NumericSetManyInteger64 t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_NumericGetManyInteger64~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS _INTEGER64)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_NumericGetManyInteger64~%& ALIAS "HashTable_NumericGetMany_<int64_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_NumericGetManyInteger64 = __HashTable_NumericGetManyInteger64(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_NumericSetManySingle (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS SINGLE)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_NumericSetManySingle ALIAS "HashTable_NumericSetMany_<float>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_NumericSetManySingle t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_NumericGetManySingle~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS SINGLE)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_NumericGetManySingle~%& ALIAS "HashTable_NumericGetMany_<float>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_NumericGetManySingle = __HashTable_NumericGetManySingle(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_NumericSetManyDouble (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS DOUBLE)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_NumericSetManyDouble ALIAS "HashTable_NumericSetMany_<double>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_NumericSetManyDouble t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_NumericGetManyDouble~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS DOUBLE)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_NumericGetManyDouble~%& ALIAS "HashTable_NumericGetMany_<double>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_NumericGetManyDouble = __HashTable_NumericGetManyDouble(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+SUB HashTable_NumericSetManyOffset (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS _UNSIGNED _OFFSET)
+    DECLARE LIBRARY "HashTable"
+        SUB __HashTable_NumericSetManyOffset ALIAS "HashTable_NumericSetMany_<uintptr_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    __HashTable_NumericSetManyOffset t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count
+END SUB
+
+FUNCTION HashTable_NumericGetManyOffset~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64, v() AS _UNSIGNED _OFFSET)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_NumericGetManyOffset~%& ALIAS "HashTable_NumericGetMany_<uintptr_t>" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL v AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(k) - LBOUND(k) + 1
+    IF UBOUND(v) - LBOUND(v) + 1 < count THEN ERROR _ERR_ILLEGAL_FUNCTION_CALL
+
+    HashTable_NumericGetManyOffset = __HashTable_NumericGetManyOffset(t, _OFFSET(k(LBOUND(k))), _OFFSET(v(LBOUND(v))), count)
+END FUNCTION
+
+FUNCTION HashTable_NumericRemoveMany~%& (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64)
+    DECLARE LIBRARY "HashTable"
+        FUNCTION __HashTable_NumericRemoveMany~%& ALIAS "HashTable_NumericRemoveMany_" (BYVAL t AS _UNSIGNED _OFFSET, BYVAL k AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET)
+    END DECLARE
+
+    HashTable_NumericRemoveMany = __HashTable_NumericRemoveMany(t, _OFFSET(k(LBOUND(k))), UBOUND(k) - LBOUND(k) + 1)
+END FUNCTION
+
+SUB HashTable_NumericRemoveMany (t AS _UNSIGNED _OFFSET, k() AS _UNSIGNED _INTEGER64)
+    DIM ignored AS _UNSIGNED _OFFSET: ignored = HashTable_NumericRemoveMany(t, k())
+END SUB
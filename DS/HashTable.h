@@ -1,5 +1,5 @@
 //----------------------------------------------------------------------------------------------------------------------
-// C++17 unordered map wrapper library for QB64-PE
+// C++17 hash table library for QB64-PE
 // Copyright (c) 2025 Samuel Gomes
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -8,21 +8,1602 @@
 #include "../Core/Common.h"
 #include "../Core/String.h"
 #include "../Core/Types.h"
+#include "../Debug/Debug.h"
+#include "../IO/MappedFile.h"
+#include "MemFile.h"
 #include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HASHTABLE_USE_SSE2 1
+#endif
 
 // Aliases for clarity
 using HashTable_BinaryBlob_ = std::string;
+using HashTable_Key_ = std::string_view;
+using HashTable_Value_ = std::string_view;
 
-// Backing container
-using HashTable_ = std::unordered_map<HashTable_BinaryBlob_, HashTable_BinaryBlob_>;
+/// @brief Reads an unaligned 32-bit value.
+inline uint64_t HashTable_Read32_(const uint8_t *p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/// @brief Reads an unaligned 64-bit value.
+inline uint64_t HashTable_Read64_(const uint8_t *p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/// @brief Multiplies two 64-bit values and folds the 128-bit product into 64-bits.
+inline uint64_t HashTable_Mix_(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    auto r = static_cast<__uint128_t>(a) * b;
+    return uint64_t(r) ^ uint64_t(r >> 64);
+#else
+    uint64_t ha = a >> 32, la = uint32_t(a), hb = b >> 32, lb = uint32_t(b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+    auto c = uint64_t(t < rl);
+    auto lo = t + (rm1 << 32);
+    c += lo < t;
+    auto hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    return lo ^ hi;
+#endif
+}
+
+/// @brief Hashes a byte string. This is a wyhash style hash that is fast for both short and long keys. Unlike std::hash, the result is identical across
+/// compilers and standard libraries.
+/// @param key The key to hash.
+/// @return A 64-bit hash value.
+inline uint64_t HashTable_Hash_(HashTable_Key_ key) {
+    static constexpr uint64_t P0 = 0xa0761d6478bd642full, P1 = 0xe7037ed1a0b428dbull, P2 = 0x8ebc6af09c88c6e3ull;
+
+    auto p = reinterpret_cast<const uint8_t *>(key.data());
+    auto len = key.size();
+    auto seed = HashTable_Mix_(P0, P1);
+    uint64_t a, b;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            auto shift = (len >> 3) << 2;
+            a = (HashTable_Read32_(p) << 32) | HashTable_Read32_(p + shift);
+            b = (HashTable_Read32_(p + len - 4) << 32) | HashTable_Read32_(p + len - 4 - shift);
+        } else if (len > 0) {
+            a = (uint64_t(p[0]) << 16) | (uint64_t(p[len >> 1]) << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        auto i = len;
+        while (i > 16) {
+            seed = HashTable_Mix_(HashTable_Read64_(p) ^ P1, HashTable_Read64_(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = HashTable_Read64_(p + i - 16);
+        b = HashTable_Read64_(p + i - 8);
+    }
+
+    return HashTable_Mix_(P2 ^ len, HashTable_Mix_(a ^ P1, b ^ seed));
+}
+
+/// @brief Returns the index of the lowest set bit in a non-zero bitmask.
+inline uint32_t HashTable_LowestBit_(uint32_t mask) {
+    return __builtin_ctz(mask);
+}
+
+/// @brief A group of SwissTable control bytes that are probed in parallel (16 at a time with SSE2).
+struct HashTable_Group_ {
+    static constexpr size_t WIDTH = 16;
+    static constexpr int8_t EMPTY = -128;  // slot has never been used
+    static constexpr int8_t DELETED = -2;  // slot was used and then erased (tombstone)
+    static constexpr int8_t SENTINEL = -1; // never stored; only used for the empty-or-deleted comparison
+
+#ifdef HASHTABLE_USE_SSE2
+    __m128i ctrl;
+
+    explicit HashTable_Group_(const int8_t *pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+    /// @brief Returns a bitmask of the slots whose control byte matches h2.
+    uint32_t Match(int8_t h2) const {
+        return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+
+    /// @brief Returns a bitmask of the empty slots.
+    uint32_t MaskEmpty() const {
+        return Match(EMPTY);
+    }
+
+    /// @brief Returns a bitmask of the empty or deleted slots.
+    uint32_t MaskEmptyOrDeleted() const {
+        return uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(SENTINEL), ctrl)));
+    }
+
+    /// @brief Returns a bitmask of the occupied slots.
+    uint32_t MaskFull() const {
+        return uint32_t(_mm_movemask_epi8(ctrl)) ^ 0xFFFFu;
+    }
+#else
+    const int8_t *ctrl;
+
+    explicit HashTable_Group_(const int8_t *pos) : ctrl(pos) {}
+
+    uint32_t Match(int8_t h2) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < WIDTH; i++) {
+            mask |= uint32_t(ctrl[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    uint32_t MaskEmpty() const {
+        return Match(EMPTY);
+    }
+
+    uint32_t MaskEmptyOrDeleted() const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < WIDTH; i++) {
+            mask |= uint32_t(ctrl[i] < SENTINEL) << i;
+        }
+        return mask;
+    }
+
+    uint32_t MaskFull() const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < WIDTH; i++) {
+            mask |= uint32_t(ctrl[i] >= 0) << i;
+        }
+        return mask;
+    }
+#endif
+};
+
+/// @brief Returns the probe start part of a hash.
+inline size_t HashTable_H1_(uint64_t hash) {
+    return size_t(hash >> 7);
+}
+
+/// @brief Returns the control byte part of a hash.
+inline int8_t HashTable_H2_(uint64_t hash) {
+    return int8_t(hash & 0x7F);
+}
+
+/// @brief Returns the maximum number of entries for a capacity (7/8 load factor).
+inline size_t HashTable_MaxLoad_(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+/// @brief Sets a control byte and keeps the cloned first group (see HashTable_SwissTable_) in sync.
+inline void HashTable_SetCtrl_(int8_t *ctrl, size_t capacity, size_t i, int8_t h) {
+    ctrl[i] = h;
+    if (i < HashTable_Group_::WIDTH) {
+        ctrl[capacity + i] = h;
+    }
+}
+
+/// @brief Walks the probe sequence of hash over a control byte array.
+/// @param ctrl capacity control bytes followed by a copy of the first group.
+/// @param capacity A power of 2 >= HashTable_Group_::WIDTH.
+/// @param hash The hash of the key.
+/// @param isMatch Called with the index of every slot whose control byte matches. Returns true if the slot holds the key.
+/// @return The matching slot index or SIZE_MAX if the key is not present.
+template <typename IsMatch> inline size_t HashTable_ProbeFind_(const int8_t *ctrl, size_t capacity, uint64_t hash, IsMatch isMatch) {
+    auto h2 = HashTable_H2_(hash);
+    auto mask = capacity - 1;
+    auto pos = HashTable_H1_(hash) & mask;
+    size_t step = 0;
+
+    while (true) {
+        HashTable_Group_ group(ctrl + pos);
+
+        for (auto match = group.Match(h2); match; match &= match - 1) {
+            auto i = (pos + HashTable_LowestBit_(match)) & mask;
+            if (isMatch(i)) {
+                return i;
+            }
+        }
+
+        if (group.MaskEmpty()) {
+            return SIZE_MAX;
+        }
+
+        step += HashTable_Group_::WIDTH;
+        pos = (pos + step) & mask;
+    }
+}
+
+/// @brief Finds the first empty or deleted slot in the probe sequence of hash.
+inline size_t HashTable_ProbeFirstNonFull_(const int8_t *ctrl, size_t capacity, uint64_t hash) {
+    auto mask = capacity - 1;
+    auto pos = HashTable_H1_(hash) & mask;
+    size_t step = 0;
+
+    while (true) {
+        auto free = HashTable_Group_(ctrl + pos).MaskEmptyOrDeleted();
+        if (free) {
+            return (pos + HashTable_LowestBit_(free)) & mask;
+        }
+
+        step += HashTable_Group_::WIDTH;
+        pos = (pos + step) & mask;
+    }
+}
+
+/// @brief Returns the number of groups that must be probed to reach slot i from the start of the probe sequence of hash (1 if i is in the
+/// first group). Probe windows never overlap, so the first window that holds i is the one.
+inline size_t HashTable_ProbeLength_(size_t capacity, uint64_t hash, size_t i) {
+    auto mask = capacity - 1;
+    auto pos = HashTable_H1_(hash) & mask;
+    size_t step = 0, length = 1;
+
+    while (((i - pos) & mask) >= HashTable_Group_::WIDTH) {
+        step += HashTable_Group_::WIDTH;
+        pos = (pos + step) & mask;
+        ++length;
+    }
+
+    return length;
+}
+
+/// @brief Finds the first occupied slot at or after i.
+/// @return The slot index or SIZE_MAX if there are no more entries.
+inline size_t HashTable_NextFull_(const int8_t *ctrl, size_t capacity, size_t i) {
+    while (i < capacity) {
+        auto full = HashTable_Group_(ctrl + i).MaskFull();
+        if (full) {
+            i += HashTable_LowestBit_(full);
+            return i < capacity ? i : SIZE_MAX; // anything past capacity is the cloned first group
+        }
+
+        i += HashTable_Group_::WIDTH;
+    }
+
+    return SIZE_MAX;
+}
+
+/// @brief Bump allocator for the out-of-line strings of a table. Memory is carved out of large pages and is never returned piece by piece.
+/// Instead, the owner tracks how much has been released and either resets the arena (on clear) or compacts the live data into a new arena.
+class HashTable_Arena_ {
+  public:
+    static constexpr size_t PAGE_SIZE = 64 * 1024;
+    static constexpr size_t MAX_ALLOCATION = PAGE_SIZE / 16; // anything larger goes straight to the heap so that pages stay well packed
+
+    HashTable_Arena_() : pageUsed(PAGE_SIZE), reserved(0), live(0), wasted(0) {}
+
+    HashTable_Arena_(const HashTable_Arena_ &) = delete;
+    HashTable_Arena_ &operator=(const HashTable_Arena_ &) = delete;
+
+    /// @brief Allocates size (<= MAX_ALLOCATION) bytes.
+    char *Allocate(size_t size) {
+        if (PAGE_SIZE - pageUsed < size) {
+            wasted += PAGE_SIZE - pageUsed; // the tail of the old page is lost
+
+            if (pages.size() > currentPage + 1) {
+                ++currentPage; // reuse a page kept by Reset()
+            } else {
+                pages.emplace_back(new char[PAGE_SIZE]);
+                currentPage = pages.size() - 1;
+                reserved += PAGE_SIZE;
+            }
+
+            pageUsed = 0;
+        }
+
+        auto p = pages[currentPage].get() + pageUsed;
+        pageUsed += size;
+        live += size;
+        return p;
+    }
+
+    /// @brief Marks size bytes of a previous allocation as no longer used.
+    void Release(size_t size) {
+        live -= size;
+        wasted += size;
+    }
+
+    /// @brief Frees every allocation in one go. The first page is kept so that a refill does not need to go back to the allocator.
+    void Reset() {
+        if (pages.size() > 1) {
+            pages.resize(1);
+            reserved = PAGE_SIZE;
+        }
+
+        currentPage = 0;
+        pageUsed = pages.empty() ? PAGE_SIZE : 0;
+        live = 0;
+        wasted = 0;
+    }
+
+    /// @brief Returns true if enough memory has been released that it is worth copying the live data into a new arena.
+    bool NeedsCompaction() const {
+        return wasted > PAGE_SIZE && wasted > live;
+    }
+
+    /// @brief Returns the number of bytes held in pages.
+    size_t GetReserved() const {
+        return reserved;
+    }
+
+    /// @brief Returns the number of bytes in live allocations.
+    size_t GetLive() const {
+        return live;
+    }
+
+    void Swap(HashTable_Arena_ &other) {
+        std::swap(pages, other.pages);
+        std::swap(currentPage, other.currentPage);
+        std::swap(pageUsed, other.pageUsed);
+        std::swap(reserved, other.reserved);
+        std::swap(live, other.live);
+        std::swap(wasted, other.wasted);
+    }
+
+  private:
+    std::vector<std::unique_ptr<char[]>> pages;
+    size_t currentPage = 0;
+    size_t pageUsed; // bytes used in the current page
+    size_t reserved; // total page bytes
+    size_t live;     // bytes in use by live allocations
+    size_t wasted;   // bytes released or lost at page ends since the last reset
+};
+
+/// @brief A byte string that is stored inside its owner when it is small enough (no heap allocation), in an arena when it is medium sized, or
+/// on the heap otherwise. The storage kind follows from the size alone. The data is always NUL terminated so that it can be handed out to
+/// QB64 as a C string.
+class HashTable_InlineBlob_ {
+  public:
+    static constexpr size_t INLINE_CAPACITY = 15; // one byte is reserved for the NUL terminator
+
+    /// @brief Initializes raw (uninitialized) storage with a copy of data.
+    void Construct(const char *data, size_t size, HashTable_Arena_ &arena) {
+        this->size = size;
+
+        char *dst;
+        if (size <= INLINE_CAPACITY) {
+            dst = inlineData;
+        } else if (IsInArena()) {
+            dst = heapData = arena.Allocate(size + 1);
+        } else {
+            dst = heapData = new char[size + 1];
+        }
+
+        std::memcpy(dst, data, size);
+        dst[size] = '\0';
+    }
+
+    /// @brief Frees any heap memory. The object must be constructed again before reuse. Arena memory is not touched; see Release().
+    void Destroy() {
+        if (size > INLINE_CAPACITY && !IsInArena()) {
+            delete[] heapData;
+        }
+    }
+
+    /// @brief Tells the arena that the arena memory (if any) of this blob is about to go away.
+    void Release(HashTable_Arena_ &arena) const {
+        if (size > INLINE_CAPACITY && IsInArena()) {
+            arena.Release(size + 1);
+        }
+    }
+
+    /// @brief Replaces the contents with a copy of data.
+    void Assign(const char *data, size_t size, HashTable_Arena_ &arena) {
+        if (size == this->size) {
+            // Same size; overwrite in place and skip the allocator entirely
+            auto dst = const_cast<char *>(Data());
+            std::memcpy(dst, data, size);
+            return;
+        }
+
+        Release(arena);
+        Destroy();
+        Construct(data, size, arena);
+    }
+
+    /// @brief Moves arena data (if any) into another arena.
+    void Relocate(HashTable_Arena_ &arena) {
+        if (size > INLINE_CAPACITY && IsInArena()) {
+            auto dst = arena.Allocate(size + 1);
+            std::memcpy(dst, heapData, size + 1);
+            heapData = dst;
+        }
+    }
+
+    const char *Data() const {
+        return size <= INLINE_CAPACITY ? inlineData : heapData;
+    }
+
+    size_t Size() const {
+        return size;
+    }
+
+    std::string_view View() const {
+        return std::string_view(Data(), size);
+    }
+
+  private:
+    union {
+        char inlineData[INLINE_CAPACITY + 1];
+        char *heapData;
+    };
+    size_t size;
+
+    bool IsInArena() const {
+        return size < HashTable_Arena_::MAX_ALLOCATION; // size + 1 <= MAX_ALLOCATION
+    }
+};
+
+/// @brief SwissTable style open-addressing hash table core. Metadata (one control byte per slot holding 7 bits of the hash) is kept in a separate dense
+/// array and probed a group at a time, so most misses never touch the slots. The slot layout, hashing and key comparison come from Policy, which must
+/// provide Key, Slot, Hash(), GetKey(), Destroy() and NEEDS_DESTROY. Slots must be trivially relocatable (they are moved using memcpy on rehash).
+/// @tparam Policy The slot policy.
+template <typename Policy> class HashTable_SwissTable_ {
+  public:
+    using Key = typename Policy::Key;
+    using Slot = typename Policy::Slot;
+
+    static constexpr size_t NPOS = SIZE_MAX;
+
+    HashTable_SwissTable_() : ctrl(nullptr), slots(nullptr), capacity(0), size(0), growthLeft(0), totalProbeLength(0), maxProbeLength(0), rehashCount(0) {}
+
+    ~HashTable_SwissTable_() {
+        DestroySlots();
+        Deallocate();
+    }
+
+    HashTable_SwissTable_(const HashTable_SwissTable_ &) = delete;
+    HashTable_SwissTable_ &operator=(const HashTable_SwissTable_ &) = delete;
+
+    size_t GetSize() const {
+        return size;
+    }
+
+    size_t GetCapacity() const {
+        return capacity;
+    }
+
+    /// @brief Returns true if slot i holds an entry.
+    bool IsFull(size_t i) const {
+        return i < capacity && ctrl[i] >= 0;
+    }
+
+    /// @brief Returns the index of the first entry at or after slot i in storage order, or NPOS.
+    size_t NextFull(size_t i) const {
+        return HashTable_NextFull_(ctrl, capacity, i);
+    }
+
+    /// @brief Looks for a key.
+    /// @param key The key.
+    /// @param hash Policy::Hash(key).
+    /// @return The slot index or NPOS if the key is not present.
+    size_t Find(Key key, uint64_t hash) const {
+        if (!capacity) {
+            return NPOS;
+        }
+
+        return HashTable_ProbeFind_(ctrl, capacity, hash, [&](size_t i) { return Policy::GetKey(slots[i]) == key; });
+    }
+
+    /// @brief Looks for a key and claims a new slot for it if it is not present.
+    /// @param key The key.
+    /// @param hash Policy::Hash(key).
+    /// @param inserted Set to true if a new slot was claimed. A new slot is raw memory that the caller must initialize before the next table operation.
+    /// @return The slot index.
+    size_t FindOrPrepareInsert(Key key, uint64_t hash, bool &inserted) {
+        auto i = Find(key, hash);
+        inserted = i == NPOS;
+
+        return inserted ? PrepareInsert(hash) : i;
+    }
+
+    /// @brief Destroys the slot at index i and removes it from the table.
+    /// @param i The slot index.
+    /// @param hash Policy::Hash() of the key in the slot.
+    void EraseAt(size_t i, uint64_t hash) {
+        Policy::Destroy(slots[i]);
+        --size;
+        totalProbeLength -= HashTable_ProbeLength_(capacity, hash, i);
+
+        // If the slot was never part of a full group then no probe sequence could have skipped past it and it can be marked empty instead of deleted
+        auto mask = capacity - 1;
+        auto emptyBefore = HashTable_Group_(ctrl + ((i - HashTable_Group_::WIDTH) & mask)).MaskEmpty();
+        auto emptyAfter = HashTable_Group_(ctrl + i).MaskEmpty();
+        auto wasNeverFull = emptyBefore && emptyAfter &&
+                            (HashTable_LowestBit_(emptyAfter) + (__builtin_clz(emptyBefore) - (32 - HashTable_Group_::WIDTH))) < HashTable_Group_::WIDTH;
+
+        if (wasNeverFull) {
+            SetCtrl(i, HashTable_Group_::EMPTY);
+            ++growthLeft;
+        } else {
+            SetCtrl(i, HashTable_Group_::DELETED);
+        }
+    }
+
+    /// @brief Removes a key.
+    /// @return True if the key was found and removed.
+    bool Remove(Key key, uint64_t hash) {
+        auto i = Find(key, hash);
+        if (i == NPOS) {
+            return false;
+        }
+
+        EraseAt(i, hash);
+        return true;
+    }
+
+    /// @brief Grows the table so that at least count entries fit without further rehashing.
+    void Reserve(size_t count) {
+        if (count <= size + growthLeft) {
+            return;
+        }
+
+        auto newCapacity = std::max(capacity, MIN_CAPACITY);
+        while (HashTable_MaxLoad_(newCapacity) < count) {
+            newCapacity *= 2;
+        }
+
+        Rehash(newCapacity);
+    }
+
+    /// @brief Pulls the first control group and slot of the probe sequence of hash into the cache. Used by batch operations to overlap the cache
+    /// misses of several lookups.
+    void Prefetch(uint64_t hash) const {
+        if (capacity) {
+            auto pos = HashTable_H1_(hash) & (capacity - 1);
+            __builtin_prefetch(ctrl + pos);
+            __builtin_prefetch(slots + pos);
+        }
+    }
+
+    /// @brief Removes all entries. The slot array is kept so that the table can be refilled without reallocating.
+    void Clear() {
+        DestroySlots();
+
+        if (capacity) {
+            std::memset(ctrl, HashTable_Group_::EMPTY, capacity + HashTable_Group_::WIDTH);
+        }
+
+        size = 0;
+        growthLeft = HashTable_MaxLoad_(capacity);
+        totalProbeLength = 0;
+        maxProbeLength = 0;
+    }
+
+    /// @brief Returns the sum of the probe lengths (see HashTable_ProbeLength_()) of all entries.
+    size_t GetTotalProbeLength() const {
+        return totalProbeLength;
+    }
+
+    /// @brief Returns the longest probe length seen since the last rehash or clear. This is a high-water mark; it does not shrink on removal.
+    size_t GetMaxProbeLength() const {
+        return maxProbeLength;
+    }
+
+    /// @brief Returns the number of times the slot array was rebuilt because it was full or on request (growth from empty is not counted).
+    size_t GetRehashCount() const {
+        return rehashCount;
+    }
+
+    /// @brief Returns the number of bytes used by the control bytes and the slot array.
+    size_t GetAllocatedBytes() const {
+        return capacity ? capacity + HashTable_Group_::WIDTH + capacity * sizeof(Slot) : 0;
+    }
+
+    Slot &GetSlot(size_t i) {
+        return slots[i];
+    }
+
+    const Slot &GetSlot(size_t i) const {
+        return slots[i];
+    }
+
+  private:
+    static constexpr size_t MIN_CAPACITY = HashTable_Group_::WIDTH;
+
+    int8_t *ctrl;      // capacity control bytes followed by a copy of the first group so that group loads never wrap
+    Slot *slots;       // capacity slots
+    size_t capacity;   // always 0 or a power of 2 >= MIN_CAPACITY
+    size_t size;             // number of live entries
+    size_t growthLeft;       // number of empty slots that can be filled before we must rehash
+    size_t totalProbeLength; // sum of the probe lengths of all entries
+    size_t maxProbeLength;   // probe length high-water mark
+    size_t rehashCount;      // number of rehashes of a non-empty slot array
+
+    void SetCtrl(size_t i, int8_t h) {
+        HashTable_SetCtrl_(ctrl, capacity, i, h);
+    }
+
+    size_t FindFirstNonFull(uint64_t hash) const {
+        return HashTable_ProbeFirstNonFull_(ctrl, capacity, hash);
+    }
+
+    void AddProbeLength(size_t length) {
+        totalProbeLength += length;
+        maxProbeLength = std::max(maxProbeLength, length);
+    }
+
+    /// @brief Claims a slot for a new key, growing or cleaning up the table if needed.
+    size_t PrepareInsert(uint64_t hash) {
+        if (!capacity) {
+            Rehash(MIN_CAPACITY);
+        }
+
+        auto i = FindFirstNonFull(hash);
+
+        if (!growthLeft && ctrl[i] != HashTable_Group_::DELETED) {
+            // If at least half of the non-empty slots are tombstones, then rehashing in place is enough; else double the capacity
+            Rehash(size * 2 <= HashTable_MaxLoad_(capacity) ? capacity : capacity * 2);
+            i = FindFirstNonFull(hash);
+        }
+
+        if (ctrl[i] == HashTable_Group_::EMPTY) {
+            --growthLeft;
+        }
+
+        SetCtrl(i, HashTable_H2_(hash));
+        ++size;
+        AddProbeLength(HashTable_ProbeLength_(capacity, hash, i));
+
+        return i;
+    }
+
+    /// @brief Moves every entry into freshly allocated arrays with newCapacity slots. This also discards all tombstones.
+    void Rehash(size_t newCapacity) {
+        auto oldCtrl = ctrl;
+        auto oldSlots = slots;
+        auto oldCapacity = capacity;
+
+        capacity = newCapacity;
+        ctrl = new int8_t[capacity + HashTable_Group_::WIDTH];
+        slots = static_cast<Slot *>(::operator new(sizeof(Slot) * capacity));
+        std::memset(ctrl, HashTable_Group_::EMPTY, capacity + HashTable_Group_::WIDTH);
+        growthLeft = HashTable_MaxLoad_(capacity) - size;
+        totalProbeLength = 0;
+        maxProbeLength = 0;
+
+        if (oldCapacity) {
+            ++rehashCount;
+        }
+
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (oldCtrl[i] >= 0) {
+                auto hash = Policy::Hash(Policy::GetKey(oldSlots[i]));
+                auto j = FindFirstNonFull(hash);
+                SetCtrl(j, HashTable_H2_(hash));
+                AddProbeLength(HashTable_ProbeLength_(capacity, hash, j));
+                std::memcpy(static_cast<void *>(&slots[j]), &oldSlots[i], sizeof(Slot));
+            }
+        }
+
+        delete[] oldCtrl;
+        ::operator delete(oldSlots);
+    }
+
+    void DestroySlots() {
+        if constexpr (Policy::NEEDS_DESTROY) {
+            for (size_t i = 0; i < capacity; i++) {
+                if (ctrl[i] >= 0) {
+                    Policy::Destroy(slots[i]);
+                }
+            }
+        }
+    }
+
+    void Deallocate() {
+        delete[] ctrl;
+        ::operator delete(slots);
+        ctrl = nullptr;
+        slots = nullptr;
+        capacity = 0;
+    }
+};
+
+/// @brief Slot policy for byte string keys and values. Keys and values are stored inline in the slot array when they are small (e.g. all numeric keys
+/// and values), so a typical entry costs no heap allocations at all. Destroy() only frees heap strings; arena strings belong to HashTable_BlobMap_.
+struct HashTable_BlobSlotPolicy_ {
+    using Key = HashTable_Key_;
+
+    struct Slot {
+        HashTable_InlineBlob_ key;
+        HashTable_InlineBlob_ value;
+    };
+
+    static constexpr bool NEEDS_DESTROY = true;
+
+    static uint64_t Hash(Key key) {
+        return HashTable_Hash_(key);
+    }
+
+    static Key GetKey(const Slot &slot) {
+        return slot.key.View();
+    }
+
+    static void Destroy(Slot &slot) {
+        slot.key.Destroy();
+        slot.value.Destroy();
+    }
+};
+
+/// @brief Slot policy for 64-bit integer keys with a fixed 64-bit value. Slots are plain 16 byte PODs.
+struct HashTable_NumericSlotPolicy_ {
+    using Key = uint64_t;
+
+    struct Slot {
+        uint64_t key;
+        uint64_t value; // any QB64 numeric type, stored in the low bytes
+    };
+
+    static constexpr bool NEEDS_DESTROY = false;
+
+    static uint64_t Hash(Key key) {
+        return HashTable_Mix_(key ^ 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull);
+    }
+
+    static Key GetKey(const Slot &slot) {
+        return slot.key;
+    }
+
+    static void Destroy(Slot &) {}
+};
+
+using HashTable_FlatMap_ = HashTable_SwissTable_<HashTable_BlobSlotPolicy_>;
+using HashTable_NumericMap_ = HashTable_SwissTable_<HashTable_NumericSlotPolicy_>;
+
+/// @brief Hash table statistics. This must be kept in sync with HashTable_StatsType in HashTable.bi.
+struct HashTable_Stats_ {
+    uint64_t size;          // number of entries
+    uint64_t slots;         // number of slots (flat engines) or buckets (node engine)
+    uint64_t keyBytes;      // total length of all keys
+    uint64_t valueBytes;    // total length of all values
+    uint64_t metadataBytes; // everything else the engine allocates (control bytes, slots, free arena space, nodes and buckets)
+    float loadFactor;       // size / slots
+    float meanProbeLength;  // mean number of groups probed (flat engines) or mean length of non-empty chains (node engine)
+    uint32_t maxProbeLength;
+    uint32_t rehashCount; // number of times a non-empty table was rehashed
+};
+
+static_assert(sizeof(HashTable_Stats_) == 56, "HashTable_Stats_ must match HashTable_StatsType");
+
+/// @brief Flat table of byte string keys and values. Strings that do not fit in a slot are packed into an arena owned by the map, so filling
+/// the table mostly costs one allocation per arena page and clearing it frees everything in bulk. When more than half of the arena is dead
+/// (removed or replaced strings), the live strings are copied into a fresh arena.
+class HashTable_BlobMap_ {
+  public:
+    HashTable_BlobMap_() = default;
+    HashTable_BlobMap_(const HashTable_BlobMap_ &) = delete;
+    HashTable_BlobMap_ &operator=(const HashTable_BlobMap_ &) = delete;
+
+    size_t GetSize() const {
+        return table.GetSize();
+    }
+
+    const HashTable_FlatMap_ &GetTable() const {
+        return table;
+    }
+
+    const HashTable_Arena_ &GetArena() const {
+        return arena;
+    }
+
+    /// @brief Looks up a key.
+    /// @param value Receives the value if the key is found. This stays valid until the next change to the map.
+    /// @return True if the key was found.
+    bool Find(HashTable_Key_ key, uint64_t hash, HashTable_Value_ &value) const {
+        auto i = table.Find(key, hash);
+        if (i == HashTable_FlatMap_::NPOS) {
+            return false;
+        }
+
+        value = table.GetSlot(i).value.View();
+        return true;
+    }
+
+    void Set(HashTable_Key_ key, HashTable_Value_ value, uint64_t hash) {
+        bool inserted;
+        auto &slot = table.GetSlot(table.FindOrPrepareInsert(key, hash, inserted));
+
+        if (inserted) {
+            slot.key.Construct(key.data(), key.size(), arena);
+            slot.value.Construct(value.data(), value.size(), arena);
+            keyBytes += key.size();
+        } else {
+            valueBytes -= slot.value.Size();
+            slot.value.Assign(value.data(), value.size(), arena);
+            CompactIfNeeded();
+        }
+
+        valueBytes += value.size();
+    }
+
+    bool Remove(HashTable_Key_ key, uint64_t hash) {
+        auto i = table.Find(key, hash);
+        if (i == HashTable_FlatMap_::NPOS) {
+            return false;
+        }
+
+        keyBytes -= table.GetSlot(i).key.Size();
+        valueBytes -= table.GetSlot(i).value.Size();
+        table.GetSlot(i).key.Release(arena);
+        table.GetSlot(i).value.Release(arena);
+        table.EraseAt(i, hash);
+        CompactIfNeeded();
+
+        return true;
+    }
+
+    void Clear() {
+        table.Clear();
+        arena.Reset();
+        keyBytes = valueBytes = 0;
+    }
+
+    /// @brief Adds the statistics of this map to stats. Probe lengths are accumulated in meanProbeLength as a total; the caller divides.
+    void AccumulateStats(HashTable_Stats_ &stats) const {
+        stats.size += table.GetSize();
+        stats.slots += table.GetCapacity();
+        stats.keyBytes += keyBytes;
+        stats.valueBytes += valueBytes;
+        stats.metadataBytes += table.GetAllocatedBytes() + arena.GetReserved() - arena.GetLive();
+        stats.meanProbeLength += float(table.GetTotalProbeLength());
+        stats.maxProbeLength = std::max(stats.maxProbeLength, uint32_t(table.GetMaxProbeLength()));
+        stats.rehashCount += uint32_t(table.GetRehashCount());
+    }
+
+    /// @brief Turns accumulated statistics into final ones.
+    static void FinishStats(HashTable_Stats_ &stats) {
+        stats.loadFactor = stats.slots ? float(stats.size) / float(stats.slots) : 0.0f;
+        stats.meanProbeLength = stats.size ? stats.meanProbeLength / float(stats.size) : 0.0f;
+    }
+
+    void Reserve(size_t count) {
+        table.Reserve(count);
+    }
+
+    void Prefetch(uint64_t hash) const {
+        table.Prefetch(hash);
+    }
+
+  private:
+    HashTable_FlatMap_ table;
+    HashTable_Arena_ arena;
+    size_t keyBytes = 0;
+    size_t valueBytes = 0;
+
+    void CompactIfNeeded() {
+        if (!arena.NeedsCompaction()) {
+            return;
+        }
+
+        HashTable_Arena_ newArena;
+
+        for (auto i = table.NextFull(0); i != HashTable_FlatMap_::NPOS; i = table.NextFull(i + 1)) {
+            table.GetSlot(i).key.Relocate(newArena);
+            table.GetSlot(i).value.Relocate(newArena);
+        }
+
+        arena.Swap(newArena);
+    }
+};
+
+/// @brief The interface that every hash table engine implements. A QB64 hash table handle is a pointer to one of these.
+class HashTable_ {
+  public:
+    /// @brief Storage engines that can be selected using HashTable_CreateEx(). These must be kept in sync with HashTable.bi.
+    enum Backend : int32_t {
+        NODE = 0,   // std::unordered_map (one heap node and two heap strings per entry)
+        FLAT,       // SwissTable style open-addressing table with small keys and values stored inline
+        CONCURRENT, // thread-safe sharded version of FLAT
+    };
+
+    virtual ~HashTable_() = default;
+
+    virtual size_t GetSize() const = 0;
+
+    /// @brief Looks up a key.
+    /// @param key The key.
+    /// @param value Receives the value if the key is found. The data is NUL terminated and stays valid until the table is changed.
+    /// @return True if the key was found.
+    virtual bool Find(HashTable_Key_ key, HashTable_Value_ &value) const = 0;
+
+    virtual void Set(HashTable_Key_ key, HashTable_Value_ value) = 0;
+
+    virtual bool Remove(HashTable_Key_ key) = 0;
+
+    virtual void Clear() = 0;
+
+    /// @brief Makes room for count entries in total. Used by batch inserts.
+    virtual void Reserve(size_t count) = 0;
+
+    /// @brief Hints that key will be accessed soon. Engines that cannot do anything useful with this simply ignore it.
+    virtual void Prefetch(HashTable_Key_ key) const {
+        (void)key;
+    }
+
+    /// @brief Returns the first position at or after position that holds an entry, or NPOS if there are none. Positions follow the storage
+    /// order of the engine and stay valid while entries are only updated.
+    virtual size_t Seek(size_t position) const = 0;
+
+    /// @brief Gets the entry at a position returned by Seek().
+    /// @return False if position does not hold an entry.
+    virtual bool GetAt(size_t position, HashTable_Key_ &key, HashTable_Value_ &value) const = 0;
+
+    static constexpr size_t NPOS = SIZE_MAX;
+
+    /// @brief Fills in statistics. The flat engines keep running counters, so this is cheap enough to call every frame.
+    virtual void GetStats(HashTable_Stats_ &stats) const = 0;
+
+    using Visitor = std::function<void(HashTable_Key_, HashTable_Value_)>;
+
+    /// @brief Calls visitor for every entry. The table must not be modified while this is running.
+    virtual void ForEach(const Visitor &visitor) const = 0;
+
+    /// @brief Number of elements batch operations look ahead when prefetching.
+    static constexpr size_t PREFETCH_DISTANCE = 8;
+};
+
+/// @brief std::unordered_map based engine. This is the original (and default) engine.
+class HashTable_NodeBackend_ : public HashTable_ {
+  public:
+    size_t GetSize() const override {
+        return table.size();
+    }
+
+    bool Find(HashTable_Key_ key, HashTable_Value_ &value) const override {
+        const auto it = table.find(HashTable_BinaryBlob_(key));
+        if (it == table.end()) {
+            return false;
+        }
+
+        value = it->second;
+        return true;
+    }
+
+    void Set(HashTable_Key_ key, HashTable_Value_ value) override {
+        auto bucketCount = table.bucket_count();
+        auto [it, inserted] = table.try_emplace(HashTable_BinaryBlob_(key), value);
+
+        if (inserted) {
+            cursorPosition = NPOS; // a new node may land before the cached one (or the table may rehash)
+            chainStatsValid = false;
+            keyBytes += key.size();
+            rehashCount += bucketCount && table.bucket_count() != bucketCount;
+        } else {
+            valueBytes -= it->second.size();
+            it->second.assign(value);
+        }
+
+        valueBytes += value.size();
+    }
+
+    bool Remove(HashTable_Key_ key) override {
+        auto it = table.find(HashTable_BinaryBlob_(key));
+        if (it == table.end()) {
+            return false;
+        }
+
+        cursorPosition = NPOS;
+        chainStatsValid = false;
+        keyBytes -= it->first.size();
+        valueBytes -= it->second.size();
+        table.erase(it);
+
+        return true;
+    }
+
+    void Clear() override {
+        cursorPosition = NPOS;
+        chainStatsValid = false;
+        keyBytes = valueBytes = 0;
+        table.clear();
+    }
+
+    /// @brief Chain lengths are found by walking the buckets, so they are only recomputed after entries were added or removed.
+    void GetStats(HashTable_Stats_ &stats) const override {
+        if (!chainStatsValid) {
+            size_t usedBuckets = 0;
+            maxChainLength = 0;
+
+            for (size_t b = 0; b < table.bucket_count(); b++) {
+                auto length = table.bucket_size(b);
+                usedBuckets += length != 0;
+                maxChainLength = std::max(maxChainLength, length);
+            }
+
+            meanChainLength = usedBuckets ? float(table.size()) / float(usedBuckets) : 0.0f;
+            chainStatsValid = true;
+        }
+
+        // Each node holds the pair, the next pointer and the cached hash
+        constexpr size_t NODE_SIZE = sizeof(Map::value_type) + sizeof(void *) + sizeof(size_t);
+
+        stats.size = table.size();
+        stats.slots = table.bucket_count();
+        stats.keyBytes = keyBytes;
+        stats.valueBytes = valueBytes;
+        stats.metadataBytes = table.bucket_count() * sizeof(void *) + table.size() * NODE_SIZE;
+        stats.loadFactor = table.load_factor();
+        stats.meanProbeLength = meanChainLength;
+        stats.maxProbeLength = uint32_t(maxChainLength);
+        stats.rehashCount = uint32_t(rehashCount);
+    }
+
+    void Reserve(size_t count) override {
+        table.reserve(count);
+    }
+
+    void ForEach(const Visitor &visitor) const override {
+        for (const auto &entry : table) {
+            visitor(entry.first, entry.second);
+        }
+    }
+
+    /// @brief Positions are ordinals in the iteration order of the map.
+    size_t Seek(size_t position) const override {
+        return position < table.size() ? position : NPOS;
+    }
+
+    bool GetAt(size_t position, HashTable_Key_ &key, HashTable_Value_ &value) const override {
+        if (position >= table.size()) {
+            return false;
+        }
+
+        // Walking forward one entry at a time is the common case, so we keep the last iterator around and only restart from the beginning if
+        // we have to go backwards or the map has changed shape
+        if (cursorPosition == NPOS || position < cursorPosition) {
+            cursor = table.begin();
+            cursorPosition = 0;
+        }
+
+        for (; cursorPosition < position; cursorPosition++) {
+            ++cursor;
+        }
+
+        key = cursor->first;
+        value = cursor->second;
+        return true;
+    }
+
+  private:
+    using Map = std::unordered_map<HashTable_BinaryBlob_, HashTable_BinaryBlob_>;
+
+    Map table;
+    mutable Map::const_iterator cursor;
+    mutable size_t cursorPosition = NPOS; // ordinal of cursor or NPOS if cursor is not valid
+    size_t keyBytes = 0;
+    size_t valueBytes = 0;
+    size_t rehashCount = 0;
+    mutable bool chainStatsValid = false;
+    mutable size_t maxChainLength = 0;
+    mutable float meanChainLength = 0.0f;
+};
+
+/// @brief Open-addressing (SwissTable) engine.
+class HashTable_FlatBackend_ : public HashTable_ {
+  public:
+    size_t GetSize() const override {
+        return map.GetSize();
+    }
+
+    bool Find(HashTable_Key_ key, HashTable_Value_ &value) const override {
+        return map.Find(key, HashTable_Hash_(key), value);
+    }
+
+    void Set(HashTable_Key_ key, HashTable_Value_ value) override {
+        map.Set(key, value, HashTable_Hash_(key));
+    }
+
+    bool Remove(HashTable_Key_ key) override {
+        return map.Remove(key, HashTable_Hash_(key));
+    }
+
+    void Clear() override {
+        map.Clear();
+    }
+
+    void Reserve(size_t count) override {
+        map.Reserve(count);
+    }
+
+    void Prefetch(HashTable_Key_ key) const override {
+        map.Prefetch(HashTable_Hash_(key));
+    }
+
+    void ForEach(const Visitor &visitor) const override {
+        const auto &table = map.GetTable();
+        for (auto i = table.NextFull(0); i != HashTable_FlatMap_::NPOS; i = table.NextFull(i + 1)) {
+            visitor(table.GetSlot(i).key.View(), table.GetSlot(i).value.View());
+        }
+    }
+
+    /// @brief Positions are slot indices.
+    size_t Seek(size_t position) const override {
+        return map.GetTable().NextFull(position);
+    }
+
+    bool GetAt(size_t position, HashTable_Key_ &key, HashTable_Value_ &value) const override {
+        const auto &table = map.GetTable();
+        if (!table.IsFull(position)) {
+            return false;
+        }
+
+        key = table.GetSlot(position).key.View();
+        value = table.GetSlot(position).value.View();
+        return true;
+    }
+
+    void GetStats(HashTable_Stats_ &stats) const override {
+        stats = HashTable_Stats_();
+        map.AccumulateStats(stats);
+        HashTable_BlobMap_::FinishStats(stats);
+    }
+
+  private:
+    HashTable_BlobMap_ map;
+};
+
+/// @brief Thread-safe engine for tables that are shared between threads (e.g. MIDI callbacks and the main loop). Entries are spread over a
+/// power of 2 number of shards using the top bits of the hash, and every shard is a flat table guarded by its own lock. Threads touching
+/// different shards never contend. Values handed out are copies held in a per-thread buffer that stays valid until the thread's next lookup.
+class HashTable_ConcurrentBackend_ : public HashTable_ {
+  public:
+    static constexpr size_t MAX_SHARDS = 1024;
+
+    /// @brief Creates the engine.
+    /// @param shardCount The requested number of shards. This is rounded up to a power of 2 and clamped to [1, MAX_SHARDS].
+    explicit HashTable_ConcurrentBackend_(size_t shardCount) : shardBits(0) {
+        while ((size_t(1) << shardBits) < std::min(std::max(shardCount, size_t(1)), MAX_SHARDS)) {
+            ++shardBits;
+        }
+
+        shards = std::make_unique<Shard[]>(size_t(1) << shardBits);
+    }
+
+    /// @brief Returns a shard count that suits the machine: a few shards per hardware thread so that the chance of two threads picking the same
+    /// shard is low.
+    static size_t GetDefaultShardCount() {
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1) * 4;
+    }
+
+    size_t GetShardCount() const {
+        return size_t(1) << shardBits;
+    }
+
+    size_t GetSize() const override {
+        size_t size = 0;
+
+        for (size_t i = 0; i < GetShardCount(); i++) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            size += shards[i].map.GetSize();
+        }
+
+        return size;
+    }
+
+    bool Find(HashTable_Key_ key, HashTable_Value_ &value) const override {
+        auto hash = HashTable_Hash_(key);
+        auto &shard = GetShard(hash);
+        auto &buffer = GetThreadBuffer().value;
+
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            HashTable_Value_ found;
+            if (!shard.map.Find(key, hash, found)) {
+                return false;
+            }
+
+            buffer.assign(found);
+        }
+
+        value = buffer;
+        return true;
+    }
+
+    void Set(HashTable_Key_ key, HashTable_Value_ value) override {
+        auto hash = HashTable_Hash_(key);
+        auto &shard = GetShard(hash);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.map.Set(key, value, hash);
+    }
+
+    bool Remove(HashTable_Key_ key) override {
+        auto hash = HashTable_Hash_(key);
+        auto &shard = GetShard(hash);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.map.Remove(key, hash);
+    }
+
+    void Clear() override {
+        for (size_t i = 0; i < GetShardCount(); i++) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            shards[i].map.Clear();
+        }
+    }
+
+    void Reserve(size_t count) override {
+        // Assume the hash spreads keys evenly and leave a little headroom for the shards that get more than their share
+        auto perShard = count / GetShardCount() + count / GetShardCount() / 8 + 1;
+
+        for (size_t i = 0; i < GetShardCount(); i++) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            shards[i].map.Reserve(perShard);
+        }
+    }
+
+    void ForEach(const Visitor &visitor) const override {
+        for (size_t s = 0; s < GetShardCount(); s++) {
+            std::lock_guard<std::mutex> lock(shards[s].mutex);
+
+            const auto &table = shards[s].map.GetTable();
+            for (auto i = table.NextFull(0); i != HashTable_FlatMap_::NPOS; i = table.NextFull(i + 1)) {
+                visitor(table.GetSlot(i).key.View(), table.GetSlot(i).value.View());
+            }
+        }
+    }
+
+    /// @brief Shards are sampled one at a time, so the result is not an atomic snapshot while other threads are writing.
+    void GetStats(HashTable_Stats_ &stats) const override {
+        stats = HashTable_Stats_();
+
+        for (size_t i = 0; i < GetShardCount(); i++) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            shards[i].map.AccumulateStats(stats);
+        }
+
+        HashTable_BlobMap_::FinishStats(stats);
+        stats.metadataBytes += GetShardCount() * sizeof(Shard);
+    }
+
+    /// @brief Positions hold the shard index in the top bits and the slot index in the rest.
+    size_t Seek(size_t position) const override {
+        for (auto s = GetPositionShard(position); s < GetShardCount(); s++) {
+            std::lock_guard<std::mutex> lock(shards[s].mutex);
+
+            auto i = shards[s].map.GetTable().NextFull(s == GetPositionShard(position) ? GetPositionSlot(position) : 0);
+            if (i != HashTable_FlatMap_::NPOS && i <= GetSlotMask()) {
+                return (shardBits ? s << (POSITION_BITS - shardBits) : 0) | i;
+            }
+        }
+
+        return NPOS;
+    }
+
+    bool GetAt(size_t position, HashTable_Key_ &key, HashTable_Value_ &value) const override {
+        auto s = GetPositionShard(position);
+        if (s >= GetShardCount()) {
+            return false;
+        }
+
+        auto &buffer = GetThreadBuffer();
+
+        {
+            std::lock_guard<std::mutex> lock(shards[s].mutex);
+
+            const auto &table = shards[s].map.GetTable();
+            auto i = GetPositionSlot(position);
+            if (!table.IsFull(i)) {
+                return false;
+            }
+
+            buffer.key.assign(table.GetSlot(i).key.View());
+            buffer.value.assign(table.GetSlot(i).value.View());
+        }
+
+        key = buffer.key;
+        value = buffer.value;
+        return true;
+    }
+
+  private:
+    static constexpr size_t POSITION_BITS = sizeof(size_t) * 8;
+
+    /// @brief Shards are cache line aligned so that locks of neighboring shards do not share a line.
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        HashTable_BlobMap_ map;
+    };
+
+    /// @brief Per-thread copies of the last key and value handed out.
+    struct ThreadBuffer {
+        HashTable_BinaryBlob_ key;
+        HashTable_BinaryBlob_ value;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shardBits;
+
+    static ThreadBuffer &GetThreadBuffer() {
+        static thread_local ThreadBuffer buffer;
+        return buffer;
+    }
+
+    Shard &GetShard(uint64_t hash) const {
+        // H1 and H2 come from the low bits, so the top bits are free to pick the shard
+        return shards[shardBits ? size_t(hash >> (64 - shardBits)) : 0];
+    }
+
+    size_t GetPositionShard(size_t position) const {
+        return shardBits ? position >> (POSITION_BITS - shardBits) : 0;
+    }
+
+    size_t GetSlotMask() const {
+        return SIZE_MAX >> shardBits;
+    }
+
+    size_t GetPositionSlot(size_t position) const {
+        return position & GetSlotMask();
+    }
+};
+
+/// @brief File header of a hash table snapshot. A snapshot is a flat, read-only image of a SwissTable (see HashTable_SwissTable_): the header,
+/// the control bytes, an array of HashTable_SnapshotSlot_ and finally the NUL terminated key and value bytes. All offsets are relative to the
+/// start of the file so that the image can be mapped at any address and used without any parsing.
+struct HashTable_SnapshotHeader_ {
+    static constexpr char MAGIC[8] = {'Q', 'B', 'H', 'T', 'S', 'N', 'A', 'P'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304; // snapshots are only valid on machines with the same byte order (and hash)
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t fileSize;
+    uint64_t capacity;
+    uint64_t size;
+    uint64_t ctrlOffset;
+    uint64_t slotsOffset;
+};
+
+/// @brief Slot of a hash table snapshot.
+struct HashTable_SnapshotSlot_ {
+    uint64_t keyOffset;
+    uint64_t valueOffset;
+    uint32_t keySize;
+    uint32_t valueSize;
+};
+
+/// @brief Read-only engine that performs lookups directly on a memory-mapped snapshot created by HashTable_SaveSnapshot().
+class HashTable_SnapshotBackend_ : public HashTable_ {
+  public:
+    HashTable_SnapshotBackend_() : base(nullptr), header(nullptr), ctrl(nullptr), slots(nullptr), capacity(0) {}
+
+    /// @brief Maps and validates a snapshot file.
+    /// @return True if the file is a usable snapshot.
+    bool Open(const char *fileName) {
+        if (!file.Open(fileName) || file.GetSize() < sizeof(HashTable_SnapshotHeader_)) {
+            return false;
+        }
+
+        base = reinterpret_cast<const char *>(file.GetData());
+        header = reinterpret_cast<const HashTable_SnapshotHeader_ *>(base);
+        auto fileSize = file.GetSize();
+
+        if (std::memcmp(header->magic, HashTable_SnapshotHeader_::MAGIC, sizeof(header->magic)) || header->version != HashTable_SnapshotHeader_::VERSION ||
+            header->byteOrderMark != HashTable_SnapshotHeader_::BYTE_ORDER_MARK || header->fileSize != fileSize) {
+            return false;
+        }
+
+        capacity = size_t(header->capacity);
+        if (capacity < HashTable_Group_::WIDTH || (capacity & (capacity - 1)) || header->size > HashTable_MaxLoad_(capacity) ||
+            header->ctrlOffset > fileSize || fileSize - header->ctrlOffset < capacity + HashTable_Group_::WIDTH ||
+            header->slotsOffset % alignof(HashTable_SnapshotSlot_) || header->slotsOffset > fileSize ||
+            (fileSize - header->slotsOffset) / sizeof(HashTable_SnapshotSlot_) < capacity) {
+            return false;
+        }
+
+        ctrl = reinterpret_cast<const int8_t *>(base + header->ctrlOffset);
+        slots = reinterpret_cast<const HashTable_SnapshotSlot_ *>(base + header->slotsOffset);
+
+        return IsImageValid();
+    }
+
+    size_t GetSize() const override {
+        return size_t(header->size);
+    }
+
+    bool Find(HashTable_Key_ key, HashTable_Value_ &value) const override {
+        auto i = HashTable_ProbeFind_(ctrl, capacity, HashTable_Hash_(key), [&](size_t i) { return GetKey(slots[i]) == key; });
+        if (i == SIZE_MAX) {
+            return false;
+        }
+
+        value = GetValue(slots[i]);
+        return true;
+    }
+
+    void Set(HashTable_Key_ key, HashTable_Value_ value) override {
+        (void)key;
+        (void)value;
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL); // snapshots are read-only
+    }
+
+    bool Remove(HashTable_Key_ key) override {
+        (void)key;
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return false;
+    }
+
+    void Clear() override {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+
+    void Reserve(size_t count) override {
+        (void)count;
+    }
+
+    void Prefetch(HashTable_Key_ key) const override {
+        auto pos = HashTable_H1_(HashTable_Hash_(key)) & (capacity - 1);
+        __builtin_prefetch(ctrl + pos);
+        __builtin_prefetch(slots + pos);
+    }
+
+    void ForEach(const Visitor &visitor) const override {
+        for (auto i = Seek(0); i != NPOS; i = Seek(i + 1)) {
+            visitor(GetKey(slots[i]), GetValue(slots[i]));
+        }
+    }
+
+    /// @brief Positions are slot indices.
+    size_t Seek(size_t position) const override {
+        return HashTable_NextFull_(ctrl, capacity, position);
+    }
+
+    bool GetAt(size_t position, HashTable_Key_ &key, HashTable_Value_ &value) const override {
+        if (position >= capacity || ctrl[position] < 0) {
+            return false;
+        }
+
+        key = GetKey(slots[position]);
+        value = GetValue(slots[position]);
+        return true;
+    }
+
+    /// @brief The image never changes, so the statistics are computed on first use and then cached.
+    void GetStats(HashTable_Stats_ &stats) const override {
+        if (!cachedStats.slots) {
+            size_t totalProbeLength = 0;
+
+            for (auto i = Seek(0); i != NPOS; i = Seek(i + 1)) {
+                auto length = HashTable_ProbeLength_(capacity, HashTable_Hash_(GetKey(slots[i])), i);
+                totalProbeLength += length;
+                cachedStats.maxProbeLength = std::max(cachedStats.maxProbeLength, uint32_t(length));
+                cachedStats.keyBytes += slots[i].keySize;
+                cachedStats.valueBytes += slots[i].valueSize;
+            }
+
+            cachedStats.size = header->size;
+            cachedStats.slots = capacity;
+            cachedStats.metadataBytes = header->fileSize - cachedStats.keyBytes - cachedStats.valueBytes;
+            cachedStats.loadFactor = float(cachedStats.size) / float(cachedStats.slots);
+            cachedStats.meanProbeLength = cachedStats.size ? float(totalProbeLength) / float(cachedStats.size) : 0.0f;
+        }
+
+        stats = cachedStats;
+    }
+
+  private:
+    MappedFile_ file;
+    mutable HashTable_Stats_ cachedStats = {};
+    const char *base;
+    const HashTable_SnapshotHeader_ *header;
+    const int8_t *ctrl;
+    const HashTable_SnapshotSlot_ *slots;
+    size_t capacity;
+
+    /// @brief Checks that a key or value range (plus the NUL terminator) is inside the file.
+    bool IsRangeValid(uint64_t offset, uint32_t size) const {
+        return offset < header->fileSize && header->fileSize - offset > size && base[offset + size] == '\0';
+    }
+
+    /// @brief Checks the control bytes and the slots of a mapped image. Probing stops only at an empty slot, so a corrupt image without one would
+    /// make lookups loop forever.
+    bool IsImageValid() const {
+        size_t full = 0;
+        auto hasEmpty = false;
+
+        for (size_t i = 0; i < capacity; i++) {
+            if (ctrl[i] >= 0) {
+                if (!IsRangeValid(slots[i].keyOffset, slots[i].keySize) || !IsRangeValid(slots[i].valueOffset, slots[i].valueSize)) {
+                    return false;
+                }
+
+                ++full;
+            } else if (ctrl[i] == HashTable_Group_::EMPTY) {
+                hasEmpty = true;
+            } else if (ctrl[i] != HashTable_Group_::DELETED) {
+                return false;
+            }
+
+            // The first group is mirrored after the last slot so that groups can be loaded without wrapping
+            if (i < HashTable_Group_::WIDTH && ctrl[capacity + i] != ctrl[i]) {
+                return false;
+            }
+        }
+
+        return hasEmpty && full == header->size;
+    }
+
+    /// @brief Returns a view of size bytes at offset, or an empty view if that range (plus the NUL terminator) is outside the file.
+    HashTable_Key_ GetBytes(uint64_t offset, uint32_t size) const {
+        if (offset >= header->fileSize || header->fileSize - offset <= size) {
+            return HashTable_Key_(String_Empty, 0);
+        }
+
+        return HashTable_Key_(base + offset, size);
+    }
+
+    HashTable_Key_ GetKey(const HashTable_SnapshotSlot_ &slot) const {
+        return GetBytes(slot.keyOffset, slot.keySize);
+    }
+
+    HashTable_Value_ GetValue(const HashTable_SnapshotSlot_ &slot) const {
+        return GetBytes(slot.valueOffset, slot.valueSize);
+    }
+};
+
+/// @brief Converts a QB64 _OFFSET to a hash table reference.
+inline HashTable_ &HashTable_Get_(uintptr_t hTable) {
+    return *reinterpret_cast<HashTable_ *>(hTable);
+}
+
+/// @brief Makes a key view from a numeric key.
+inline HashTable_Key_ HashTable_MakeKey_(const uintptr_t &key) {
+    return HashTable_Key_(reinterpret_cast<const char *>(&key), sizeof(key));
+}
+
+/// @brief Copies a value into a T, zero-extending or truncating as required.
+template <typename T> inline T HashTable_ValueTo_(HashTable_Value_ value) {
+    T out{};
+    std::memcpy(&out, value.data(), std::min(value.size(), sizeof(T)));
+    return out;
+}
+
+/// @brief Creates a new hash table using a specific storage engine.
+/// @param backend One of the HashTable_::Backend values.
+/// @return A pointer (QB64 _OFFSET) to the hash table.
+inline uintptr_t HashTable_CreateEx(int32_t backend) {
+    switch (backend) {
+    case HashTable_::Backend::NODE:
+        return reinterpret_cast<uintptr_t>(static_cast<HashTable_ *>(new HashTable_NodeBackend_()));
+
+    case HashTable_::Backend::FLAT:
+        return reinterpret_cast<uintptr_t>(static_cast<HashTable_ *>(new HashTable_FlatBackend_()));
+
+    case HashTable_::Backend::CONCURRENT:
+        return reinterpret_cast<uintptr_t>(static_cast<HashTable_ *>(new HashTable_ConcurrentBackend_(HashTable_ConcurrentBackend_::GetDefaultShardCount())));
+
+    default:
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+}
+
+/// @brief Creates a new thread-safe hash table that can be shared by multiple threads. It supports the full HashTable API. String values
+/// returned by lookups are copies that are private to the calling thread.
+/// @param shardCount The number of independently locked shards. This is rounded up to a power of 2 (max 1024). 0 picks a default based on the
+/// number of hardware threads.
+/// @return A pointer (QB64 _OFFSET) to the hash table.
+inline uintptr_t HashTable_CreateConcurrent(uint32_t shardCount) {
+    return reinterpret_cast<uintptr_t>(static_cast<HashTable_ *>(
+        new HashTable_ConcurrentBackend_(shardCount ? shardCount : HashTable_ConcurrentBackend_::GetDefaultShardCount())));
+}
 
 /// @brief Creates a new hash table.
 /// @return A pointer (QB64 _OFFSET) to the hash table.
 inline uintptr_t HashTable_Create() {
-    return reinterpret_cast<uintptr_t>(new HashTable_());
+    return HashTable_CreateEx(HashTable_::Backend::NODE);
 }
 
 /// @brief Destroys a hash table.
@@ -31,45 +1612,131 @@ inline void HashTable_Destroy(uintptr_t hTable) {
     delete reinterpret_cast<HashTable_ *>(hTable);
 }
 
+/// @brief Writes a hash table to a snapshot file that can later be mapped using HashTable_OpenSnapshot().
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table. This can use any engine.
+/// @param fileName The snapshot file name (NUL terminated).
+/// @return _TRUE if the snapshot was written, _FALSE otherwise.
+inline qb_bool HashTable_SaveSnapshot_(uintptr_t hTable, const char *fileName) {
+    const auto &table = HashTable_Get_(hTable);
+
+    size_t capacity = HashTable_Group_::WIDTH;
+    while (HashTable_MaxLoad_(capacity) < table.GetSize()) {
+        capacity *= 2;
+    }
+
+    HashTable_SnapshotHeader_ header = {};
+    std::memcpy(header.magic, HashTable_SnapshotHeader_::MAGIC, sizeof(header.magic));
+    header.version = HashTable_SnapshotHeader_::VERSION;
+    header.byteOrderMark = HashTable_SnapshotHeader_::BYTE_ORDER_MARK;
+    header.capacity = capacity;
+    header.size = table.GetSize();
+    header.ctrlOffset = sizeof(header);
+
+    auto ctrlSize = capacity + HashTable_Group_::WIDTH;
+    header.slotsOffset = (header.ctrlOffset + ctrlSize + alignof(HashTable_SnapshotSlot_) - 1) & ~uint64_t(alignof(HashTable_SnapshotSlot_) - 1);
+    auto dataOffset = header.slotsOffset + capacity * sizeof(HashTable_SnapshotSlot_);
+
+    std::vector<int8_t> ctrl(header.slotsOffset - header.ctrlOffset, HashTable_Group_::EMPTY);
+    std::vector<HashTable_SnapshotSlot_> slots(capacity, HashTable_SnapshotSlot_());
+    std::string data;
+    auto fits = true;
+
+    table.ForEach([&](HashTable_Key_ key, HashTable_Value_ value) {
+        // Slots store 32-bit sizes
+        if (key.size() > UINT32_MAX || value.size() > UINT32_MAX) {
+            fits = false;
+            return;
+        }
+
+        auto hash = HashTable_Hash_(key);
+        auto i = HashTable_ProbeFirstNonFull_(ctrl.data(), capacity, hash);
+        HashTable_SetCtrl_(ctrl.data(), capacity, i, HashTable_H2_(hash));
+
+        slots[i].keyOffset = dataOffset + data.size();
+        slots[i].keySize = uint32_t(key.size());
+        data.append(key).push_back('\0');
+        slots[i].valueOffset = dataOffset + data.size();
+        slots[i].valueSize = uint32_t(value.size());
+        data.append(value).push_back('\0');
+    });
+
+    header.fileSize = dataOffset + data.size();
+
+    if (!fits) {
+        return QB_FALSE;
+    }
+
+    auto file = std::fopen(fileName, "wb");
+    if (!file) {
+        return QB_FALSE;
+    }
+
+    auto success = std::fwrite(&header, sizeof(header), 1, file) == 1 && std::fwrite(ctrl.data(), ctrl.size(), 1, file) == 1 &&
+                   std::fwrite(slots.data(), sizeof(HashTable_SnapshotSlot_), slots.size(), file) == slots.size() &&
+                   std::fwrite(data.data(), 1, data.size(), file) == data.size();
+
+    return TO_QB_BOOL(std::fclose(file) == 0 && success);
+}
+
+/// @brief Opens a snapshot file created by HashTable_SaveSnapshot(). The file is memory-mapped and lookups run directly on the mapped image, so
+/// opening only needs one validation pass over the control bytes and slots. The returned table is read-only: setting, removing or clearing entries is an error.
+/// @param fileName The snapshot file name (NUL terminated).
+/// @return A pointer (QB64 _OFFSET) to the hash table or 0 if the file is missing or is not a valid snapshot.
+inline uintptr_t HashTable_OpenSnapshot_(const char *fileName) {
+    auto table = new HashTable_SnapshotBackend_();
+
+    if (!table->Open(fileName)) {
+        delete table;
+        return 0;
+    }
+
+    return reinterpret_cast<uintptr_t>(static_cast<HashTable_ *>(table));
+}
+
+/// @brief Gets statistics about the memory use and the health of a hash table.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param stats A pointer to a HashTable_StatsType variable that receives the statistics.
+inline void HashTable_GetStats_(uintptr_t hTable, uintptr_t stats) {
+    HashTable_Get_(hTable).GetStats(*reinterpret_cast<HashTable_Stats_ *>(stats));
+}
+
 /// @brief Clears a hash table.
 /// @param hTable A pointer (QB64 _OFFSET) to the hash table.
 inline void HashTable_Clear(uintptr_t hTable) {
-    reinterpret_cast<HashTable_ *>(hTable)->clear();
+    HashTable_Get_(hTable).Clear();
 }
 
 /// @brief Gets the size of a hash table.
 /// @param hTable A pointer (QB64 _OFFSET) to the hash table.
 /// @return The size (QB64 _OFFSET) of the hash table.
 inline size_t HashTable_GetSize(uintptr_t hTable) {
-    return reinterpret_cast<HashTable_ *>(hTable)->size();
+    return HashTable_Get_(hTable).GetSize();
 }
 
 /// @brief Checks if a hash table is empty.
 /// @param hTable A pointer (QB64 _OFFSET) to the hash table.
 /// @return _TRUE if the hash table is empty, _FALSE otherwise.
 inline qb_bool HashTable_IsEmpty(uintptr_t hTable) {
-    return TO_QB_BOOL(reinterpret_cast<HashTable_ *>(hTable)->empty());
+    return TO_QB_BOOL(HashTable_Get_(hTable).GetSize() == 0);
 }
 
 /// @brief Checks if a hash table contains a key.
 /// @param hTable A pointer (QB64 _OFFSET) to the hash table.
-/// @param key The key (any QB64 numeric type) to check.
+/// @param key The key (QB64 string) to check.
+/// @param keySize The size of the QB64 string (in bytes).
 /// @return _TRUE if the hash table contains the key, _FALSE otherwise.
-inline qb_bool HashTable_Contains(uintptr_t hTable, uintptr_t key) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(reinterpret_cast<const char *>(&key), sizeof(key));
-    return TO_QB_BOOL(table.find(keyBlob) != table.end());
+inline qb_bool HashTable_StringContains_(uintptr_t hTable, const char *key, size_t keySize) {
+    HashTable_Value_ value;
+    return TO_QB_BOOL(HashTable_Get_(hTable).Find(HashTable_Key_(key, keySize), value));
 }
 
 /// @brief Checks if a hash table contains a key.
 /// @param hTable A pointer (QB64 _OFFSET) to the hash table.
-/// @param key The key (QB64 string) to check.
-/// @param keySize The size of the QB64 string (in bytes).
+/// @param key The key (any QB64 numeric type) to check.
 /// @return _TRUE if the hash table contains the key, _FALSE otherwise.
-inline qb_bool HashTable_StringContains_(uintptr_t hTable, const char *key, size_t keySize) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(key, keySize);
-    return TO_QB_BOOL(table.find(keyBlob) != table.end());
+inline qb_bool HashTable_Contains(uintptr_t hTable, uintptr_t key) {
+    HashTable_Value_ value;
+    return TO_QB_BOOL(HashTable_Get_(hTable).Find(HashTable_MakeKey_(key), value));
 }
 
 /// @brief Removes a key from a hash table.
@@ -77,9 +1744,7 @@ inline qb_bool HashTable_StringContains_(uintptr_t hTable, const char *key, size
 /// @param key The key (any QB64 numeric type) to remove.
 /// @return _TRUE if the key was removed, _FALSE otherwise.
 inline qb_bool HashTable_Remove(uintptr_t hTable, uintptr_t key) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(reinterpret_cast<const char *>(&key), sizeof(key));
-    return TO_QB_BOOL(table.erase(keyBlob) != 0);
+    return TO_QB_BOOL(HashTable_Get_(hTable).Remove(HashTable_MakeKey_(key)));
 }
 
 /// @brief Removes a key from a hash table.
@@ -88,9 +1753,7 @@ inline qb_bool HashTable_Remove(uintptr_t hTable, uintptr_t key) {
 /// @param keySize The size of the QB64 string (in bytes).
 /// @return _TRUE if the key was removed, _FALSE otherwise.
 inline qb_bool HashTable_StringRemove_(uintptr_t hTable, const char *key, size_t keySize) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(key, keySize);
-    return TO_QB_BOOL(table.erase(keyBlob) != 0);
+    return TO_QB_BOOL(HashTable_Get_(hTable).Remove(HashTable_Key_(key, keySize)));
 }
 
 /// @brief Sets a key-value pair in a hash table.
@@ -99,10 +1762,7 @@ inline qb_bool HashTable_StringRemove_(uintptr_t hTable, const char *key, size_t
 /// @param key The key (any QB64 numeric type) to set.
 /// @param value The value (any QB64 numeric type) to set.
 template <typename T> inline void HashTable_Set(uintptr_t hTable, uintptr_t key, T value) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(reinterpret_cast<const char *>(&key), sizeof(key));
-    HashTable_BinaryBlob_ valBlob(reinterpret_cast<const char *>(&value), sizeof(T));
-    table.insert_or_assign(std::move(keyBlob), std::move(valBlob));
+    HashTable_Get_(hTable).Set(HashTable_MakeKey_(key), HashTable_Value_(reinterpret_cast<const char *>(&value), sizeof(T)));
 }
 
 /// @brief Sets a key-value pair in a hash table.
@@ -111,10 +1771,7 @@ template <typename T> inline void HashTable_Set(uintptr_t hTable, uintptr_t key,
 /// @param value The value (any pointer) to set. This can a QB64 STRING or UDT.
 /// @param valueSize The size of the value (in bytes).
 inline void HashTable_SetBlob_(uintptr_t hTable, uintptr_t key, uintptr_t value, size_t valueSize) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(reinterpret_cast<const char *>(&key), sizeof(key));
-    HashTable_BinaryBlob_ valBlob(reinterpret_cast<const char *>(value), valueSize);
-    table.insert_or_assign(std::move(keyBlob), std::move(valBlob));
+    HashTable_Get_(hTable).Set(HashTable_MakeKey_(key), HashTable_Value_(reinterpret_cast<const char *>(value), valueSize));
 }
 
 /// @brief Sets a key-value pair in a hash table.
@@ -124,10 +1781,7 @@ inline void HashTable_SetBlob_(uintptr_t hTable, uintptr_t key, uintptr_t value,
 /// @param keySize The size of the QB64 string (in bytes).
 /// @param value The value (any QB64 numeric type) to set.
 template <typename T> inline void HashTable_StringSet_(uintptr_t hTable, const char *key, size_t keySize, T value) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(key, keySize);
-    HashTable_BinaryBlob_ valBlob(reinterpret_cast<const char *>(&value), sizeof(T));
-    table.insert_or_assign(std::move(keyBlob), std::move(valBlob));
+    HashTable_Get_(hTable).Set(HashTable_Key_(key, keySize), HashTable_Value_(reinterpret_cast<const char *>(&value), sizeof(T)));
 }
 
 /// @brief Sets a key-value pair in a hash table.
@@ -137,10 +1791,7 @@ template <typename T> inline void HashTable_StringSet_(uintptr_t hTable, const c
 /// @param value The value (any pointer) to set. This can a QB64 STRING or UDT.
 /// @param valueSize The size of the value (in bytes).
 inline void HashTable_StringSetBlob_(uintptr_t hTable, const char *key, size_t keySize, uintptr_t value, size_t valueSize) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(key, keySize);
-    HashTable_BinaryBlob_ valBlob(reinterpret_cast<const char *>(value), valueSize);
-    table.insert_or_assign(std::move(keyBlob), std::move(valBlob));
+    HashTable_Get_(hTable).Set(HashTable_Key_(key, keySize), HashTable_Value_(reinterpret_cast<const char *>(value), valueSize));
 }
 
 /// @brief Gets a value from a hash table.
@@ -149,18 +1800,12 @@ inline void HashTable_StringSetBlob_(uintptr_t hTable, const char *key, size_t k
 /// @param key The key (any QB64 numeric type) to get.
 /// @return The value (any QB64 numeric type) associated with the key.
 template <typename T> inline T HashTable_Get(uintptr_t hTable, uintptr_t key) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(reinterpret_cast<const char *>(&key), sizeof(key));
-
-    const auto it = table.find(keyBlob);
-    if (it == table.end()) {
+    HashTable_Value_ value;
+    if (!HashTable_Get_(hTable).Find(HashTable_MakeKey_(key), value)) {
         return T();
     }
 
-    T out{};
-    const auto &buf = it->second;
-    std::memcpy(&out, buf.data(), std::min(buf.size(), sizeof(T)));
-    return out;
+    return HashTable_ValueTo_<T>(value);
 }
 
 /// @brief Gets a value from a hash table.
@@ -169,15 +1814,11 @@ template <typename T> inline T HashTable_Get(uintptr_t hTable, uintptr_t key) {
 /// @param value The value (UDT pointer) to get.
 /// @param valueSize The size of the value (in bytes).
 inline qb_bool HashTable_GetUDT(uintptr_t hTable, uintptr_t key, uintptr_t value, size_t valueSize) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(reinterpret_cast<const char *>(&key), sizeof(key));
-
-    const auto it = table.find(keyBlob);
-    if (it == table.end()) {
+    HashTable_Value_ buf;
+    if (!HashTable_Get_(hTable).Find(HashTable_MakeKey_(key), buf)) {
         return QB_FALSE;
     }
 
-    const auto &buf = it->second;
     std::memcpy(reinterpret_cast<void *>(value), buf.data(), std::min(buf.size(), valueSize));
     return QB_TRUE;
 }
@@ -187,15 +1828,12 @@ inline qb_bool HashTable_GetUDT(uintptr_t hTable, uintptr_t key, uintptr_t value
 /// @param key The key (any QB64 numeric type) to get.
 /// @return The value (QB64 string) associated with the key.
 inline const char *HashTable_GetString_(uintptr_t hTable, uintptr_t key) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(reinterpret_cast<const char *>(&key), sizeof(key));
-
-    const auto it = table.find(keyBlob);
-    if (it == table.end()) {
+    HashTable_Value_ value;
+    if (!HashTable_Get_(hTable).Find(HashTable_MakeKey_(key), value)) {
         return String_Empty;
     }
 
-    return it->second.c_str();
+    return value.data();
 }
 
 /// @brief Gets a value from a hash table.
@@ -205,18 +1843,12 @@ inline const char *HashTable_GetString_(uintptr_t hTable, uintptr_t key) {
 /// @param keySize The size of the QB64 string (in bytes).
 /// @return The value (any QB64 numeric type) associated with the key.
 template <typename T> inline T HashTable_StringGet_(uintptr_t hTable, const char *key, size_t keySize) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(key, keySize);
-
-    const auto it = table.find(keyBlob);
-    if (it == table.end()) {
+    HashTable_Value_ value;
+    if (!HashTable_Get_(hTable).Find(HashTable_Key_(key, keySize), value)) {
         return T();
     }
 
-    T out{};
-    const auto &buf = it->second;
-    std::memcpy(&out, buf.data(), std::min(buf.size(), sizeof(T)));
-    return out;
+    return HashTable_ValueTo_<T>(value);
 }
 
 /// @brief Gets a value from a hash table.
@@ -226,15 +1858,11 @@ template <typename T> inline T HashTable_StringGet_(uintptr_t hTable, const char
 /// @param value The value (any pointer) to get. This can a QB64 STRING or UDT.
 /// @param valueSize The size of the value (in bytes).
 inline qb_bool HashTable_StringGetBlob_(uintptr_t hTable, const char *key, size_t keySize, uintptr_t value, size_t valueSize) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(key, keySize);
-
-    const auto it = table.find(keyBlob);
-    if (it == table.end()) {
+    HashTable_Value_ buf;
+    if (!HashTable_Get_(hTable).Find(HashTable_Key_(key, keySize), buf)) {
         return QB_FALSE;
     }
 
-    const auto &buf = it->second;
     std::memcpy(reinterpret_cast<void *>(value), buf.data(), std::min(buf.size(), valueSize));
     return QB_TRUE;
 }
@@ -245,13 +1873,529 @@ inline qb_bool HashTable_StringGetBlob_(uintptr_t hTable, const char *key, size_
 /// @param keySize The size of the QB64 string (in bytes).
 /// @return The value (QB64 string) associated with the key.
 inline const char *HashTable_StringGetString_(uintptr_t hTable, const char *key, size_t keySize) {
-    auto &table = *reinterpret_cast<HashTable_ *>(hTable);
-    HashTable_BinaryBlob_ keyBlob(key, keySize);
-
-    const auto it = table.find(keyBlob);
-    if (it == table.end()) {
+    HashTable_Value_ value;
+    if (!HashTable_Get_(hTable).Find(HashTable_Key_(key, keySize), value)) {
         return String_Empty;
     }
 
-    return it->second.c_str();
+    return value.data();
+}
+
+/// @brief Gets the entry a cursor points to. Raises an error if the cursor is not valid.
+inline void HashTable_IterGet_(uintptr_t hTable, uintptr_t cursor, HashTable_Key_ &key, HashTable_Value_ &value) {
+    if (!cursor || !HashTable_Get_(hTable).GetAt(cursor - 1, key, value)) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        key = value = HashTable_Key_(String_Empty, 0);
+    }
+}
+
+/// @brief Starts walking the entries of a hash table. Entries are visited in storage order, which is the most cache-friendly order for the
+/// engine. A cursor stays valid while values are updated. Adding entries during a walk may cause entries to be skipped or visited twice. With
+/// the flat engine, entries can also be removed during a walk.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @return A cursor (QB64 _OFFSET) to the first entry or 0 if the table is empty.
+inline uintptr_t HashTable_IterBegin(uintptr_t hTable) {
+    return HashTable_Get_(hTable).Seek(0) + 1; // NPOS + 1 wraps to 0
+}
+
+/// @brief Moves a cursor to the next entry.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param cursor A cursor returned by HashTable_IterBegin() or HashTable_IterNext().
+/// @return A cursor (QB64 _OFFSET) to the next entry or 0 if there are no more entries.
+inline uintptr_t HashTable_IterNext(uintptr_t hTable, uintptr_t cursor) {
+    if (!cursor) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return HashTable_Get_(hTable).Seek(cursor) + 1; // cursor is already position + 1
+}
+
+/// @brief Gets the key of the entry a cursor points to.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param cursor A valid cursor.
+/// @return The key (QB64 _OFFSET). Only meaningful for tables with numeric keys.
+inline uintptr_t HashTable_IterGetKey(uintptr_t hTable, uintptr_t cursor) {
+    HashTable_Key_ key;
+    HashTable_Value_ value;
+    HashTable_IterGet_(hTable, cursor, key, value);
+
+    return HashTable_ValueTo_<uintptr_t>(key);
+}
+
+/// @brief Gets the key of the entry a cursor points to.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param cursor A valid cursor.
+/// @return The key (QB64 string).
+inline const char *HashTable_IterGetKeyString_(uintptr_t hTable, uintptr_t cursor) {
+    HashTable_Key_ key;
+    HashTable_Value_ value;
+    HashTable_IterGet_(hTable, cursor, key, value);
+
+    return key.data();
+}
+
+/// @brief Gets the value of the entry a cursor points to.
+/// @tparam T The value type.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param cursor A valid cursor.
+/// @return The value (any QB64 numeric type).
+template <typename T> inline T HashTable_IterGetValue(uintptr_t hTable, uintptr_t cursor) {
+    HashTable_Key_ key;
+    HashTable_Value_ value;
+    HashTable_IterGet_(hTable, cursor, key, value);
+
+    return HashTable_ValueTo_<T>(value);
+}
+
+/// @brief Gets the value of the entry a cursor points to.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param cursor A valid cursor.
+/// @return The value (QB64 string).
+inline const char *HashTable_IterGetValueString_(uintptr_t hTable, uintptr_t cursor) {
+    HashTable_Key_ key;
+    HashTable_Value_ value;
+    HashTable_IterGet_(hTable, cursor, key, value);
+
+    return value.data();
+}
+
+/// @brief Sets many key-value pairs in a hash table in one call.
+/// @tparam T The value type.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param keys A pointer to an array of count keys (QB64 _OFFSET).
+/// @param values A pointer to an array of count values (any QB64 numeric type).
+/// @param count The number of elements in both arrays.
+template <typename T> inline void HashTable_SetMany_(uintptr_t hTable, uintptr_t keys, uintptr_t values, size_t count) {
+    auto &table = HashTable_Get_(hTable);
+    auto k = reinterpret_cast<const uintptr_t *>(keys);
+    auto v = reinterpret_cast<const T *>(values);
+
+    table.Reserve(table.GetSize() + count);
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + HashTable_::PREFETCH_DISTANCE < count) {
+            table.Prefetch(HashTable_MakeKey_(k[i + HashTable_::PREFETCH_DISTANCE]));
+        }
+
+        table.Set(HashTable_MakeKey_(k[i]), HashTable_Value_(reinterpret_cast<const char *>(&v[i]), sizeof(T)));
+    }
+}
+
+/// @brief Gets many values from a hash table in one call.
+/// @tparam T The value type.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param keys A pointer to an array of count keys (QB64 _OFFSET).
+/// @param values A pointer to an array of count values (any QB64 numeric type) that receives the results. Missing keys get zero.
+/// @param count The number of elements in both arrays.
+/// @return The number of keys that were found.
+template <typename T> inline size_t HashTable_GetMany_(uintptr_t hTable, uintptr_t keys, uintptr_t values, size_t count) {
+    const auto &table = HashTable_Get_(hTable);
+    auto k = reinterpret_cast<const uintptr_t *>(keys);
+    auto v = reinterpret_cast<T *>(values);
+    size_t found = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + HashTable_::PREFETCH_DISTANCE < count) {
+            table.Prefetch(HashTable_MakeKey_(k[i + HashTable_::PREFETCH_DISTANCE]));
+        }
+
+        HashTable_Value_ value;
+        if (table.Find(HashTable_MakeKey_(k[i]), value)) {
+            v[i] = HashTable_ValueTo_<T>(value);
+            ++found;
+        } else {
+            v[i] = T();
+        }
+    }
+
+    return found;
+}
+
+/// @brief Removes many keys from a hash table in one call.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param keys A pointer to an array of count keys (QB64 _OFFSET).
+/// @param count The number of elements in the array.
+/// @return The number of keys that were removed.
+inline size_t HashTable_RemoveMany_(uintptr_t hTable, uintptr_t keys, size_t count) {
+    auto &table = HashTable_Get_(hTable);
+    auto k = reinterpret_cast<const uintptr_t *>(keys);
+    size_t removed = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + HashTable_::PREFETCH_DISTANCE < count) {
+            table.Prefetch(HashTable_MakeKey_(k[i + HashTable_::PREFETCH_DISTANCE]));
+        }
+
+        removed += table.Remove(HashTable_MakeKey_(k[i]));
+    }
+
+    return removed;
+}
+
+/// @brief Length prefix written by HashTable_StringGetMany() for keys that are not in the table.
+constexpr uint32_t HashTable_PackedMissing_ = UINT32_MAX;
+
+/// @brief Splits a packed MemFile buffer into string views. The buffer is read from the cursor to the end and holds records of fieldsPerRecord
+/// length-prefixed ([uint32 size][bytes]) fields. The cursor is moved past all records. Chunked MemFiles are flattened first.
+/// @param p A valid pointer to a MemFile object.
+/// @param fieldsPerRecord 1 for keys only, 2 for key-value pairs.
+/// @return The fields in buffer order. The views point into the MemFile buffer.
+inline std::vector<std::string_view> HashTable_UnpackFields_(uintptr_t p, size_t fieldsPerRecord) {
+    std::vector<std::string_view> fields;
+    auto memFile = reinterpret_cast<MemFile *>(p);
+    if (!memFile) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return fields;
+    }
+
+    MemFile_Flatten(p);
+
+    auto data = reinterpret_cast<const char *>(memFile->store->GetData());
+    auto size = memFile->store->GetSize();
+    auto cursor = memFile->cursor;
+
+    while (cursor < size) {
+        uint32_t fieldSize;
+        if (size - cursor < sizeof(fieldSize)) {
+            break;
+        }
+
+        std::memcpy(&fieldSize, data + cursor, sizeof(fieldSize));
+        cursor += sizeof(fieldSize);
+        if (size - cursor < fieldSize) {
+            break;
+        }
+
+        fields.emplace_back(data + cursor, fieldSize);
+        cursor += fieldSize;
+    }
+
+    if (cursor != size || fields.size() % fieldsPerRecord) {
+        // Truncated or malformed buffer
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        fields.clear();
+        return fields;
+    }
+
+    memFile->cursor = cursor;
+    return fields;
+}
+
+/// @brief Sets many string key-value pairs in a hash table in one call.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param pairs A MemFile holding [uint32 key size][key][uint32 value size][value] records from the cursor to the end of the buffer.
+/// @return The number of pairs that were set.
+inline size_t HashTable_StringSetMany(uintptr_t hTable, uintptr_t pairs) {
+    auto &table = HashTable_Get_(hTable);
+    auto fields = HashTable_UnpackFields_(pairs, 2);
+    auto count = fields.size() / 2;
+
+    table.Reserve(table.GetSize() + count);
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + HashTable_::PREFETCH_DISTANCE < count) {
+            table.Prefetch(fields[(i + HashTable_::PREFETCH_DISTANCE) * 2]);
+        }
+
+        table.Set(fields[i * 2], fields[i * 2 + 1]);
+    }
+
+    return count;
+}
+
+/// @brief Gets many string-keyed values from a hash table in one call.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param keys A MemFile holding [uint32 key size][key] records from the cursor to the end of the buffer.
+/// @param values A MemFile that receives one [uint32 value size][value] record per key at its cursor. Missing keys are written as a lone
+/// HASHTABLE_PACKED_MISSING size. This must not be the keys MemFile.
+/// @return The number of keys that were found.
+inline size_t HashTable_StringGetMany(uintptr_t hTable, uintptr_t keys, uintptr_t values) {
+    const auto &table = HashTable_Get_(hTable);
+
+    // The keys are read in place, so writing to the same MemFile would move them from under us
+    if (keys == values) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    auto fields = HashTable_UnpackFields_(keys, 1);
+    auto count = fields.size();
+    size_t found = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + HashTable_::PREFETCH_DISTANCE < count) {
+            table.Prefetch(fields[i + HashTable_::PREFETCH_DISTANCE]);
+        }
+
+        HashTable_Value_ value;
+        if (table.Find(fields[i], value)) {
+            MemFile_Write<uint32_t>(values, uint32_t(value.size()));
+            MemFile_Write(values, reinterpret_cast<uintptr_t>(value.data()), value.size());
+            ++found;
+        } else {
+            MemFile_Write<uint32_t>(values, HashTable_PackedMissing_);
+        }
+    }
+
+    return found;
+}
+
+/// @brief Removes many string keys from a hash table in one call.
+/// @param hTable A pointer (QB64 _OFFSET) to the hash table.
+/// @param keys A MemFile holding [uint32 key size][key] records from the cursor to the end of the buffer.
+/// @return The number of keys that were removed.
+inline size_t HashTable_StringRemoveMany(uintptr_t hTable, uintptr_t keys) {
+    auto &table = HashTable_Get_(hTable);
+    auto fields = HashTable_UnpackFields_(keys, 1);
+    auto count = fields.size();
+    size_t removed = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + HashTable_::PREFETCH_DISTANCE < count) {
+            table.Prefetch(fields[i + HashTable_::PREFETCH_DISTANCE]);
+        }
+
+        removed += table.Remove(fields[i]);
+    }
+
+    return removed;
+}
+
+/// @brief Converts a QB64 _OFFSET to a numeric hash table reference.
+inline HashTable_NumericMap_ &HashTable_NumericTable_(uintptr_t hTable) {
+    return *reinterpret_cast<HashTable_NumericMap_ *>(hTable);
+}
+
+/// @brief Creates a new integer-keyed hash table. Keys are 64-bit integers and values are any QB64 numeric type. Both are stored inline in the table,
+/// so lookups never allocate and only inserts that grow the table touch the heap.
+/// @return A pointer (QB64 _OFFSET) to the numeric hash table.
+inline uintptr_t HashTable_CreateNumeric() {
+    return reinterpret_cast<uintptr_t>(new HashTable_NumericMap_());
+}
+
+/// @brief Destroys a numeric hash table.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+inline void HashTable_NumericDestroy(uintptr_t hTable) {
+    delete reinterpret_cast<HashTable_NumericMap_ *>(hTable);
+}
+
+/// @brief Clears a numeric hash table.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+inline void HashTable_NumericClear(uintptr_t hTable) {
+    HashTable_NumericTable_(hTable).Clear();
+}
+
+/// @brief Gets the size of a numeric hash table.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @return The size (QB64 _OFFSET) of the numeric hash table.
+inline size_t HashTable_NumericGetSize(uintptr_t hTable) {
+    return HashTable_NumericTable_(hTable).GetSize();
+}
+
+/// @brief Gets statistics about the memory use and the health of a numeric hash table.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param stats A pointer to a HashTable_StatsType variable that receives the statistics.
+inline void HashTable_NumericGetStats_(uintptr_t hTable, uintptr_t stats) {
+    const auto &table = HashTable_NumericTable_(hTable);
+    auto &out = *reinterpret_cast<HashTable_Stats_ *>(stats);
+
+    out.size = table.GetSize();
+    out.slots = table.GetCapacity();
+    out.keyBytes = table.GetSize() * sizeof(uint64_t);
+    out.valueBytes = table.GetSize() * sizeof(uint64_t);
+    out.metadataBytes = table.GetAllocatedBytes() - out.keyBytes - out.valueBytes;
+    out.loadFactor = out.slots ? float(out.size) / float(out.slots) : 0.0f;
+    out.meanProbeLength = out.size ? float(table.GetTotalProbeLength()) / float(out.size) : 0.0f;
+    out.maxProbeLength = uint32_t(table.GetMaxProbeLength());
+    out.rehashCount = uint32_t(table.GetRehashCount());
+}
+
+/// @brief Checks if a numeric hash table is empty.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @return _TRUE if the numeric hash table is empty, _FALSE otherwise.
+inline qb_bool HashTable_NumericIsEmpty(uintptr_t hTable) {
+    return TO_QB_BOOL(HashTable_NumericTable_(hTable).GetSize() == 0);
+}
+
+/// @brief Checks if a numeric hash table contains a key.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param key The key (any QB64 integer type) to check.
+/// @return _TRUE if the numeric hash table contains the key, _FALSE otherwise.
+inline qb_bool HashTable_NumericContains(uintptr_t hTable, uint64_t key) {
+    return TO_QB_BOOL(HashTable_NumericTable_(hTable).Find(key, HashTable_NumericSlotPolicy_::Hash(key)) != HashTable_NumericMap_::NPOS);
+}
+
+/// @brief Removes a key from a numeric hash table.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param key The key (any QB64 integer type) to remove.
+/// @return _TRUE if the key was removed, _FALSE otherwise.
+inline qb_bool HashTable_NumericRemove(uintptr_t hTable, uint64_t key) {
+    return TO_QB_BOOL(HashTable_NumericTable_(hTable).Remove(key, HashTable_NumericSlotPolicy_::Hash(key)));
+}
+
+/// @brief Sets a key-value pair in a numeric hash table.
+/// @tparam T The value type.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param key The key (any QB64 integer type) to set.
+/// @param value The value (any QB64 numeric type) to set.
+template <typename T> inline void HashTable_NumericSet(uintptr_t hTable, uint64_t key, T value) {
+    static_assert(sizeof(T) <= sizeof(HashTable_NumericSlotPolicy_::Slot::value), "value type too large");
+
+    auto &table = HashTable_NumericTable_(hTable);
+    bool inserted;
+    auto &slot = table.GetSlot(table.FindOrPrepareInsert(key, HashTable_NumericSlotPolicy_::Hash(key), inserted));
+
+    slot.key = key;
+    slot.value = 0;
+    std::memcpy(&slot.value, &value, sizeof(T));
+}
+
+/// @brief Gets a value from a numeric hash table.
+/// @tparam T The value type.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param key The key (any QB64 integer type) to get.
+/// @return The value (any QB64 numeric type) associated with the key or zero if the key is not present.
+template <typename T> inline T HashTable_NumericGet(uintptr_t hTable, uint64_t key) {
+    static_assert(sizeof(T) <= sizeof(HashTable_NumericSlotPolicy_::Slot::value), "value type too large");
+
+    const auto &table = HashTable_NumericTable_(hTable);
+    auto i = table.Find(key, HashTable_NumericSlotPolicy_::Hash(key));
+    if (i == HashTable_NumericMap_::NPOS) {
+        return T();
+    }
+
+    T out;
+    std::memcpy(&out, &table.GetSlot(i).value, sizeof(T));
+    return out;
+}
+
+/// @brief Starts walking the entries of a numeric hash table in storage order. A cursor stays valid while values are updated and entries are
+/// removed. Adding entries during a walk may cause entries to be skipped or visited twice.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @return A cursor (QB64 _OFFSET) to the first entry or 0 if the table is empty.
+inline uintptr_t HashTable_NumericIterBegin(uintptr_t hTable) {
+    return HashTable_NumericTable_(hTable).NextFull(0) + 1; // NPOS + 1 wraps to 0
+}
+
+/// @brief Moves a cursor to the next entry.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param cursor A cursor returned by HashTable_NumericIterBegin() or HashTable_NumericIterNext().
+/// @return A cursor (QB64 _OFFSET) to the next entry or 0 if there are no more entries.
+inline uintptr_t HashTable_NumericIterNext(uintptr_t hTable, uintptr_t cursor) {
+    if (!cursor) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    return HashTable_NumericTable_(hTable).NextFull(cursor) + 1; // cursor is already slot + 1
+}
+
+/// @brief Returns the slot a cursor points to. Raises an error if the cursor is not valid.
+inline const HashTable_NumericSlotPolicy_::Slot &HashTable_NumericIterGet_(uintptr_t hTable, uintptr_t cursor) {
+    static const HashTable_NumericSlotPolicy_::Slot empty = {};
+
+    const auto &table = HashTable_NumericTable_(hTable);
+    if (!cursor || !table.IsFull(cursor - 1)) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return empty;
+    }
+
+    return table.GetSlot(cursor - 1);
+}
+
+/// @brief Gets the key of the entry a cursor points to.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param cursor A valid cursor.
+/// @return The key (QB64 _UNSIGNED _INTEGER64).
+inline uint64_t HashTable_NumericIterGetKey(uintptr_t hTable, uintptr_t cursor) {
+    return HashTable_NumericIterGet_(hTable, cursor).key;
+}
+
+/// @brief Gets the value of the entry a cursor points to.
+/// @tparam T The value type.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param cursor A valid cursor.
+/// @return The value (any QB64 numeric type).
+template <typename T> inline T HashTable_NumericIterGetValue(uintptr_t hTable, uintptr_t cursor) {
+    T out;
+    std::memcpy(&out, &HashTable_NumericIterGet_(hTable, cursor).value, sizeof(T));
+    return out;
+}
+
+/// @brief Sets many key-value pairs in a numeric hash table in one call.
+/// @tparam T The value type.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param keys A pointer to an array of count keys (QB64 _UNSIGNED _INTEGER64).
+/// @param values A pointer to an array of count values (any QB64 numeric type).
+/// @param count The number of elements in both arrays.
+template <typename T> inline void HashTable_NumericSetMany_(uintptr_t hTable, uintptr_t keys, uintptr_t values, size_t count) {
+    auto &table = HashTable_NumericTable_(hTable);
+    auto k = reinterpret_cast<const uint64_t *>(keys);
+    auto v = reinterpret_cast<const T *>(values);
+
+    table.Reserve(table.GetSize() + count);
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + HashTable_::PREFETCH_DISTANCE < count) {
+            table.Prefetch(HashTable_NumericSlotPolicy_::Hash(k[i + HashTable_::PREFETCH_DISTANCE]));
+        }
+
+        bool inserted;
+        auto &slot = table.GetSlot(table.FindOrPrepareInsert(k[i], HashTable_NumericSlotPolicy_::Hash(k[i]), inserted));
+        slot.key = k[i];
+        slot.value = 0;
+        std::memcpy(&slot.value, &v[i], sizeof(T));
+    }
+}
+
+/// @brief Gets many values from a numeric hash table in one call.
+/// @tparam T The value type.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param keys A pointer to an array of count keys (QB64 _UNSIGNED _INTEGER64).
+/// @param values A pointer to an array of count values (any QB64 numeric type) that receives the results. Missing keys get zero.
+/// @param count The number of elements in both arrays.
+/// @return The number of keys that were found.
+template <typename T> inline size_t HashTable_NumericGetMany_(uintptr_t hTable, uintptr_t keys, uintptr_t values, size_t count) {
+    const auto &table = HashTable_NumericTable_(hTable);
+    auto k = reinterpret_cast<const uint64_t *>(keys);
+    auto v = reinterpret_cast<T *>(values);
+    size_t found = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + HashTable_::PREFETCH_DISTANCE < count) {
+            table.Prefetch(HashTable_NumericSlotPolicy_::Hash(k[i + HashTable_::PREFETCH_DISTANCE]));
+        }
+
+        auto j = table.Find(k[i], HashTable_NumericSlotPolicy_::Hash(k[i]));
+        if (j != HashTable_NumericMap_::NPOS) {
+            std::memcpy(&v[i], &table.GetSlot(j).value, sizeof(T));
+            ++found;
+        } else {
+            v[i] = T();
+        }
+    }
+
+    return found;
+}
+
+/// @brief Removes many keys from a numeric hash table in one call.
+/// @param hTable A pointer (QB64 _OFFSET) to the numeric hash table.
+/// @param keys A pointer to an array of count keys (QB64 _UNSIGNED _INTEGER64).
+/// @param count The number of elements in the array.
+/// @return The number of keys that were removed.
+inline size_t HashTable_NumericRemoveMany_(uintptr_t hTable, uintptr_t keys, size_t count) {
+    auto &table = HashTable_NumericTable_(hTable);
+    auto k = reinterpret_cast<const uint64_t *>(keys);
+    size_t removed = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i + HashTable_::PREFETCH_DISTANCE < count) {
+            table.Prefetch(HashTable_NumericSlotPolicy_::Hash(k[i + HashTable_::PREFETCH_DISTANCE]));
+        }
+
+        removed += table.Remove(k[i], HashTable_NumericSlotPolicy_::Hash(k[i]));
+    }
+
+    return removed;
 }
@@ -82,6 +82,18 @@ FUNCTION MemFile_CreateFromString~%& (src AS STRING)
 END FUNCTION
 
 
+' Creates a MemFile that maps a file on disk into memory (nothing is copied up front)
+' If copyOnWrite is false the MemFile is read-only, else writes go to private copies of the pages and the file is never modified
+' Returns 0 if the file cannot be mapped (note that empty files cannot be mapped)
+FUNCTION MemFile_CreateFromFile~%& (fileName AS STRING, copyOnWrite AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_CreateFromFile~%& ALIAS "MemFile_CreateFromFile" (fileName AS STRING, BYVAL copyOnWrite AS _BYTE)
+    END DECLARE
+
+    MemFile_CreateFromFile = __MemFile_CreateFromFile(String_ToCStr(fileName), copyOnWrite)
+END FUNCTION
+
+
 ' Reads and returns a string of length size
 FUNCTION MemFile_ReadString$ (memFile AS _UNSIGNED _OFFSET, size AS _UNSIGNED LONG)
     DIM dst AS STRING: dst = SPACE$(size)
@@ -114,3 +126,147 @@ SUB MemFile_WriteType (memFile AS _UNSIGNED _OFFSET, typeOffset AS _UNSIGNED _OF
         ERROR _ERR_ILLEGAL_FUNCTION_CALL
     END IF
 END SUB
+
+
+' Reads as many elements of arr() as are available and returns the number of elements read. If byteSwap is true the byte order of every element is reversed
+FUNCTION MemFile_ReadArrayByte~%& (memFile AS _UNSIGNED _OFFSET, arr() AS _BYTE, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_ReadArrayByte~%& ALIAS "MemFile_ReadArray<int8_t>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL dst AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    MemFile_ReadArrayByte = __MemFile_ReadArrayByte(memFile, _OFFSET(arr(LBOUND(arr))), UBOUND(arr) - LBOUND(arr) + 1, byteSwap)
+END FUNCTION
+
+
+' Writes all elements of arr(). If byteSwap is true the byte order of every element is reversed (arr() is not modified)
+SUB MemFile_WriteArrayByte (memFile AS _UNSIGNED _OFFSET, arr() AS _BYTE, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_WriteArrayByte~%& ALIAS "MemFile_WriteArray<int8_t>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL src AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(arr) - LBOUND(arr) + 1
+
+    IF __MemFile_WriteArrayByte(memFile, _OFFSET(arr(LBOUND(arr))), count, byteSwap) <> count THEN
+        ERROR _ERR_ILLEGAL_FUNCTION_CALL
+    END IF
+END SUB
+
+
+' Reads as many elements of arr() as are available and returns the number of elements read. If byteSwap is true the byte order of every element is reversed
+FUNCTION MemFile_ReadArrayInteger~%& (memFile AS _UNSIGNED _OFFSET, arr() AS INTEGER, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_ReadArrayInteger~%& ALIAS "MemFile_ReadArray<int16_t>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL dst AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    MemFile_ReadArrayInteger = __MemFile_ReadArrayInteger(memFile, _OFFSET(arr(LBOUND(arr))), UBOUND(arr) - LBOUND(arr) + 1, byteSwap)
+END FUNCTION
+
+
+' Writes all elements of arr(). If byteSwap is true the byte order of every element is reversed (arr() is not modified)
+SUB MemFile_WriteArrayInteger (memFile AS _UNSIGNED _OFFSET, arr() AS INTEGER, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_WriteArrayInteger~%& ALIAS "MemFile_WriteArray<int16_t>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL src AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(arr) - LBOUND(arr) + 1
+
+    IF __MemFile_WriteArrayInteger(memFile, _OFFSET(arr(LBOUND(arr))), count, byteSwap) <> count THEN
+        ERROR _ERR_ILLEGAL_FUNCTION_CALL
+    END IF
+END SUB
+
+
+' Reads as many elements of arr() as are available and returns the number of elements read. If byteSwap is true the byte order of every element is reversed
+FUNCTION MemFile_ReadArrayLong~%& (memFile AS _UNSIGNED _OFFSET, arr() AS LONG, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_ReadArrayLong~%& ALIAS "MemFile_ReadArray<int32_t>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL dst AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    MemFile_ReadArrayLong = __MemFile_ReadArrayLong(memFile, _OFFSET(arr(LBOUND(arr))), UBOUND(arr) - LBOUND(arr) + 1, byteSwap)
+END FUNCTION
+
+
+' Writes all elements of arr(). If byteSwap is true the byte order of every element is reversed (arr() is not modified)
+SUB MemFile_WriteArrayLong (memFile AS _UNSIGNED _OFFSET, arr() AS LONG, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_WriteArrayLong~%& ALIAS "MemFile_WriteArray<int32_t>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL src AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(arr) - LBOUND(arr) + 1
+
+    IF __MemFile_WriteArrayLong(memFile, _OFFSET(arr(LBOUND(arr))), count, byteSwap) <> count THEN
+        ERROR _ERR_ILLEGAL_FUNCTION_CALL
+    END IF
+END SUB
+
+
+' Reads as many elements of arr() as are available and returns the number of elements read. If byteSwap is true the byte order of every element is reversed
+FUNCTION MemFile_ReadArrayInteger64~%& (memFile AS _UNSIGNED _OFFSET, arr() AS _INTEGER64, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_ReadArrayInteger64~%& ALIAS "MemFile_ReadArray<int64_t>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL dst AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    MemFile_ReadArrayInteger64 = __MemFile_ReadArrayInteger64(memFile, _OFFSET(arr(LBOUND(arr))), UBOUND(arr) - LBOUND(arr) + 1, byteSwap)
+END FUNCTION
+
+
+' Writes all elements of arr(). If byteSwap is true the byte order of every element is reversed (arr() is not modified)
+SUB MemFile_WriteArrayInteger64 (memFile AS _UNSIGNED _OFFSET, arr() AS _INTEGER64, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_WriteArrayInteger64~%& ALIAS "MemFile_WriteArray<int64_t>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL src AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(arr) - LBOUND(arr) + 1
+
+    IF __MemFile_WriteArrayInteger64(memFile, _OFFSET(arr(LBOUND(arr))), count, byteSwap) <> count THEN
+        ERROR _ERR_ILLEGAL_FUNCTION_CALL
+    END IF
+END SUB
+
+
+' Reads as many elements of arr() as are available and returns the number of elements read. If byteSwap is true the byte order of every element is reversed
+FUNCTION MemFile_ReadArraySingle~%& (memFile AS _UNSIGNED _OFFSET, arr() AS SINGLE, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_ReadArraySingle~%& ALIAS "MemFile_ReadArray<float>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL dst AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    MemFile_ReadArraySingle = __MemFile_ReadArraySingle(memFile, _OFFSET(arr(LBOUND(arr))), UBOUND(arr) - LBOUND(arr) + 1, byteSwap)
+END FUNCTION
+
+
+' Writes all elements of arr(). If byteSwap is true the byte order of every element is reversed (arr() is not modified)
+SUB MemFile_WriteArraySingle (memFile AS _UNSIGNED _OFFSET, arr() AS SINGLE, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_WriteArraySingle~%& ALIAS "MemFile_WriteArray<float>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL src AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(arr) - LBOUND(arr) + 1
+
+    IF __MemFile_WriteArraySingle(memFile, _OFFSET(arr(LBOUND(arr))), count, byteSwap) <> count THEN
+        ERROR _ERR_ILLEGAL_FUNCTION_CALL
+    END IF
+END SUB
+
+
+' Reads as many elements of arr() as are available and returns the number of elements read. If byteSwap is true the byte order of every element is reversed
+FUNCTION MemFile_ReadArrayDouble~%& (memFile AS _UNSIGNED _OFFSET, arr() AS DOUBLE, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_ReadArrayDouble~%& ALIAS "MemFile_ReadArray<double>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL dst AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    MemFile_ReadArrayDouble = __MemFile_ReadArrayDouble(memFile, _OFFSET(arr(LBOUND(arr))), UBOUND(arr) - LBOUND(arr) + 1, byteSwap)
+END FUNCTION
+
+
+' Writes all elements of arr(). If byteSwap is true the byte order of every element is reversed (arr() is not modified)
+SUB MemFile_WriteArrayDouble (memFile AS _UNSIGNED _OFFSET, arr() AS DOUBLE, byteSwap AS _BYTE)
+    DECLARE LIBRARY "MemFile"
+        FUNCTION __MemFile_WriteArrayDouble~%& ALIAS "MemFile_WriteArray<double>" (BYVAL memFile AS _UNSIGNED _OFFSET, BYVAL src AS _UNSIGNED _OFFSET, BYVAL count AS _UNSIGNED _OFFSET, BYVAL byteSwap AS _BYTE)
+    END DECLARE
+
+    DIM count AS _UNSIGNED _OFFSET: count = UBOUND(arr) - LBOUND(arr) + 1
+
+    IF __MemFile_WriteArrayDouble(memFile, _OFFSET(arr(LBOUND(arr))), count, byteSwap) <> count THEN
+        ERROR _ERR_ILLEGAL_FUNCTION_CALL
+    END IF
+END SUB
@@ -7,16 +7,247 @@
 
 #include "../Core/Types.h"
 #include "../Debug/Debug.h"
+#include "../IO/MappedFile.h"
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <memory>
 #include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MEMFILE_USE_SSE2 1
+#endif
+
+/// @brief The storage behind a MemFile. Storage is a contiguous run of bytes unless IsContiguous() says otherwise, in which case it must
+/// override Read() and Write().
+class MemFile_Store_ {
+  public:
+    virtual ~MemFile_Store_() = default;
+
+    virtual bool IsContiguous() const {
+        return true;
+    }
+
+    /// @brief Returns the bytes of contiguous storage.
+    virtual const uint8_t *GetData() const = 0;
+
+    /// @brief Returns the bytes of contiguous storage for writing, or nullptr if the storage is read-only.
+    virtual uint8_t *GetWritableData() = 0;
+
+    virtual size_t GetSize() const = 0;
+
+    /// @brief Changes the size of the storage.
+    /// @return False if the storage cannot change size.
+    virtual bool Resize(size_t newSize) = 0;
+
+    /// @brief Returns true if the storage is a private copy of something else that may be replaced by a buffer when it needs to change size.
+    virtual bool IsCopyOnWrite() const {
+        return false;
+    }
+
+    /// @brief Returns true if data can only be added at the end (and GetSize() grows as it is written).
+    virtual bool IsAppendOnly() const {
+        return false;
+    }
+
+    /// @brief Makes a range of bytes available to Read(). Storage that produces data on demand (streams) overrides this.
+    /// @return The number of bytes from position that can be read. This is less than size near the end of the data.
+    virtual size_t MakeReadable(size_t position, size_t size) {
+        return position < GetSize() ? std::min(size, GetSize() - position) : 0;
+    }
+
+    /// @brief Copies bytes out of the storage. The range must have been made readable.
+    virtual void Read(size_t position, uint8_t *dst, size_t size) const {
+        std::memcpy(dst, GetData() + position, size);
+    }
+
+    /// @brief Copies bytes into the storage. The range must be inside the storage.
+    /// @return False if the storage is read-only.
+    virtual bool Write(size_t position, const uint8_t *src, size_t size) {
+        auto dst = GetWritableData();
+        if (!dst)
+            return false;
+
+        std::memcpy(dst + position, src, size);
+        return true;
+    }
+};
+
+/// @brief Growable storage owned by the MemFile.
+class MemFile_BufferStore_ : public MemFile_Store_ {
+  public:
+    MemFile_BufferStore_(const uint8_t *data, size_t size) : buffer(data, data + size) {}
+
+    explicit MemFile_BufferStore_(std::vector<uint8_t> &&buffer) : buffer(std::move(buffer)) {}
+
+    const uint8_t *GetData() const override {
+        return buffer.data();
+    }
+
+    uint8_t *GetWritableData() override {
+        return buffer.data();
+    }
+
+    size_t GetSize() const override {
+        return buffer.size();
+    }
+
+    bool Resize(size_t newSize) override {
+        buffer.resize(newSize);
+        return true;
+    }
+
+  private:
+    std::vector<uint8_t> buffer;
+};
+
+/// @brief Storage that is a memory-mapped file. Pages are loaded by the OS when they are first touched.
+class MemFile_MappedStore_ : public MemFile_Store_ {
+  public:
+    bool Open(const char *fileName, bool copyOnWrite) {
+        return file.Open(fileName, copyOnWrite);
+    }
+
+    const uint8_t *GetData() const override {
+        return file.GetData();
+    }
+
+    uint8_t *GetWritableData() override {
+        return file.GetWritableData();
+    }
+
+    size_t GetSize() const override {
+        return file.GetSize();
+    }
+
+    bool Resize(size_t newSize) override {
+        return newSize == file.GetSize();
+    }
+
+    bool IsCopyOnWrite() const override {
+        return file.GetWritableData() != nullptr;
+    }
+
+  private:
+    MappedFile_ file;
+};
+
+/// @brief Growable storage made of fixed-size chunks. Growing never moves existing bytes, so appending costs the same however large the
+/// file gets.
+class MemFile_ChunkedStore_ : public MemFile_Store_ {
+  public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 65536;
+
+    /// @param chunkSize The chunk size in bytes. This is rounded up to a power of two.
+    explicit MemFile_ChunkedStore_(size_t chunkSize) : chunkShift(0), size(0) {
+        while ((size_t(1) << chunkShift) < chunkSize)
+            ++chunkShift;
+    }
+
+    bool IsContiguous() const override {
+        return false;
+    }
+
+    const uint8_t *GetData() const override {
+        return nullptr;
+    }
+
+    uint8_t *GetWritableData() override {
+        return nullptr;
+    }
+
+    size_t GetSize() const override {
+        return size;
+    }
+
+    bool Resize(size_t newSize) override {
+        auto chunkSize = GetChunkSize();
+        auto chunkCount = (newSize + chunkSize - 1) >> chunkShift;
+
+        if (newSize > size) {
+            // The tail of the last chunk may hold bytes from before a shrink
+            auto capacity = chunks.size() << chunkShift;
+            if (size < capacity)
+                std::memset(chunks.back().get() + (size & (chunkSize - 1)), 0, std::min(newSize, capacity) - size);
+
+            while (chunks.size() < chunkCount)
+                chunks.emplace_back(new uint8_t[chunkSize]());
+        } else {
+            chunks.resize(chunkCount);
+        }
+
+        size = newSize;
+        return true;
+    }
+
+    void Read(size_t position, uint8_t *dst, size_t size) const override {
+        while (size) {
+            auto offset = position & (GetChunkSize() - 1);
+            auto count = std::min(size, GetChunkSize() - offset);
+            std::memcpy(dst, chunks[position >> chunkShift].get() + offset, count);
+            position += count;
+            dst += count;
+            size -= count;
+        }
+    }
+
+    bool Write(size_t position, const uint8_t *src, size_t size) override {
+        while (size) {
+            auto offset = position & (GetChunkSize() - 1);
+            auto count = std::min(size, GetChunkSize() - offset);
+            std::memcpy(chunks[position >> chunkShift].get() + offset, src, count);
+            position += count;
+            src += count;
+            size -= count;
+        }
+
+        return true;
+    }
+
+  private:
+    size_t GetChunkSize() const {
+        return size_t(1) << chunkShift;
+    }
+
+    std::vector<std::unique_ptr<uint8_t[]>> chunks;
+    size_t chunkShift;
+    size_t size;
+};
+
+/// @brief Bit reader / writer state of a MemFile. The reader pulls whole bytes from the cursor into a 64-bit buffer, so the cursor runs
+/// ahead of the bits that have been consumed
+struct MemFile_BitState_ {
+    uint64_t readBuffer = 0;  // bits that have been read from the store but not consumed
+    uint32_t readCount = 0;   // number of valid bits in readBuffer
+    uint64_t writeBuffer = 0; // bits that have been written but not stored
+    uint32_t writeCount = 0;  // number of valid bits in writeBuffer
+    bool msbFirst = false;    // bit order (false: LSB-first like GIF and Deflate, true: MSB-first like JPEG and MPEG)
+};
 
 /// @brief A pointer to an object of this struct is returned by MemFile_Create()
 struct MemFile {
-    std::vector<uint8_t> buffer; // a std::vector of bytes
-    size_t cursor;               // the current read / write position in the vector
+    std::unique_ptr<MemFile_Store_> store; // the bytes of the file
+    size_t cursor;                         // the current read / write position in the store
+    MemFile_BitState_ bits;                // used by the MemFile_*Bits() functions
 };
 
+/// @brief Changes the size of a MemFile's storage. A copy-on-write mapping that needs to change size is copied to a buffer first
+/// @param memFile A valid pointer to a MemFile object
+/// @param newSize The new size of the storage
+/// @return False if the storage is read-only
+inline bool MemFile_ResizeStore_(MemFile *memFile, size_t newSize) {
+    auto &store = memFile->store;
+
+    if (store->Resize(newSize))
+        return true;
+
+    if (!store->IsCopyOnWrite())
+        return false;
+
+    store = std::make_unique<MemFile_BufferStore_>(store->GetData(), std::min(store->GetSize(), newSize));
+    return store->Resize(newSize);
+}
+
 /// @brief Creates a new MemFile object using an existing memory buffer
 /// @param data A valid data buffer or nullptr
 /// @param size The correct size of the data if data is not nullptr
@@ -25,7 +256,40 @@ uintptr_t MemFile_Create(uintptr_t data, size_t size) {
     auto memFile = new MemFile;
 
     if (memFile) {
-        memFile->buffer.assign(reinterpret_cast<const uint8_t *>(data), reinterpret_cast<const uint8_t *>(data) + size);
+        memFile->store = std::make_unique<MemFile_BufferStore_>(reinterpret_cast<const uint8_t *>(data), data ? size : 0);
+        memFile->cursor = 0;
+    }
+
+    return reinterpret_cast<uintptr_t>(memFile);
+}
+
+/// @brief Creates a new MemFile object that maps a file on disk into memory. Nothing is copied and the file is read lazily as it is accessed
+/// @param fileName The file name (NUL terminated)
+/// @param copyOnWrite If false the MemFile is read-only. If true writes are allowed and go to private copies of the touched pages (the
+/// file is never modified). Writes that change the size copy the whole file into memory
+/// @return A pointer to a new MemFile or nullptr on failure. Empty files cannot be mapped
+uintptr_t MemFile_CreateFromFile(const char *fileName, qb_bool copyOnWrite) {
+    auto store = std::make_unique<MemFile_MappedStore_>();
+
+    if (!store->Open(fileName, copyOnWrite))
+        return 0;
+
+    auto memFile = new MemFile;
+    memFile->store = std::move(store);
+    memFile->cursor = 0;
+
+    return reinterpret_cast<uintptr_t>(memFile);
+}
+
+/// @brief Creates a new empty MemFile object that stores its data in fixed-size chunks. Use this when building large files with many small
+/// writes. Call MemFile_Flatten() when done if the data is needed as one contiguous block
+/// @param chunkSize The chunk size in bytes (rounded up to a power of two). Zero selects the default (64 KiB)
+/// @return A pointer to a new MemFile or nullptr on failure
+uintptr_t MemFile_CreateChunked(size_t chunkSize) {
+    auto memFile = new MemFile;
+
+    if (memFile) {
+        memFile->store = std::make_unique<MemFile_ChunkedStore_>(chunkSize ? chunkSize : MemFile_ChunkedStore_::DEFAULT_CHUNK_SIZE);
         memFile->cursor = 0;
     }
 
@@ -45,10 +309,10 @@ void MemFile_Destroy(uintptr_t p) {
 /// @param p A valid pointer to a MemFile object
 /// @return QB_TRUE if EOF, QB_FALSE otherwise
 qb_bool MemFile_IsEOF(uintptr_t p) {
-    auto memFile = reinterpret_cast<const MemFile *>(p);
+    auto memFile = reinterpret_cast<MemFile *>(p);
 
     if (memFile)
-        return TO_QB_BOOL(memFile->cursor >= memFile->buffer.size());
+        return TO_QB_BOOL(!memFile->store->MakeReadable(memFile->cursor, 1));
 
     error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
     return QB_FALSE;
@@ -56,12 +320,12 @@ qb_bool MemFile_IsEOF(uintptr_t p) {
 
 /// @brief Returns the size of the buffer in bytes
 /// @param p A valid pointer to a MemFile object
-/// @return The size of the buffer in bytes
+/// @return The size of the buffer in bytes. For an inflate stream this is the number of bytes decompressed so far
 size_t MemFile_GetSize(uintptr_t p) {
     auto memFile = reinterpret_cast<const MemFile *>(p);
 
     if (memFile)
-        return memFile->buffer.size();
+        return memFile->store->GetSize();
 
     error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
     return 0;
@@ -80,16 +344,44 @@ size_t MemFile_GetPosition(uintptr_t p) {
     return 0;
 }
 
-/// @brief Position the read / write cursor inside the data buffer
+/// @brief Position the read / write cursor inside the data buffer. Any buffered bit reader bits are discarded
 /// @param p A valid pointer to a MemFile object
 /// @param position A value that is less than or equal to the size of the buffer
 void MemFile_Seek(uintptr_t p, size_t position) {
     auto memFile = reinterpret_cast<MemFile *>(p);
 
-    if (memFile && position <= memFile->buffer.size())
+    if (memFile && (position <= memFile->store->GetSize() || memFile->store->MakeReadable(position - 1, 1))) {
         memFile->cursor = position;
-    else
+        memFile->bits.readBuffer = 0;
+        memFile->bits.readCount = 0;
+    } else
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+}
+
+/// @brief Copies the data of a chunked MemFile or an inflate stream into one contiguous buffer. Later writes grow the buffer like a MemFile from MemFile_Create().
+/// This does nothing if the data is already contiguous
+/// @param p A valid pointer to a MemFile object
+void MemFile_Flatten(uintptr_t p) {
+    auto memFile = reinterpret_cast<MemFile *>(p);
+
+    if (memFile) {
+        if (!memFile->store->IsContiguous()) {
+            // Streams only know their size once all data has been produced, so the data is pulled in pieces
+            constexpr size_t PIECE_SIZE = 65536;
+            std::vector<uint8_t> buffer;
+
+            for (size_t bytes; (bytes = memFile->store->MakeReadable(buffer.size(), PIECE_SIZE)) != 0;) {
+                auto position = buffer.size();
+                buffer.resize(position + bytes);
+                memFile->store->Read(position, buffer.data() + position, bytes);
+            }
+
+            memFile->store = std::make_unique<MemFile_BufferStore_>(std::move(buffer));
+            memFile->cursor = std::min(memFile->cursor, memFile->store->GetSize());
+        }
+    } else {
         error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
 }
 
 /// @brief Resizes the buffer of a MemFile object
@@ -98,9 +390,7 @@ void MemFile_Seek(uintptr_t p, size_t position) {
 void MemFile_Resize(uintptr_t p, size_t newSize) {
     auto memFile = reinterpret_cast<MemFile *>(p);
 
-    if (memFile) {
-        memFile->buffer.resize(newSize);
-
+    if (memFile && MemFile_ResizeStore_(memFile, newSize)) {
         if (memFile->cursor > newSize)
             memFile->cursor = newSize;
     } else {
@@ -117,9 +407,9 @@ size_t MemFile_Read(uintptr_t p, uintptr_t data, size_t size) {
     auto memFile = reinterpret_cast<MemFile *>(p);
 
     if (memFile && data) {
-        auto bytesToRead = std::min(size, memFile->buffer.size() - memFile->cursor);
+        auto bytesToRead = memFile->store->MakeReadable(memFile->cursor, size);
         if (bytesToRead > 0) {
-            std::copy(memFile->buffer.begin() + memFile->cursor, memFile->buffer.begin() + memFile->cursor + bytesToRead, (uint8_t *)data);
+            memFile->store->Read(memFile->cursor, reinterpret_cast<uint8_t *>(data), bytesToRead);
             memFile->cursor += bytesToRead;
         }
 
@@ -135,17 +425,19 @@ size_t MemFile_Read(uintptr_t p, uintptr_t data, size_t size) {
 /// @param p A valid pointer to a MemFile object
 /// @param data Pointer to the buffer the data needs to be read from
 /// @param size The size of the chunk that needs to be written
-/// @return The number of bytes written
+/// @return The number of bytes written. This is zero if the MemFile is read-only
 size_t MemFile_Write(uintptr_t p, uintptr_t data, size_t size) {
     auto memFile = reinterpret_cast<MemFile *>(p);
 
     if (memFile && data) {
         // Resize the buffer if needed
-        if (memFile->cursor + size > memFile->buffer.size())
-            memFile->buffer.resize(memFile->cursor + size);
+        if (memFile->cursor + size > memFile->store->GetSize() && !memFile->store->IsAppendOnly() &&
+            !MemFile_ResizeStore_(memFile, memFile->cursor + size))
+            return 0;
 
         // Copy the data to the buffer
-        std::copy((uint8_t *)data, (uint8_t *)data + size, memFile->buffer.begin() + memFile->cursor);
+        if (!memFile->store->Write(memFile->cursor, reinterpret_cast<const uint8_t *>(data), size))
+            return 0;
 
         // Move the cursor
         memFile->cursor += size;
@@ -192,3 +484,1137 @@ template <typename T> inline void MemFile_Write(uintptr_t p, T value) {
 #define MemFile_WriteInteger64(p, qword) MemFile_Write<uint64_t>((p), (qword))
 #define MemFile_ReadDouble(p) MemFile_Read<double>(p)
 #define MemFile_WriteDouble(p, fp64) MemFile_Write<double>((p), (fp64))
+
+/// @brief Reverses the byte order of every element of an array in place
+/// @tparam ELEMENT_SIZE The element size in bytes (1, 2, 4 or 8)
+/// @param data The array. This does not need to be aligned
+/// @param count The number of elements
+template <size_t ELEMENT_SIZE> inline void MemFile_ByteSwap_(uint8_t *data, size_t count) {
+    static_assert(ELEMENT_SIZE == 1 || ELEMENT_SIZE == 2 || ELEMENT_SIZE == 4 || ELEMENT_SIZE == 8, "unsupported element size");
+
+    if constexpr (ELEMENT_SIZE > 1) {
+        auto end = data + count * ELEMENT_SIZE;
+
+#ifdef MEMFILE_USE_SSE2
+        // Words are reordered inside each element with 16-bit shuffles and then the two bytes of every word are swapped
+        for (; end - data >= 16; data += 16) {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+            if constexpr (ELEMENT_SIZE == 4) {
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+            } else if constexpr (ELEMENT_SIZE == 8) {
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+            }
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(data), v);
+        }
+#endif
+
+        for (; data < end; data += ELEMENT_SIZE) {
+            if constexpr (ELEMENT_SIZE == 2) {
+                uint16_t x;
+                std::memcpy(&x, data, sizeof(x));
+                x = __builtin_bswap16(x);
+                std::memcpy(data, &x, sizeof(x));
+            } else if constexpr (ELEMENT_SIZE == 4) {
+                uint32_t x;
+                std::memcpy(&x, data, sizeof(x));
+                x = __builtin_bswap32(x);
+                std::memcpy(data, &x, sizeof(x));
+            } else {
+                uint64_t x;
+                std::memcpy(&x, data, sizeof(x));
+                x = __builtin_bswap64(x);
+                std::memcpy(data, &x, sizeof(x));
+            }
+        }
+    }
+}
+
+/// @brief Reads an array of values from the buffer at the cursor position. Only whole elements are read
+/// @tparam T A 1, 2, 4 or 8 byte C++ type
+/// @param p A valid pointer to a MemFile object
+/// @param data Pointer to the first element of the array
+/// @param count The number of elements to read
+/// @param byteSwap If true, the byte order of every element is reversed (e.g. to read big-endian data)
+/// @return The number of elements read. This can be less than `count`
+template <typename T> inline size_t MemFile_ReadArray(uintptr_t p, uintptr_t data, size_t count, qb_bool byteSwap) {
+    auto memFile = reinterpret_cast<MemFile *>(p);
+
+    if (memFile && data) {
+        count = memFile->store->MakeReadable(memFile->cursor, count * sizeof(T)) / sizeof(T);
+        MemFile_Read(p, data, count * sizeof(T));
+
+        if (byteSwap)
+            MemFile_ByteSwap_<sizeof(T)>(reinterpret_cast<uint8_t *>(data), count);
+
+        return count;
+    } else {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+
+    return 0;
+}
+
+/// @brief Writes an array of values to the buffer at the cursor position (optionally growing the buffer size)
+/// @tparam T A 1, 2, 4 or 8 byte C++ type
+/// @param p A valid pointer to a MemFile object
+/// @param data Pointer to the first element of the array. The array is not modified
+/// @param count The number of elements to write
+/// @param byteSwap If true, the byte order of every element is reversed (e.g. to write big-endian data)
+/// @return The number of elements written. This is zero if the MemFile is read-only
+template <typename T> inline size_t MemFile_WriteArray(uintptr_t p, uintptr_t data, size_t count, qb_bool byteSwap) {
+    if (!byteSwap)
+        return MemFile_Write(p, data, count * sizeof(T)) / sizeof(T);
+
+    auto memFile = reinterpret_cast<MemFile *>(p);
+
+    if (memFile && data) {
+        // Swap through a small block so that the source array is left alone
+        constexpr size_t BLOCK_ELEMENTS = 4096 / sizeof(T);
+        uint8_t block[BLOCK_ELEMENTS * sizeof(T)];
+        auto src = reinterpret_cast<const uint8_t *>(data);
+        size_t written = 0;
+
+        while (written < count) {
+            auto elements = std::min(count - written, BLOCK_ELEMENTS);
+            std::memcpy(block, src + written * sizeof(T), elements * sizeof(T));
+            MemFile_ByteSwap_<sizeof(T)>(block, elements);
+
+            if (MemFile_Write(p, reinterpret_cast<uintptr_t>(block), elements * sizeof(T)) != elements * sizeof(T))
+                break;
+
+            written += elements;
+        }
+
+        return written;
+    } else {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+
+    return 0;
+}
+
+/// @brief Tops up the bit reader buffer with as many whole bytes from the cursor as fit
+/// @param memFile A valid pointer to a MemFile object
+inline void MemFile_RefillBits_(MemFile *memFile) {
+    auto &bits = memFile->bits;
+    auto bytes = memFile->store->MakeReadable(memFile->cursor, size_t(64 - bits.readCount) >> 3);
+    if (!bytes)
+        return;
+
+    uint8_t data[8];
+    memFile->store->Read(memFile->cursor, data, bytes);
+    memFile->cursor += bytes;
+
+    for (size_t i = 0; i < bytes; i++, bits.readCount += 8) {
+        if (bits.msbFirst)
+            bits.readBuffer |= uint64_t(data[i]) << (56 - bits.readCount);
+        else
+            bits.readBuffer |= uint64_t(data[i]) << bits.readCount;
+    }
+}
+
+/// @brief Returns the next bits without consuming them. Bits past the end of the file read as zero
+/// @param p A valid pointer to a MemFile object
+/// @param count The number of bits (0 - 32)
+/// @return The bits. For MSB-first order the first bit is the most significant bit of the result
+uint32_t MemFile_PeekBits(uintptr_t p, uint32_t count) {
+    auto memFile = reinterpret_cast<MemFile *>(p);
+
+    if (memFile && count <= 32) {
+        if (!count)
+            return 0;
+
+        auto &bits = memFile->bits;
+        if (bits.readCount < count)
+            MemFile_RefillBits_(memFile);
+
+        if (bits.msbFirst)
+            return uint32_t(bits.readBuffer >> (64 - count));
+        else
+            return uint32_t(bits.readBuffer & ((uint64_t(1) << count) - 1));
+    } else {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+
+    return 0;
+}
+
+/// @brief Consumes bits. Skipping past the end of the file is an error
+/// @param p A valid pointer to a MemFile object
+/// @param count The number of bits (0 - 32)
+void MemFile_SkipBits(uintptr_t p, uint32_t count) {
+    auto memFile = reinterpret_cast<MemFile *>(p);
+
+    if (memFile && count <= 32) {
+        auto &bits = memFile->bits;
+        if (bits.readCount < count) {
+            MemFile_RefillBits_(memFile);
+
+            if (bits.readCount < count) {
+                error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+                return;
+            }
+        }
+
+        if (bits.msbFirst)
+            bits.readBuffer <<= count;
+        else
+            bits.readBuffer >>= count;
+
+        bits.readCount -= count;
+    } else {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+}
+
+/// @brief Reads and consumes bits. Reading past the end of the file is an error
+/// @param p A valid pointer to a MemFile object
+/// @param count The number of bits (0 - 32)
+/// @return The bits. For MSB-first order the first bit is the most significant bit of the result
+uint32_t MemFile_ReadBits(uintptr_t p, uint32_t count) {
+    auto value = MemFile_PeekBits(p, count);
+    MemFile_SkipBits(p, count);
+
+    return value;
+}
+
+/// @brief Drops the bits that are left in the current byte and moves the cursor back to the first unread byte, so that the byte based
+/// MemFile functions can be used again
+/// @param p A valid pointer to a MemFile object
+void MemFile_AlignBits(uintptr_t p) {
+    auto memFile = reinterpret_cast<MemFile *>(p);
+
+    if (memFile) {
+        memFile->cursor -= memFile->bits.readCount >> 3;
+        memFile->bits.readBuffer = 0;
+        memFile->bits.readCount = 0;
+    } else {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+}
+
+/// @brief Stores the whole bytes of the bit writer buffer at the cursor position
+/// @param memFile A valid pointer to a MemFile object
+inline void MemFile_StoreBits_(MemFile *memFile) {
+    auto &bits = memFile->bits;
+    auto bytes = bits.writeCount >> 3;
+    if (!bytes)
+        return;
+
+    uint8_t data[8];
+    for (uint32_t i = 0; i < bytes; i++, bits.writeCount -= 8) {
+        if (bits.msbFirst) {
+            data[i] = uint8_t(bits.writeBuffer >> (bits.writeCount - 8));
+        } else {
+            data[i] = uint8_t(bits.writeBuffer);
+            bits.writeBuffer >>= 8;
+        }
+    }
+
+    if (MemFile_Write(reinterpret_cast<uintptr_t>(memFile), reinterpret_cast<uintptr_t>(data), bytes) != bytes)
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+}
+
+/// @brief Writes bits. Whole bytes are stored at the cursor position as they fill up. Call MemFile_FlushBits() after the last write
+/// @param p A valid pointer to a MemFile object
+/// @param value The bits (in the low bits of value)
+/// @param count The number of bits (0 - 32)
+void MemFile_WriteBits(uintptr_t p, uint32_t value, uint32_t count) {
+    auto memFile = reinterpret_cast<MemFile *>(p);
+
+    if (memFile && count <= 32) {
+        auto &bits = memFile->bits;
+        auto masked = count < 32 ? value & ((uint32_t(1) << count) - 1) : value;
+
+        if (bits.msbFirst)
+            bits.writeBuffer = (bits.writeBuffer << count) | masked;
+        else
+            bits.writeBuffer |= uint64_t(masked) << bits.writeCount;
+
+        bits.writeCount += count;
+
+        if (bits.writeCount >= 32)
+            MemFile_StoreBits_(memFile);
+    } else {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+}
+
+/// @brief Stores all pending bit writer bits. A partial last byte is padded with zero bits
+/// @param p A valid pointer to a MemFile object
+void MemFile_FlushBits(uintptr_t p) {
+    auto memFile = reinterpret_cast<MemFile *>(p);
+
+    if (memFile) {
+        auto &bits = memFile->bits;
+        auto padding = (8 - (bits.writeCount & 7)) & 7;
+
+        if (bits.msbFirst)
+            bits.writeBuffer <<= padding;
+
+        bits.writeCount += padding;
+        MemFile_StoreBits_(memFile);
+        bits.writeBuffer = 0;
+    } else {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+}
+
+/// @brief Sets the bit order used by the MemFile_*Bits() functions. The reader is aligned like MemFile_AlignBits() and pending writer bits
+/// are flushed
+/// @param p A valid pointer to a MemFile object
+/// @param msbFirst QB_FALSE for LSB-first (GIF, Deflate), QB_TRUE for MSB-first (JPEG, MPEG)
+void MemFile_SetBitOrder(uintptr_t p, qb_bool msbFirst) {
+    auto memFile = reinterpret_cast<MemFile *>(p);
+
+    if (memFile) {
+        MemFile_FlushBits(p);
+        MemFile_AlignBits(p);
+        memFile->bits.msbFirst = msbFirst;
+    } else {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+}
+
+/// @brief Deflate (RFC 1951) tables shared by the inflate and deflate streams
+struct MemFile_Deflate_ {
+    static constexpr size_t HISTORY_SIZE = 32768; // the largest distance a match can reach back
+    static constexpr size_t MIN_MATCH = 3;
+    static constexpr size_t MAX_MATCH = 258;
+    static constexpr uint32_t END_OF_BLOCK = 256;
+
+    static constexpr uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static constexpr uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    static constexpr uint16_t DISTANCE_BASE[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,    65,    97,    129,
+                                                   193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    static constexpr uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    /// @brief Updates an Adler-32 checksum (the zlib stream checksum)
+    static uint32_t Adler32(uint32_t adler, const uint8_t *data, size_t size) {
+        constexpr uint32_t MOD_ADLER = 65521;
+        constexpr size_t MAX_RUN = 5552; // the largest run that cannot overflow 32 bits
+
+        uint32_t a = adler & 0xFFFF, b = adler >> 16;
+
+        while (size) {
+            auto run = std::min(size, MAX_RUN);
+            size -= run;
+
+            while (run--) {
+                a += *data++;
+                b += a;
+            }
+
+            a %= MOD_ADLER;
+            b %= MOD_ADLER;
+        }
+
+        return (b << 16) | a;
+    }
+
+    static uint32_t ReverseBits(uint32_t code, uint32_t length) {
+        uint32_t reversed = 0;
+
+        for (uint32_t i = 0; i < length; i++, code >>= 1)
+            reversed = (reversed << 1) | (code & 1);
+
+        return reversed;
+    }
+};
+
+/// @brief A canonical Huffman decoding table. Codes of up to FAST_BITS bits are decoded with one lookup, longer ones bit by bit
+struct MemFile_HuffmanTable_ {
+    static constexpr uint32_t MAX_BITS = 15;
+    static constexpr uint32_t FAST_BITS = 10;
+    static constexpr uint32_t MAX_SYMBOLS = 288;
+
+    uint16_t fast[1u << FAST_BITS]; // (length << 9) | symbol, or 0 if the code is longer than FAST_BITS
+    uint16_t counts[MAX_BITS + 1];  // number of codes of each length
+    uint16_t symbols[MAX_SYMBOLS];  // symbols ordered by code
+
+    /// @brief Builds the table from a list of code lengths
+    /// @return False if the code lengths are over-subscribed
+    bool Build(const uint8_t *lengths, uint32_t count) {
+        std::fill(std::begin(fast), std::end(fast), uint16_t(0));
+        std::fill(std::begin(counts), std::end(counts), uint16_t(0));
+
+        for (uint32_t i = 0; i < count; i++)
+            counts[lengths[i]]++;
+        counts[0] = 0;
+
+        uint16_t offsets[MAX_BITS + 2] = {};
+        int32_t left = 1;
+        for (uint32_t length = 1; length <= MAX_BITS; length++) {
+            left = (left << 1) - counts[length];
+            if (left < 0)
+                return false;
+
+            offsets[length + 1] = offsets[length] + counts[length];
+        }
+
+        uint32_t code = 0, nextCode[MAX_BITS + 1] = {};
+        for (uint32_t length = 1; length <= MAX_BITS; length++) {
+            code = (code + counts[length - 1]) << 1;
+            nextCode[length] = code;
+        }
+
+        for (uint32_t symbol = 0; symbol < count; symbol++) {
+            auto length = lengths[symbol];
+            if (!length)
+                continue;
+
+            symbols[offsets[length]++] = uint16_t(symbol);
+
+            if (length <= FAST_BITS) {
+                // The stream is read LSB-first but codes are stored MSB-first, so the table is indexed by the reversed code
+                auto reversed = MemFile_Deflate_::ReverseBits(nextCode[length], length);
+                for (auto i = reversed; i < (1u << FAST_BITS); i += 1u << length)
+                    fast[i] = uint16_t((length << 9) | symbol);
+            }
+
+            nextCode[length]++;
+        }
+
+        return true;
+    }
+};
+
+/// @brief The literal/length and distance tables of the fixed Huffman codes used by block type 1
+struct MemFile_FixedHuffmanTables_ {
+    MemFile_HuffmanTable_ literals;
+    MemFile_HuffmanTable_ distances;
+
+    /// @brief Returns the fixed Huffman tables. These are built once on first use
+    static const MemFile_FixedHuffmanTables_ &Get() {
+        static const auto fixed = [] {
+            uint8_t lengths[MemFile_HuffmanTable_::MAX_SYMBOLS + 30];
+            std::fill(lengths, lengths + 144, uint8_t(8));
+            std::fill(lengths + 144, lengths + 256, uint8_t(9));
+            std::fill(lengths + 256, lengths + 280, uint8_t(7));
+            std::fill(lengths + 280, lengths + 288, uint8_t(8));
+            std::fill(lengths + 288, lengths + 318, uint8_t(5));
+
+            MemFile_FixedHuffmanTables_ tables;
+            tables.literals.Build(lengths, 288);
+            tables.distances.Build(lengths + 288, 30);
+
+            return tables;
+        }();
+
+        return fixed;
+    }
+};
+
+/// @brief Read-only storage that decompresses a Deflate or zlib stream from another MemFile as data is read. Only the last HISTORY_SIZE bytes
+/// and the bytes being read are kept in memory. Seeking backwards restarts decompression from the beginning
+class MemFile_InflateStore_ : public MemFile_Store_ {
+  public:
+    /// @param source The MemFile holding the compressed data. The stream starts at its cursor. The source must outlive the stream
+    explicit MemFile_InflateStore_(MemFile *source) : source(source), sourceStart(source->cursor) {
+        Restart();
+    }
+
+    bool IsContiguous() const override {
+        return false;
+    }
+
+    const uint8_t *GetData() const override {
+        return nullptr;
+    }
+
+    uint8_t *GetWritableData() override {
+        return nullptr;
+    }
+
+    size_t GetSize() const override {
+        return bufferStart + buffer.size();
+    }
+
+    bool Resize(size_t newSize) override {
+        (void)newSize;
+        return false;
+    }
+
+    bool Write(size_t position, const uint8_t *src, size_t size) override {
+        (void)position;
+        (void)src;
+        (void)size;
+        return false;
+    }
+
+    size_t MakeReadable(size_t position, size_t size) override {
+        if (position < bufferStart)
+            Restart();
+
+        auto end = size < SIZE_MAX - position ? position + size : SIZE_MAX;
+
+        while (GetSize() < end && state != State::DONE) {
+            Discard(position);
+            Decode(std::min(end, GetSize() + DECODE_STEP));
+        }
+
+        return position < GetSize() ? std::min(size, GetSize() - position) : 0;
+    }
+
+    void Read(size_t position, uint8_t *dst, size_t size) const override {
+        std::memcpy(dst, buffer.data() + (position - bufferStart), size);
+    }
+
+  private:
+    static constexpr size_t DECODE_STEP = 65536; // output produced between checks for bytes that can be dropped
+    static constexpr size_t INPUT_SIZE = 4096;
+
+    enum class State { STREAM_HEADER, BLOCK_HEADER, STORED, HUFFMAN, DONE };
+
+    /// @brief Goes back to the start of the compressed data
+    void Restart() {
+        buffer.clear();
+        bufferStart = 0;
+        sourcePosition = sourceStart;
+        inputPosition = inputSize = 0;
+        bitBuffer = 0;
+        bitCount = 0;
+        state = State::STREAM_HEADER;
+        isLastBlock = false;
+        isZlib = false;
+        adler = 1;
+        literalCodes = &literalTable;
+        distanceCodes = &distanceTable;
+    }
+
+    /// @brief Drops decoded bytes that are before position and outside the history window
+    void Discard(size_t position) {
+        auto keepFrom = std::min(position, GetSize() - std::min(GetSize(), MemFile_Deflate_::HISTORY_SIZE));
+
+        // Only compact in large steps so that the memmove cost stays small per byte
+        if (keepFrom - bufferStart >= DECODE_STEP) {
+            auto drop = keepFrom - bufferStart;
+            adler = MemFile_Deflate_::Adler32(adler, buffer.data(), drop);
+            buffer.erase(buffer.begin(), buffer.begin() + drop);
+            bufferStart = keepFrom;
+        }
+    }
+
+    /// @brief Marks the stream as corrupt. What was decoded so far stays readable
+    void Fail() {
+        state = State::DONE;
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+
+    bool FillInput() {
+        auto bytes = source->store->MakeReadable(sourcePosition, INPUT_SIZE);
+        if (!bytes)
+            return false;
+
+        source->store->Read(sourcePosition, input, bytes);
+        sourcePosition += bytes;
+        inputPosition = 0;
+        inputSize = bytes;
+
+        return true;
+    }
+
+    void Refill() {
+        while (bitCount <= 56) {
+            if (inputPosition == inputSize && !FillInput())
+                break;
+
+            bitBuffer |= uint64_t(input[inputPosition++]) << bitCount;
+            bitCount += 8;
+        }
+    }
+
+    /// @brief Reads up to 32 bits. Running out of input fails the stream
+    bool ReadBits(uint32_t count, uint32_t &value) {
+        if (bitCount < count) {
+            Refill();
+
+            if (bitCount < count) {
+                Fail();
+                return false;
+            }
+        }
+
+        value = uint32_t(bitBuffer & ((uint64_t(1) << count) - 1));
+        bitBuffer >>= count;
+        bitCount -= count;
+
+        return true;
+    }
+
+    bool DecodeSymbol(const MemFile_HuffmanTable_ &table, uint32_t &symbol) {
+        if (bitCount < MemFile_HuffmanTable_::MAX_BITS)
+            Refill();
+
+        auto entry = table.fast[bitBuffer & ((1u << MemFile_HuffmanTable_::FAST_BITS) - 1)];
+        if (entry) {
+            uint32_t length = entry >> 9;
+            if (length > bitCount) {
+                Fail();
+                return false;
+            }
+
+            bitBuffer >>= length;
+            bitCount -= length;
+            symbol = entry & 0x1FF;
+
+            return true;
+        }
+
+        // Walk the canonical code one bit at a time
+        int32_t code = 0, first = 0, index = 0;
+        for (uint32_t length = 1; length <= MemFile_HuffmanTable_::MAX_BITS && length <= bitCount; length++) {
+            code |= int32_t((bitBuffer >> (length - 1)) & 1);
+            int32_t count = table.counts[length];
+
+            if (code - first < count) {
+                bitBuffer >>= length;
+                bitCount -= length;
+                symbol = table.symbols[index + code - first];
+
+                return true;
+            }
+
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+
+        Fail();
+        return false;
+    }
+
+    bool ReadStreamHeader() {
+        Refill();
+
+        // A zlib header is a valid CMF / FLG pair with the Deflate method and no preset dictionary. Anything else is read as raw Deflate
+        if (bitCount >= 16) {
+            auto cmf = uint32_t(bitBuffer & 0xFF), flg = uint32_t((bitBuffer >> 8) & 0xFF);
+
+            if ((cmf & 0x0F) == 8 && (cmf >> 4) <= 7 && !(((cmf << 8) | flg) % 31) && !(flg & 0x20)) {
+                bitBuffer >>= 16;
+                bitCount -= 16;
+                isZlib = true;
+            }
+        }
+
+        state = State::BLOCK_HEADER;
+        return true;
+    }
+
+    bool ReadDynamicTables() {
+        static constexpr uint8_t ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+        uint32_t literalCount, distanceCount, codeLengthCount;
+        if (!ReadBits(5, literalCount) || !ReadBits(5, distanceCount) || !ReadBits(4, codeLengthCount))
+            return false;
+
+        literalCount += 257;
+        distanceCount += 1;
+        codeLengthCount += 4;
+
+        uint8_t lengths[MemFile_HuffmanTable_::MAX_SYMBOLS + 32] = {};
+        for (uint32_t i = 0; i < codeLengthCount; i++) {
+            uint32_t length;
+            if (!ReadBits(3, length))
+                return false;
+
+            lengths[ORDER[i]] = uint8_t(length);
+        }
+
+        if (!literalTable.Build(lengths, 19)) {
+            Fail();
+            return false;
+        }
+
+        std::fill(std::begin(lengths), std::end(lengths), uint8_t(0));
+        for (uint32_t i = 0; i < literalCount + distanceCount;) {
+            uint32_t symbol;
+            if (!DecodeSymbol(literalTable, symbol))
+                return false;
+
+            if (symbol < 16) {
+                lengths[i++] = uint8_t(symbol);
+                continue;
+            }
+
+            uint32_t repeat, value = 0;
+            if (symbol == 16) {
+                if (!i) {
+                    Fail();
+                    return false;
+                }
+
+                value = lengths[i - 1];
+                if (!ReadBits(2, repeat))
+                    return false;
+                repeat += 3;
+            } else if (symbol == 17) {
+                if (!ReadBits(3, repeat))
+                    return false;
+                repeat += 3;
+            } else {
+                if (!ReadBits(7, repeat))
+                    return false;
+                repeat += 11;
+            }
+
+            if (i + repeat > literalCount + distanceCount) {
+                Fail();
+                return false;
+            }
+
+            while (repeat--)
+                lengths[i++] = uint8_t(value);
+        }
+
+        if (!literalTable.Build(lengths, literalCount) || !distanceTable.Build(lengths + literalCount, distanceCount)) {
+            Fail();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool ReadBlockHeader() {
+        uint32_t header;
+        if (!ReadBits(3, header))
+            return false;
+
+        isLastBlock = header & 1;
+
+        switch (header >> 1) {
+        case 0: {
+            // Stored blocks start at a byte boundary
+            bitBuffer >>= bitCount & 7;
+            bitCount -= bitCount & 7;
+
+            uint32_t length, check;
+            if (!ReadBits(16, length) || !ReadBits(16, check))
+                return false;
+
+            if (length != (~check & 0xFFFF)) {
+                Fail();
+                return false;
+            }
+
+            storedRemaining = length;
+            state = State::STORED;
+        } break;
+
+        case 1:
+            literalCodes = &MemFile_FixedHuffmanTables_::Get().literals;
+            distanceCodes = &MemFile_FixedHuffmanTables_::Get().distances;
+            state = State::HUFFMAN;
+            break;
+
+        case 2:
+            if (!ReadDynamicTables())
+                return false;
+            literalCodes = &literalTable;
+            distanceCodes = &distanceTable;
+            state = State::HUFFMAN;
+            break;
+
+        default:
+            Fail();
+            return false;
+        }
+
+        return true;
+    }
+
+    void EndBlock() {
+        if (!isLastBlock) {
+            state = State::BLOCK_HEADER;
+            return;
+        }
+
+        state = State::DONE;
+
+        if (isZlib) {
+            bitBuffer >>= bitCount & 7;
+            bitCount -= bitCount & 7;
+
+            uint32_t expected = 0;
+            for (auto i = 0; i < 4; i++) {
+                uint32_t byte;
+                if (!ReadBits(8, byte))
+                    return;
+
+                expected = (expected << 8) | byte;
+            }
+
+            if (MemFile_Deflate_::Adler32(adler, buffer.data(), buffer.size()) != expected)
+                error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        }
+    }
+
+    /// @brief Decodes until the output reaches end (or a little past it), the stream ends or an error is found
+    void Decode(size_t end) {
+        while (GetSize() < end) {
+            switch (state) {
+            case State::STREAM_HEADER:
+                if (!ReadStreamHeader())
+                    return;
+                break;
+
+            case State::BLOCK_HEADER:
+                if (!ReadBlockHeader())
+                    return;
+                break;
+
+            case State::STORED:
+                while (storedRemaining && GetSize() < end) {
+                    uint32_t byte;
+                    if (!ReadBits(8, byte))
+                        return;
+
+                    buffer.push_back(uint8_t(byte));
+                    storedRemaining--;
+                }
+
+                if (!storedRemaining)
+                    EndBlock();
+                break;
+
+            case State::HUFFMAN:
+                while (GetSize() < end) {
+                    uint32_t symbol;
+                    if (!DecodeSymbol(*literalCodes, symbol))
+                        return;
+
+                    if (symbol < MemFile_Deflate_::END_OF_BLOCK) {
+                        buffer.push_back(uint8_t(symbol));
+                        continue;
+                    }
+
+                    if (symbol == MemFile_Deflate_::END_OF_BLOCK) {
+                        EndBlock();
+                        break;
+                    }
+
+                    symbol -= 257;
+                    if (symbol >= 29) {
+                        Fail();
+                        return;
+                    }
+
+                    uint32_t extra, distanceSymbol, distanceExtra;
+                    if (!ReadBits(MemFile_Deflate_::LENGTH_EXTRA[symbol], extra) || !DecodeSymbol(*distanceCodes, distanceSymbol))
+                        return;
+
+                    if (distanceSymbol >= 30) {
+                        Fail();
+                        return;
+                    }
+
+                    if (!ReadBits(MemFile_Deflate_::DISTANCE_EXTRA[distanceSymbol], distanceExtra))
+                        return;
+
+                    size_t length = MemFile_Deflate_::LENGTH_BASE[symbol] + extra;
+                    size_t distance = MemFile_Deflate_::DISTANCE_BASE[distanceSymbol] + distanceExtra;
+                    if (distance > buffer.size()) {
+                        Fail();
+                        return;
+                    }
+
+                    // Matches can overlap the bytes they produce, so this is copied a byte at a time
+                    auto from = buffer.size() - distance;
+                    buffer.resize(buffer.size() + length);
+                    auto data = buffer.data();
+                    for (size_t i = 0; i < length; i++)
+                        data[from + distance + i] = data[from + i];
+                }
+                break;
+
+            case State::DONE:
+                return;
+            }
+        }
+    }
+
+    MemFile *source;
+    size_t sourceStart;
+    size_t sourcePosition;
+    uint8_t input[INPUT_SIZE];
+    size_t inputPosition;
+    size_t inputSize;
+    uint64_t bitBuffer;
+    uint32_t bitCount;
+    std::vector<uint8_t> buffer; // decoded bytes starting at stream position bufferStart
+    size_t bufferStart;
+    State state;
+    bool isLastBlock;
+    bool isZlib;
+    uint32_t storedRemaining;
+    uint32_t adler; // checksum of the bytes that have been dropped from buffer
+    MemFile_HuffmanTable_ literalTable; // dynamic codes of the current block
+    MemFile_HuffmanTable_ distanceTable;
+    const MemFile_HuffmanTable_ *literalCodes; // the codes of the current block (dynamic or fixed)
+    const MemFile_HuffmanTable_ *distanceCodes;
+};
+
+/// @brief Append-only storage that compresses everything written to it into a zlib stream at the cursor of another MemFile. Data is
+/// compressed in blocks as it arrives using LZ77 with hash chains and the fixed Deflate Huffman codes. The stream is finished when the
+/// MemFile is destroyed
+class MemFile_DeflateStore_ : public MemFile_Store_ {
+  public:
+    /// @param target The MemFile that receives the compressed data. The target must outlive the stream
+    explicit MemFile_DeflateStore_(MemFile *target) : target(target), bufferStart(0), compressed(0), bitBuffer(0), bitCount(0), adler(1) {
+        std::fill(std::begin(head), std::end(head), uint64_t(0));
+        std::fill(std::begin(previous), std::end(previous), uint64_t(0));
+
+        // zlib header: Deflate with a 32K window and the "fastest" level hint
+        output.push_back(0x78);
+        output.push_back(0x01);
+    }
+
+    ~MemFile_DeflateStore_() override {
+        Compress(true);
+
+        // The checksum follows the last block at a byte boundary
+        WriteBits(0, (8 - (bitCount & 7)) & 7);
+        for (auto shift = 24; shift >= 0; shift -= 8)
+            WriteBits((adler >> shift) & 0xFF, 8);
+
+        FlushOutput();
+    }
+
+    bool IsContiguous() const override {
+        return false;
+    }
+
+    bool IsAppendOnly() const override {
+        return true;
+    }
+
+    const uint8_t *GetData() const override {
+        return nullptr;
+    }
+
+    uint8_t *GetWritableData() override {
+        return nullptr;
+    }
+
+    size_t GetSize() const override {
+        return bufferStart + buffer.size();
+    }
+
+    bool Resize(size_t newSize) override {
+        return newSize == GetSize();
+    }
+
+    size_t MakeReadable(size_t position, size_t size) override {
+        (void)position;
+        (void)size;
+        return 0;
+    }
+
+    bool Write(size_t position, const uint8_t *src, size_t size) override {
+        if (position != GetSize())
+            return false;
+
+        adler = MemFile_Deflate_::Adler32(adler, src, size);
+        buffer.insert(buffer.end(), src, src + size);
+
+        if (buffer.size() - compressed >= BLOCK_SIZE + MemFile_Deflate_::MAX_MATCH)
+            Compress(false);
+
+        return true;
+    }
+
+  private:
+    static constexpr size_t BLOCK_SIZE = 65536;
+    static constexpr size_t HASH_BITS = 15;
+    static constexpr size_t MAX_CHAIN = 32;
+    static constexpr size_t OUTPUT_SIZE = 16384;
+
+    static uint32_t Hash(const uint8_t *data) {
+        return ((uint32_t(data[0]) << 16 | uint32_t(data[1]) << 8 | data[2]) * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void WriteBits(uint32_t value, uint32_t count) {
+        bitBuffer |= uint64_t(value) << bitCount;
+        bitCount += count;
+
+        while (bitCount >= 8) {
+            output.push_back(uint8_t(bitBuffer));
+            bitBuffer >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    void WriteLiteralLength(uint32_t symbol) {
+        if (symbol < 144)
+            WriteBits(MemFile_Deflate_::ReverseBits(0x30 + symbol, 8), 8);
+        else if (symbol < 256)
+            WriteBits(MemFile_Deflate_::ReverseBits(0x190 + symbol - 144, 9), 9);
+        else if (symbol < 280)
+            WriteBits(MemFile_Deflate_::ReverseBits(symbol - 256, 7), 7);
+        else
+            WriteBits(MemFile_Deflate_::ReverseBits(0xC0 + symbol - 280, 8), 8);
+    }
+
+    void WriteMatch(size_t length, size_t distance) {
+        uint32_t symbol = 28;
+        while (MemFile_Deflate_::LENGTH_BASE[symbol] > length)
+            symbol--;
+
+        WriteLiteralLength(257 + symbol);
+        WriteBits(uint32_t(length - MemFile_Deflate_::LENGTH_BASE[symbol]), MemFile_Deflate_::LENGTH_EXTRA[symbol]);
+
+        symbol = 29;
+        while (MemFile_Deflate_::DISTANCE_BASE[symbol] > distance)
+            symbol--;
+
+        WriteBits(MemFile_Deflate_::ReverseBits(symbol, 5), 5);
+        WriteBits(uint32_t(distance - MemFile_Deflate_::DISTANCE_BASE[symbol]), MemFile_Deflate_::DISTANCE_EXTRA[symbol]);
+    }
+
+    void FlushOutput() {
+        if (output.empty())
+            return;
+
+        if (MemFile_Write(reinterpret_cast<uintptr_t>(target), reinterpret_cast<uintptr_t>(output.data()), output.size()) != output.size())
+            error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+
+        output.clear();
+    }
+
+    /// @brief Adds the position of buffer[i] to the hash chains
+    void Insert(size_t i) {
+        auto position = bufferStart + i;
+        auto &bucket = head[Hash(&buffer[i])];
+        previous[position & (MemFile_Deflate_::HISTORY_SIZE - 1)] = bucket;
+        bucket = position + 1; // zero means empty
+    }
+
+    /// @brief Emits one fixed Huffman block. Unless this is the last block, the final MAX_MATCH bytes are left for the next block so
+    /// that matches are not cut short
+    void Compress(bool isLast) {
+        auto end = buffer.size();
+        auto limit = isLast ? end : end - MemFile_Deflate_::MAX_MATCH;
+        auto data = buffer.data();
+
+        WriteBits(isLast ? 3 : 2, 3); // BFINAL, BTYPE = 01
+
+        auto i = compressed;
+        while (i < limit) {
+            size_t bestLength = 0, bestDistance = 0;
+
+            if (end - i >= MemFile_Deflate_::MIN_MATCH) {
+                auto position = bufferStart + i;
+                auto maxLength = std::min(end - i, MemFile_Deflate_::MAX_MATCH);
+                auto candidate = head[Hash(data + i)];
+
+                for (size_t chain = 0; candidate && chain < MAX_CHAIN; chain++) {
+                    auto match = candidate - 1;
+                    if (match < bufferStart || match >= position || position - match > MemFile_Deflate_::HISTORY_SIZE)
+                        break;
+
+                    auto matchData = data + (match - bufferStart);
+                    size_t length = 0;
+                    while (length < maxLength && matchData[length] == data[i + length])
+                        length++;
+
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestDistance = position - match;
+
+                        if (length == maxLength)
+                            break;
+                    }
+
+                    auto next = previous[match & (MemFile_Deflate_::HISTORY_SIZE - 1)];
+                    if (next >= candidate)
+                        break; // the slot has been reused by a newer position
+
+                    candidate = next;
+                }
+            }
+
+            if (bestLength >= MemFile_Deflate_::MIN_MATCH) {
+                WriteMatch(bestLength, bestDistance);
+
+                for (size_t j = 0; j < bestLength; j++, i++) {
+                    if (end - i >= MemFile_Deflate_::MIN_MATCH)
+                        Insert(i);
+                }
+            } else {
+                WriteLiteralLength(data[i]);
+
+                if (end - i >= MemFile_Deflate_::MIN_MATCH)
+                    Insert(i);
+
+                i++;
+            }
+        }
+
+        WriteLiteralLength(MemFile_Deflate_::END_OF_BLOCK);
+        compressed = i;
+
+        // Keep only the history that later matches can reach
+        if (compressed > MemFile_Deflate_::HISTORY_SIZE) {
+            auto drop = compressed - MemFile_Deflate_::HISTORY_SIZE;
+            buffer.erase(buffer.begin(), buffer.begin() + drop);
+            bufferStart += drop;
+            compressed -= drop;
+        }
+
+        if (output.size() >= OUTPUT_SIZE || isLast)
+            FlushOutput();
+    }
+
+    MemFile *target;
+    std::vector<uint8_t> buffer; // uncompressed bytes starting at stream position bufferStart
+    size_t bufferStart;
+    size_t compressed; // index in buffer of the first byte that has not been compressed
+    uint64_t head[size_t(1) << HASH_BITS];
+    uint64_t previous[MemFile_Deflate_::HISTORY_SIZE];
+    std::vector<uint8_t> output;
+    uint64_t bitBuffer;
+    uint32_t bitCount;
+    uint32_t adler;
+};
+
+/// @brief Creates a read-only MemFile that decompresses a zlib (as made by _DEFLATE$) or raw Deflate stream as it is read. Data is decoded in
+/// fixed-size steps, so memory use stays bounded whatever the size of the uncompressed data. Seeking backwards restarts decompression
+/// @param source A valid pointer to the MemFile holding the compressed data. The stream starts at its cursor. The source cursor is not moved
+/// and the source must not be destroyed before the stream
+/// @return A pointer to a new MemFile or nullptr on failure
+uintptr_t MemFile_OpenInflateStream(uintptr_t source) {
+    auto sourceFile = reinterpret_cast<MemFile *>(source);
+
+    if (!sourceFile) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    auto memFile = new MemFile;
+    memFile->store = std::make_unique<MemFile_InflateStore_>(sourceFile);
+    memFile->cursor = 0;
+
+    return reinterpret_cast<uintptr_t>(memFile);
+}
+
+/// @brief Creates a write-only MemFile that compresses what is written to it into a zlib stream (readable by _INFLATE$) at the cursor of
+/// another MemFile. Writes must be sequential. The stream is finished when the MemFile is destroyed, which must happen before the target
+/// is destroyed
+/// @param target A valid pointer to the MemFile that receives the compressed data
+/// @return A pointer to a new MemFile or nullptr on failure
+uintptr_t MemFile_OpenDeflateStream(uintptr_t target) {
+    auto targetFile = reinterpret_cast<MemFile *>(target);
+
+    if (!targetFile) {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+        return 0;
+    }
+
+    auto memFile = new MemFile;
+    memFile->store = std::make_unique<MemFile_DeflateStore_>(targetFile);
+    memFile->cursor = 0;
+
+    return reinterpret_cast<uintptr_t>(memFile);
+}
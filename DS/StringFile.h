@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Memory-only file-like object
+// Copyright (c) 2026 Samuel Gomes
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "../Core/Types.h"
+#include "../Debug/Debug.h"
+#include <cstdint>
+#include <cstring>
+
+/// @brief Reads a value of type T from a StringFile buffer at the cursor position and moves the cursor past it
+/// @tparam T A valid C++ type
+/// @param buffer The StringFile buffer (QB64 string)
+/// @param size The length of the buffer
+/// @param cursor A pointer to the StringFile cursor
+/// @return The T value read. Reading past the end of the buffer is an error
+template <typename T> inline T StringFile_Read(const char *buffer, uint32_t size, uint32_t *cursor) {
+    T value = T();
+
+    if (*cursor <= size && size - *cursor >= sizeof(T)) {
+        std::memcpy(&value, buffer + *cursor, sizeof(T)); // the cursor can be anywhere, so this must be an unaligned load
+        *cursor += sizeof(T);
+    } else {
+        error(QB_ERROR_ILLEGAL_FUNCTION_CALL);
+    }
+
+    return value;
+}
+
+/// @brief Writes a value of type T to a StringFile buffer at the cursor position and moves the cursor past it
+/// @tparam T A valid C++ type
+/// @param buffer The StringFile buffer (QB64 string). This must already be large enough
+/// @param cursor A pointer to the StringFile cursor
+/// @param value The T value to write
+template <typename T> inline void StringFile_Write(char *buffer, uint32_t *cursor, T value) {
+    std::memcpy(buffer + *cursor, &value, sizeof(T));
+    *cursor += sizeof(T);
+}
@@ -0,0 +1,123 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Memory-mapped file helper
+// Copyright (c) 2025 Samuel Gomes
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/// @brief Maps a whole file into memory for reading. The mapping is released when the object is destroyed.
+/// In copy-on-write mode the pages can also be written to. Changes are private to the process and are never written back to the file.
+class MappedFile_ {
+  public:
+    MappedFile_() : data(nullptr), size(0), copyOnWrite(false) {}
+
+    ~MappedFile_() {
+        Close();
+    }
+
+    MappedFile_(const MappedFile_ &) = delete;
+    MappedFile_ &operator=(const MappedFile_ &) = delete;
+
+    /// @brief Maps a file. Any previous mapping is released first.
+    /// @param fileName The file name (NUL terminated).
+    /// @param copyOnWrite If true, the pages are mapped as writable private copies.
+    /// @return True on success. Empty files cannot be mapped.
+    bool Open(const char *fileName, bool copyOnWrite = false) {
+        Close();
+
+#ifdef _WIN32
+        auto hFile = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart <= 0 || uint64_t(fileSize.QuadPart) > SIZE_MAX) {
+            CloseHandle(hFile);
+            return false;
+        }
+
+        auto hMapping = CreateFileMappingA(hFile, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(hFile); // the mapping keeps the file open
+        if (!hMapping) {
+            return false;
+        }
+
+        auto view = MapViewOfFile(hMapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(hMapping); // the view keeps the mapping alive
+        if (!view) {
+            return false;
+        }
+
+        data = static_cast<uint8_t *>(view);
+        size = size_t(fileSize.QuadPart);
+#else
+        auto fd = open(fileName, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) || st.st_size <= 0 || uint64_t(st.st_size) > SIZE_MAX) {
+            close(fd);
+            return false;
+        }
+
+        auto view = mmap(nullptr, size_t(st.st_size), copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, copyOnWrite ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+        close(fd); // the mapping keeps the file open
+        if (view == MAP_FAILED) {
+            return false;
+        }
+
+        data = static_cast<uint8_t *>(view);
+        size = size_t(st.st_size);
+#endif
+
+        this->copyOnWrite = copyOnWrite;
+
+        return true;
+    }
+
+    /// @brief Releases the mapping.
+    void Close() {
+        if (data) {
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+#else
+            munmap(data, size);
+#endif
+            data = nullptr;
+            size = 0;
+            copyOnWrite = false;
+        }
+    }
+
+    const uint8_t *GetData() const {
+        return data;
+    }
+
+    /// @brief Returns the mapped pages for writing, or nullptr if the file was not mapped in copy-on-write mode.
+    uint8_t *GetWritableData() const {
+        return copyOnWrite ? data : nullptr;
+    }
+
+    size_t GetSize() const {
+        return size;
+    }
+
+  private:
+    uint8_t *data;
+    size_t size;
+    bool copyOnWrite;
+};
@@ -0,0 +1,56 @@
+//----------------------------------------------------------------------------------------------------------------------
+// Native helpers for the HashTable benchmarks in test_basic.bas (QB64 cannot start threads by itself)
+// Copyright (c) 2025 Samuel Gomes
+//----------------------------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "../DS/HashTable.h"
+#include <thread>
+#include <vector>
+
+/// @brief Returns the number of hardware threads.
+inline uint32_t HashTableBench_GetHardwareThreads() {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/// @brief Hammers a thread-safe hash table from several threads at once. Every thread inserts, looks up and removes its own range of numeric
+/// keys, so the total amount of work grows with the thread count and perfect scaling shows up as a constant run time.
+/// @param hTable A pointer (QB64 _OFFSET) to a hash table created using HashTable_CreateConcurrent().
+/// @param threadCount The number of threads to use.
+/// @param keysPerThread The number of keys each thread works with.
+/// @return The number of failed lookups (expected to be 0).
+inline uint32_t HashTableBench_RunConcurrent(uintptr_t hTable, uint32_t threadCount, uint32_t keysPerThread) {
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> failures(threadCount);
+
+    for (uint32_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([=, &failures]() {
+            auto first = uintptr_t(t) * keysPerThread;
+            auto last = first + keysPerThread;
+            uint32_t failed = 0; // kept local so that the threads do not share a cache line
+
+            for (auto k = first; k < last; k++) {
+                HashTable_Set<uint32_t>(hTable, k, uint32_t(k));
+            }
+
+            for (auto k = first; k < last; k++) {
+                failed += HashTable_Get<uint32_t>(hTable, k) != uint32_t(k);
+            }
+
+            for (auto k = first; k < last; k += 2) {
+                failed += !HashTable_Remove(hTable, k);
+            }
+
+            failures[t] = failed;
+        });
+    }
+
+    uint32_t total = 0;
+    for (uint32_t t = 0; t < threadCount; t++) {
+        threads[t].join();
+        total += failures[t];
+    }
+
+    return total;
+}
@@ -0,0 +1,936 @@
+'-----------------------------------------------------------------------------------------------------------------------
+' BASIC MOD player sequencer that MODPlayer.h was ported from. The tests compare the native sequencer against this
+' Copyright (c) 2026 Samuel Gomes
+'-----------------------------------------------------------------------------------------------------------------------
+
+$INCLUDEONCE
+
+'$INCLUDE:'MODPlayerRef.bi'
+
+' Starts playback from the beginning of the song
+SUB MODPlayerRef_Play
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+
+    ' Initialize some important stuff
+    MODPlayerRef_Song.tempoTimerValue = (SoftSynth_GetSampleRate * MODPLAYERREF_SONG_BPM_DEFAULT) \ 50
+    MODPlayerRef_Song.orderPosition = NULL
+    MODPlayerRef_Song.patternRow = NULL
+    MODPlayerRef_Song.speed = MODPlayerRef_Song.defaultSpeed
+    MODPlayerRef_Song.tick = MODPlayerRef_Song.speed
+    MODPlayerRef_Song.isPaused = _FALSE
+
+    ' Set default BPM
+    MODPlayerRef_SetBPM MODPlayerRef_Song.defaultBPM
+
+    MODPlayerRef_Song.isPlaying = _TRUE
+END SUB
+
+
+' Plays one tick of the song and returns the number of frames to mix. This is the body of the BASIC MODPlayer_Update loop
+FUNCTION MODPlayerRef_Update~&
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+    SHARED MODPlayerRef_Order() AS _UNSIGNED INTEGER
+
+    ' Check conditions for which we should just exit and not process anything
+    ' 1. Song is done and we are not looping
+    ' 2. Playback was not requested
+    ' 3. Playback is paused
+    IF _NEGATE MODPlayerRef_Song.isPlaying _ORELSE MODPlayerRef_Song.orderPosition >= MODPlayerRef_Song.orders _ORELSE MODPlayerRef_Song.isPaused THEN EXIT FUNCTION
+
+    IF MODPlayerRef_Song.tick >= MODPlayerRef_Song.speed THEN
+        ' Reset song tick
+        MODPlayerRef_Song.tick = 0
+
+        ' Process pattern row if pattern delay is over
+        IF MODPlayerRef_Song.patternDelay = 0 THEN
+            ' Skip marker pattern
+            WHILE MODPLAYERREF_PATTERN_MARKER = MODPlayerRef_Order(MODPlayerRef_Song.orderPosition)
+                MODPlayerRef_Song.orderPosition = MODPlayerRef_Song.orderPosition + 1
+                MODPlayerRef_Song.patternRow = 0
+
+                ' Check if we need to loop or stop
+                IF MODPlayerRef_Song.orderPosition >= MODPlayerRef_Song.orders THEN
+                    IF MODPlayerRef_Song.isLooping THEN
+                        MODPlayerRef_Song.orderPosition = MODPlayerRef_Song.endJumpOrder
+                        MODPlayerRef_Song.speed = MODPlayerRef_Song.defaultSpeed
+                        MODPlayerRef_Song.tick = MODPlayerRef_Song.speed
+                    ELSE
+                        MODPlayerRef_Song.isPlaying = _FALSE
+                        EXIT FUNCTION ' bail
+                    END IF
+                END IF
+            WEND
+
+            ' Check for end of song marker
+            IF MODPLAYERREF_PATTERN_END = MODPlayerRef_Order(MODPlayerRef_Song.orderPosition) THEN
+                IF MODPlayerRef_Song.isLooping THEN
+                    MODPlayerRef_Song.orderPosition = MODPlayerRef_Song.endJumpOrder
+                    MODPlayerRef_Song.speed = MODPlayerRef_Song.defaultSpeed
+                    MODPlayerRef_Song.tick = MODPlayerRef_Song.speed
+                ELSE
+                    MODPlayerRef_Song.isPlaying = _FALSE
+                    EXIT FUNCTION ' bail
+                END IF
+            END IF
+
+            ' Save the pattern and row for MODPlayerRef_UpdateTick()
+            ' The pattern that we are playing is always MODPlayerRef_Song.tickPattern
+            MODPlayerRef_Song.tickPattern = MODPlayerRef_Order(MODPlayerRef_Song.orderPosition)
+            MODPlayerRef_Song.tickPatternRow = MODPlayerRef_Song.patternRow
+
+            ' Process the row
+            MODPlayerRef_UpdateRow
+
+            ' Increment the row counter
+            ' Note MODPlayerRef_UpdateTick() should pickup stuff using tickPattern & tickPatternRow
+            ' This is because we are already at a new row not processed by MODPlayerRef_UpdateRow()
+            MODPlayerRef_Song.patternRow = MODPlayerRef_Song.patternRow + 1
+
+            ' Check if we have finished the pattern and then move to the next one
+            IF MODPlayerRef_Song.patternRow >= MODPlayerRef_Song.rows THEN
+                MODPlayerRef_Song.orderPosition = MODPlayerRef_Song.orderPosition + 1
+                MODPlayerRef_Song.patternRow = 0
+
+                ' Check if we need to loop or stop
+                IF MODPlayerRef_Song.orderPosition >= MODPlayerRef_Song.orders THEN
+                    IF MODPlayerRef_Song.isLooping THEN
+                        MODPlayerRef_Song.orderPosition = MODPlayerRef_Song.endJumpOrder
+                        MODPlayerRef_Song.speed = MODPlayerRef_Song.defaultSpeed
+                        MODPlayerRef_Song.tick = MODPlayerRef_Song.speed
+                    ELSE
+                        MODPlayerRef_Song.isPlaying = _FALSE ' we'll not bail here to allow any remaining samples to mix and play below
+                    END IF
+                END IF
+            END IF
+        ELSE
+            MODPlayerRef_Song.patternDelay = MODPlayerRef_Song.patternDelay - 1
+        END IF
+    ELSE
+        MODPlayerRef_UpdateTick
+    END IF
+
+    ' The caller mixes the current tick
+    MODPlayerRef_Update = MODPlayerRef_Song.framesPerTick
+
+    ' Increment song tick on each update
+    MODPlayerRef_Song.tick = MODPlayerRef_Song.tick + 1
+END FUNCTION
+
+
+' Loads all required LUTs from DATA
+SUB MODPlayerRef_LoadTables
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+    SHARED MODPlayerRef_PeriodTable() AS _UNSIGNED INTEGER
+    SHARED MODPlayerRef_SineTable() AS _UNSIGNED _BYTE
+    SHARED MODPlayerRef_InvertLoopSpeedTable() AS _UNSIGNED _BYTE
+
+    ' Load the period table
+    RESTORE PeriodTab
+    READ MODPlayerRef_Song.periodTableMax ' read the size
+    MODPlayerRef_Song.periodTableMax = MODPlayerRef_Song.periodTableMax - 1 ' change to ubound
+    REDIM MODPlayerRef_PeriodTable(0 TO MODPlayerRef_Song.periodTableMax) AS _UNSIGNED INTEGER ' allocate size elements
+    ' Now read size values
+    DIM i AS LONG: FOR i = 0 TO MODPlayerRef_Song.periodTableMax
+        READ MODPlayerRef_PeriodTable(i)
+    NEXT
+
+    ' Load the sine table
+    RESTORE SineTab
+    DIM s AS LONG: READ s
+    REDIM MODPlayerRef_SineTable(0 TO s - 1) AS _UNSIGNED _BYTE
+    FOR i = 0 TO s - 1
+        READ MODPlayerRef_SineTable(i)
+    NEXT
+
+    ' Load the invert loop table
+    RESTORE ILSpdTab
+    READ s
+    REDIM MODPlayerRef_InvertLoopSpeedTable(0 TO s - 1) AS _UNSIGNED _BYTE
+    FOR i = 0 TO s - 1
+        READ MODPlayerRef_InvertLoopSpeedTable(i)
+    NEXT
+
+    ' Amiga period table data for 11 octaves
+    PeriodTab:
+    DATA 134
+    DATA 27392,25856,24384,23040,21696,20480,19328,18240,17216,16256,15360,14496
+    DATA 13696,12928,12192,11520,10848,10240,9664,9120,8608,8128,7680,7248
+    DATA 6848,6464,6096,5760,5424,5120,4832,4560,4304,4064,3840,3624
+    DATA 3424,3232,3048,2880,2712,2560,2416,2280,2152,2032,1920,1812
+    DATA 1712,1616,1524,1440,1356,1280,1208,1140,1076,1016,960,906
+    DATA 856,808,762,720,678,640,604,570,538,508,480,453
+    DATA 428,404,381,360,339,320,302,285,269,254,240,226
+    DATA 214,202,190,180,170,160,151,143,135,127,120,113
+    DATA 107,101,95,90,85,80,75,71,67,63,60,56
+    DATA 53,50,47,45,42,40,37,35,33,31,30,28
+    DATA 26,25,23,22,21,20,18,17,16,15,15,14
+    DATA 0,0
+    DATA NaN
+
+    ' Sine table data for tremolo & vibrato
+    SineTab:
+    DATA 32
+    DATA 0,24,49,74,97,120,141,161,180,197,212,224,235,244,250,253
+    DATA 255,253,250,244,235,224,212,197,180,161,141,120,97,74,49,24
+    DATA NaN
+
+    ' Invert loop speed table data for EFx
+    ILSpdTab:
+    DATA 16
+    DATA 0,5,6,7,8,10,11,13,16,19,22,26,32,43,64,128
+    DATA NaN
+END SUB
+
+
+' Updates a row of notes and play them out on tick 0
+SUB MODPlayerRef_UpdateRow
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+    SHARED MODPlayerRef_Pattern() AS MODPlayerRef_NoteType
+    SHARED MODPlayerRef_Instrument() AS MODPlayerRef_InstrumentType
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+    SHARED MODPlayerRef_PeriodTable() AS _UNSIGNED INTEGER
+
+    DIM AS _UNSIGNED _BYTE nChannel, nNote, nInstrument, nVolume, nEffect, nOperand, nOpX, nOpY
+    ' The effect flags below are set to true when a pattern jump effect and pattern break effect are triggered
+    DIM AS _BYTE jumpEffectFlag, breakEffectFlag, noFrequency
+
+    ' Set the active channel count to zero
+    MODPlayerRef_Song.activeChannels = 0
+
+    ' Process all channels
+    FOR nChannel = 0 TO MODPlayerRef_Song.channels - 1
+        nNote = MODPlayerRef_Pattern(MODPlayerRef_Song.tickPattern, MODPlayerRef_Song.tickPatternRow, nChannel).note
+        nInstrument = MODPlayerRef_Pattern(MODPlayerRef_Song.tickPattern, MODPlayerRef_Song.tickPatternRow, nChannel).instrument
+        nVolume = MODPlayerRef_Pattern(MODPlayerRef_Song.tickPattern, MODPlayerRef_Song.tickPatternRow, nChannel).volume
+        nEffect = MODPlayerRef_Pattern(MODPlayerRef_Song.tickPattern, MODPlayerRef_Song.tickPatternRow, nChannel).effect
+        nOperand = MODPlayerRef_Pattern(MODPlayerRef_Song.tickPattern, MODPlayerRef_Song.tickPatternRow, nChannel).operand
+        nOpX = _SHR(nOperand, 4)
+        nOpY = nOperand AND &HF
+        noFrequency = _FALSE
+
+        ' Set volume. We never play if sample number is zero. Our sample array is 1 based
+        ' ONLY RESET VOLUME IF THERE IS A SAMPLE NUMBER
+        IF nInstrument THEN
+            MODPlayerRef_Channel(nChannel).instrument = nInstrument - 1
+            MODPlayerRef_Channel(nChannel).startPosition = 0 ' reset sample offset if sample changes
+
+            ' Don't get the volume if delay note, set it when the delay note actually happens
+            IF nEffect <> MODPLAYERREF_FX_EXTENDED _ORELSE nOpX <> MODPLAYERREF_FX_EXTENDED_NOTE_DELAY THEN
+                MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).volume
+            END IF
+        END IF
+
+        IF nNote < MODPLAYERREF_NOTE_NONE THEN
+            MODPlayerRef_Channel(nChannel).lastPeriod = (8363 * MODPlayerRef_PeriodTable(nNote)) \ MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).c2Spd
+            MODPlayerRef_Channel(nChannel).note = nNote
+            MODPlayerRef_Channel(nChannel).restart = _TRUE
+            MODPlayerRef_Song.activeChannels = nChannel
+
+            ' Retrigger tremolo and vibrato waveforms
+            IF MODPlayerRef_Channel(nChannel).waveControl AND &HF < 4 THEN MODPlayerRef_Channel(nChannel).vibratoPosition = 0
+            IF _SHR(MODPlayerRef_Channel(nChannel).waveControl, 4) < 4 THEN MODPlayerRef_Channel(nChannel).tremoloPosition = 0
+
+            ' ONLY RESET FREQUENCY IF THERE IS A NOTE VALUE AND PORTA NOT SET
+            IF nEffect <> MODPLAYERREF_FX_PORTAMENTO _ANDALSO nEffect <> MODPLAYERREF_FX_PORTAMENTO_VOLUME_SLIDE _ANDALSO nEffect <> MODPLAYERREF_FX_PORTAMENTO_VOLUME_FINE_SLIDE THEN
+                MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).lastPeriod
+            END IF
+        ELSE
+            MODPlayerRef_Channel(nChannel).restart = _FALSE
+        END IF
+
+        IF nVolume <= MODPLAYERREF_INSTRUMENT_VOLUME_MAX THEN MODPlayerRef_Channel(nChannel).volume = nVolume
+        IF nNote = MODPLAYERREF_NOTE_KEY_OFF THEN MODPlayerRef_Channel(nChannel).volume = 0
+
+        ' Process tick 0 effects
+        SELECT CASE nEffect
+            CASE MODPLAYERREF_FX_PORTAMENTO
+                IF nOperand THEN MODPlayerRef_Channel(nChannel).portamentoSpeed = nOperand
+                MODPlayerRef_Channel(nChannel).portamentoTo = MODPlayerRef_Channel(nChannel).lastPeriod
+                MODPlayerRef_Channel(nChannel).restart = _FALSE
+
+            CASE MODPLAYERREF_FX_PORTAMENTO_VOLUME_SLIDE
+                MODPlayerRef_Channel(nChannel).portamentoTo = MODPlayerRef_Channel(nChannel).lastPeriod
+                MODPlayerRef_Channel(nChannel).restart = _FALSE
+
+            CASE MODPLAYERREF_FX_VIBRATO
+                IF nOpX THEN MODPlayerRef_Channel(nChannel).vibratoSpeed = nOpX
+                IF nOpY THEN MODPlayerRef_Channel(nChannel).vibratoDepth = nOpY
+
+            CASE MODPLAYERREF_FX_TREMOLO
+                IF nOpX THEN MODPlayerRef_Channel(nChannel).tremoloSpeed = nOpX
+                IF nOpY THEN MODPlayerRef_Channel(nChannel).tremoloDepth = nOpY
+
+            CASE MODPLAYERREF_FX_PANNING_8
+                ' Don't care about DMP panning BS. We are doing this Fasttracker style
+                SoftSynth_SetVoiceBalance nChannel, (nOperand / 255!) * 2! - MODPLAYERREF_PAN_RIGHT ' pan = ((x / 255) * 2) - 1
+
+            CASE MODPLAYERREF_FX_SAMPLE_OFFSET
+                MODPlayerRef_Channel(nChannel).startPosition = _SHL(nOperand, 8)
+                IF MODPlayerRef_Channel(nChannel).startPosition > MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).length THEN
+                    MODPlayerRef_Channel(nChannel).startPosition = MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).length
+                END IF
+
+            CASE MODPLAYERREF_FX_POSITION_JUMP
+                MODPlayerRef_Song.orderPosition = nOperand
+                IF MODPlayerRef_Song.orderPosition >= MODPlayerRef_Song.orders THEN MODPlayerRef_Song.orderPosition = MODPlayerRef_Song.endJumpOrder
+                MODPlayerRef_Song.patternRow = -1 ' This will increment right after & we will start at 0
+                jumpEffectFlag = _TRUE
+
+            CASE MODPLAYERREF_FX_VOLUME
+                MODPlayerRef_Channel(nChannel).volume = nOperand ' Operand can never be -ve cause it is unsigned. So we only clip for max below
+                IF MODPlayerRef_Channel(nChannel).volume > MODPLAYERREF_INSTRUMENT_VOLUME_MAX THEN MODPlayerRef_Channel(nChannel).volume = MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+
+            CASE MODPLAYERREF_FX_PATTERN_BREAK
+                MODPlayerRef_Song.patternRow = (nOpX * 10) + nOpY - 1
+                IF MODPlayerRef_Song.patternRow >= MODPlayerRef_Song.rows THEN MODPlayerRef_Song.patternRow = -1
+                IF NOT breakEffectFlag AND NOT jumpEffectFlag THEN
+                    MODPlayerRef_Song.orderPosition = MODPlayerRef_Song.orderPosition + 1
+                    IF MODPlayerRef_Song.orderPosition >= MODPlayerRef_Song.orders THEN MODPlayerRef_Song.orderPosition = MODPlayerRef_Song.endJumpOrder
+                END IF
+                breakEffectFlag = _TRUE
+
+            CASE MODPLAYERREF_FX_EXTENDED
+                SELECT CASE nOpX
+                    CASE MODPLAYERREF_FX_EXTENDED_FILTER
+                        MODPlayerRef_Song.useAmigaLPF = (nOpY <> _FALSE)
+
+                    CASE MODPLAYERREF_FX_EXTENDED_PORTAMENTO_FINE_UP
+                        MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period - _SHL(nOpY, 2)
+
+                    CASE MODPLAYERREF_FX_EXTENDED_PORTAMENTO_FINE_DOWN
+                        MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period + _SHL(nOpY, 2)
+
+                    CASE MODPLAYERREF_FX_EXTENDED_GLISSANDO_CONTROL
+                        MODPlayerRef_Channel(nChannel).useGlissando = (nOpY <> _FALSE)
+
+                    CASE MODPLAYERREF_FX_EXTENDED_VIBRATO_WAVEFORM
+                        MODPlayerRef_Channel(nChannel).waveControl = MODPlayerRef_Channel(nChannel).waveControl AND &HF0
+                        MODPlayerRef_Channel(nChannel).waveControl = MODPlayerRef_Channel(nChannel).waveControl OR nOpY
+
+                    CASE MODPLAYERREF_FX_EXTENDED_FINETUNE
+                        MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).c2Spd = MODPlayerRef_GetC2Spd(nOpY)
+
+                    CASE MODPLAYERREF_FX_EXTENDED_PATTERN_LOOP
+                        IF nOpY = 0 THEN
+                            MODPlayerRef_Channel(nChannel).patternLoopRow = MODPlayerRef_Song.tickPatternRow
+                        ELSE
+                            IF MODPlayerRef_Channel(nChannel).patternLoopRowCounter = 0 THEN
+                                MODPlayerRef_Channel(nChannel).patternLoopRowCounter = nOpY
+                            ELSE
+                                MODPlayerRef_Channel(nChannel).patternLoopRowCounter = MODPlayerRef_Channel(nChannel).patternLoopRowCounter - 1
+                            END IF
+                            IF MODPlayerRef_Channel(nChannel).patternLoopRowCounter THEN
+                                MODPlayerRef_Song.patternRow = MODPlayerRef_Channel(nChannel).patternLoopRow - 1
+                            END IF
+                        END IF
+
+                    CASE MODPLAYERREF_FX_EXTENDED_TREMOLO_WAVEFORM
+                        MODPlayerRef_Channel(nChannel).waveControl = MODPlayerRef_Channel(nChannel).waveControl AND &HF
+                        MODPlayerRef_Channel(nChannel).waveControl = MODPlayerRef_Channel(nChannel).waveControl OR _SHL(nOpY, 4)
+
+                    CASE MODPLAYERREF_FX_EXTENDED_PANNING_4
+                        IF nOpY > 15 THEN nOpY = 15
+                        SoftSynth_SetVoiceBalance nChannel, (nOpY / 15!) * 2! - MODPLAYERREF_PAN_RIGHT ' pan = (x / 15) * 2 - 1
+
+                    CASE MODPLAYERREF_FX_EXTENDED_VOLUME_FINE_SLIDE_UP
+                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume + nOpY
+                        IF MODPlayerRef_Channel(nChannel).volume > MODPLAYERREF_INSTRUMENT_VOLUME_MAX THEN MODPlayerRef_Channel(nChannel).volume = MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+
+                    CASE MODPLAYERREF_FX_EXTENDED_VOLUME_FINE_SLIDE_DOWN
+                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume - nOpY
+                        IF MODPlayerRef_Channel(nChannel).volume < 0 THEN MODPlayerRef_Channel(nChannel).volume = 0
+
+                    CASE MODPLAYERREF_FX_EXTENDED_NOTE_DELAY
+                        MODPlayerRef_Channel(nChannel).restart = _FALSE
+                        noFrequency = _TRUE
+
+                    CASE MODPLAYERREF_FX_EXTENDED_PATTERN_DELAY
+                        MODPlayerRef_Song.patternDelay = nOpY
+
+                    CASE MODPLAYERREF_FX_EXTENDED_INVERT_LOOP
+                        MODPlayerRef_Channel(nChannel).invertLoopSpeed = nOpY
+                END SELECT
+
+            CASE MODPLAYERREF_FX_SPEED_TEMPO
+                IF nOperand < 32 THEN
+                    MODPlayerRef_Song.speed = nOperand
+                ELSE
+                    MODPlayerRef_SetBPM nOperand
+                END IF
+
+            CASE MODPLAYERREF_FX_SPEED
+                IF nOperand THEN MODPlayerRef_Song.speed = nOperand
+
+            CASE MODPLAYERREF_FX_VOLUME_FINE_SLIDE
+                IF nOperand THEN MODPlayerRef_Channel(nChannel).lastVolumeSlide = nOperand
+                ' DFF is classed as a slide up so it gets priority
+                IF nOpY = &HF THEN
+                    MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume + nOpX
+                ELSEIF nOpX = &HF THEN
+                    MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume - nOpY
+                END IF
+                ' Perform an extra slide if using old fast vol slides!
+                IF MODPlayerRef_Song.useST300VolumeSlides THEN
+                    IF nOpY = 0 THEN MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume + nOpX
+                    IF nOpX = 0 THEN MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume - nOpY
+                END IF
+                IF MODPlayerRef_Channel(nChannel).volume > MODPLAYERREF_INSTRUMENT_VOLUME_MAX THEN MODPlayerRef_Channel(nChannel).volume = MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+                IF MODPlayerRef_Channel(nChannel).volume < 0 THEN MODPlayerRef_Channel(nChannel).volume = 0
+
+            CASE MODPLAYERREF_FX_PORTAMENTO_EXTRA_FINE_DOWN
+                IF nOperand THEN MODPlayerRef_Channel(nChannel).lastPortamento = nOperand
+                IF nOpX = &HF THEN
+                    MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period + _SHL(nOpY, 2)
+                ELSEIF nOpX = &HE THEN
+                    MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period + nOpY
+                END IF
+
+            CASE MODPLAYERREF_FX_PORTAMENTO_EXTRA_FINE_UP
+                IF nOperand THEN MODPlayerRef_Channel(nChannel).lastPortamento = nOperand
+                IF nOpX = &HF THEN
+                    MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period - _SHL(nOpY, 2)
+                ELSEIF nOpX = &HE THEN
+                    MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period - nOpY
+                END IF
+
+            CASE MODPLAYERREF_FX_TREMOR
+                IF nOperand THEN MODPlayerRef_Channel(nChannel).tremorParameters = (_SHL(nOpX, 4) + 1) + (nOpY + 1)
+                MODPlayerRef_DoS3MTremor nChannel
+
+            CASE MODPLAYERREF_FX_VIBRATO_VOLUME_FINE_SLIDE
+                IF nOperand THEN MODPlayerRef_Channel(nChannel).lastVolumeSlide = nOperand
+                noFrequency = _TRUE
+
+            CASE MODPLAYERREF_FX_PORTAMENTO_VOLUME_FINE_SLIDE
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+            CASE MODPLAYERREF_FX_CHANNEL_VOLUME
+                IF nOperand <= MODPLAYERREF_S3M_GLOBAL_VOLUME_MAX THEN MODPlayerRef_Channel(nChannel).volume = nOperand
+
+            CASE MODPLAYERREF_FX_CHANNEL_VOLUME_SLIDE
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+            CASE MODPLAYERREF_FX_PANNING_FINE_SLIDE
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+            CASE MODPLAYERREF_FX_NOTE_RETRIGGER_VOLUME_SLIDE
+                IF nOperand THEN
+                    MODPlayerRef_Channel(nChannel).retriggerVolumeSlide = nOpX
+                    MODPlayerRef_Channel(nChannel).retriggerTickCount = nOpY
+                END IF
+
+            CASE MODPLAYERREF_FX_PANBRELLO_WAVEFORM
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+            CASE MODPLAYERREF_FX_PATTERN_FINE_DELAY
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+            CASE MODPLAYERREF_FX_SOUND_CONTROL
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+            CASE MODPLAYERREF_FX_HIGH_OFFSET
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+            CASE MODPLAYERREF_FX_TEMPO
+                IF nOperand THEN MODPlayerRef_SetBPM nOperand
+
+            CASE MODPLAYERREF_FX_VIBRATO_FINE
+                IF nOpX THEN MODPlayerRef_Channel(nChannel).vibratoSpeed = nOpX
+                IF nOpY THEN MODPlayerRef_Channel(nChannel).vibratoDepth = nOpY
+
+            CASE MODPLAYERREF_FX_GLOBAL_VOLUME
+                ' ST3 ignores out-of-range values
+                IF nOperand <= MODPLAYERREF_S3M_GLOBAL_VOLUME_MAX THEN SoftSynth_SetGlobalVolume nOperand / MODPLAYERREF_S3M_GLOBAL_VOLUME_MAX
+
+            CASE MODPLAYERREF_FX_GLOBAL_VOLUME_SLIDE
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+            CASE MODPLAYERREF_FX_PANBRELLO
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+            CASE MODPLAYERREF_FX_MIDI_MACRO
+                ERROR _ERR_FEATURE_UNAVAILABLE
+
+        END SELECT
+
+        MODPlayerRef_DoInvertLoop nChannel ' called every row
+
+        IF NOT noFrequency THEN
+            IF nEffect <> MODPLAYERREF_FX_TREMOLO THEN
+                SoftSynth_SetVoiceVolume nChannel, MODPlayerRef_Channel(nChannel).volume / MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+            END IF
+            IF MODPlayerRef_Channel(nChannel).period > 0 THEN
+                SoftSynth_SetVoiceFrequency nChannel, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(nChannel).period)
+            END IF
+        END IF
+    NEXT
+
+    ' Now play all samples that needs to be played
+    FOR nChannel = 0 TO MODPlayerRef_Song.activeChannels
+        IF MODPlayerRef_Channel(nChannel).restart THEN
+            SoftSynth_PlayVoice nChannel, MODPlayerRef_Channel(nChannel).instrument, SoftSynth_BytesToFrames(MODPlayerRef_Channel(nChannel).startPosition, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels), MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).playMode, SoftSynth_BytesToFrames(MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).loopStart, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels), SoftSynth_BytesToFrames(MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).loopEnd, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels)
+        END IF
+    NEXT
+END SUB
+
+
+' Updates any tick based effects after tick 0
+SUB MODPlayerRef_UpdateTick
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+    SHARED MODPlayerRef_Pattern() AS MODPlayerRef_NoteType
+    SHARED MODPlayerRef_Instrument() AS MODPlayerRef_InstrumentType
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+    SHARED MODPlayerRef_PeriodTable() AS _UNSIGNED INTEGER
+
+    DIM AS _UNSIGNED _BYTE nChannel, nVolume, nEffect, nOperand, nOpX, nOpY
+
+    ' Process all channels
+    FOR nChannel = 0 TO MODPlayerRef_Song.channels - 1
+        ' Only process if we have a period set
+        IF MODPlayerRef_Channel(nChannel).period > 0 THEN
+            ' We are not processing a new row but tick 1+ effects
+            ' So we pick these using tickPattern and tickPatternRow
+            nVolume = MODPlayerRef_Pattern(MODPlayerRef_Song.tickPattern, MODPlayerRef_Song.tickPatternRow, nChannel).volume
+            nEffect = MODPlayerRef_Pattern(MODPlayerRef_Song.tickPattern, MODPlayerRef_Song.tickPatternRow, nChannel).effect
+            nOperand = MODPlayerRef_Pattern(MODPlayerRef_Song.tickPattern, MODPlayerRef_Song.tickPatternRow, nChannel).operand
+            nOpX = _SHR(nOperand, 4)
+            nOpY = nOperand AND &HF
+
+            MODPlayerRef_DoInvertLoop nChannel ' called every tick
+
+            SELECT CASE nEffect
+                CASE MODPLAYERREF_FX_ARPEGGIO
+                    IF nOperand THEN
+                        SELECT CASE MODPlayerRef_Song.tick MOD 3
+                            CASE 0
+                                SoftSynth_SetVoiceFrequency nChannel, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(nChannel).period)
+                            CASE 1
+                                SoftSynth_SetVoiceFrequency nChannel, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_PeriodTable(MODPlayerRef_Channel(nChannel).note + nOpX))
+                            CASE 2
+                                SoftSynth_SetVoiceFrequency nChannel, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_PeriodTable(MODPlayerRef_Channel(nChannel).note + nOpY))
+                        END SELECT
+                    END IF
+
+                CASE MODPLAYERREF_FX_PORTAMENTO_UP
+                    MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period - _SHL(nOperand, 2)
+                    IF MODPlayerRef_Channel(nChannel).period < 1 THEN MODPlayerRef_Channel(nChannel).period = 1 ' clamp to avoid division by zero
+                    SoftSynth_SetVoiceFrequency nChannel, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(nChannel).period)
+
+                CASE MODPLAYERREF_FX_PORTAMENTO_DOWN
+                    MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period + _SHL(nOperand, 2)
+                    SoftSynth_SetVoiceFrequency nChannel, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(nChannel).period)
+
+                CASE MODPLAYERREF_FX_PORTAMENTO
+                    MODPlayerRef_DoPortamento nChannel
+
+                CASE MODPLAYERREF_FX_VIBRATO
+                    MODPlayerRef_DoVibrato nChannel, _TRUE ' true here means not fine vibrato
+
+                CASE MODPLAYERREF_FX_PORTAMENTO_VOLUME_SLIDE
+                    MODPlayerRef_DoPortamento nChannel
+                    MODPlayerRef_DoVolumeSlide nChannel, nOpX, nOpY, _TRUE ' true here means not fine volume slide
+
+                CASE MODPLAYERREF_FX_VIBRATO_VOLUME_SLIDE
+                    MODPlayerRef_DoVibrato nChannel, _TRUE ' true here means not fine vibrato
+                    MODPlayerRef_DoVolumeSlide nChannel, nOpX, nOpY, _TRUE ' true here means not fine volume slide
+
+                CASE MODPLAYERREF_FX_TREMOLO
+                    MODPlayerRef_DoTremolo nChannel
+
+                CASE MODPLAYERREF_FX_VOLUME_SLIDE
+                    MODPlayerRef_DoVolumeSlide nChannel, nOpX, nOpY, _TRUE ' true here means not fine volume slide
+
+                CASE MODPLAYERREF_FX_EXTENDED
+                    SELECT CASE nOpX
+                        CASE MODPLAYERREF_FX_EXTENDED_NOTE_RETRIGGER
+                            IF nOpY <> 0 THEN
+                                IF MODPlayerRef_Song.tick MOD nOpY = 0 THEN
+                                    SoftSynth_PlayVoice nChannel, MODPlayerRef_Channel(nChannel).instrument, SoftSynth_BytesToFrames(MODPlayerRef_Channel(nChannel).startPosition, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels), MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).playMode, SoftSynth_BytesToFrames(MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).loopStart, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels), SoftSynth_BytesToFrames(MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).loopEnd, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels)
+                                END IF
+                            END IF
+
+                        CASE MODPLAYERREF_FX_EXTENDED_NOTE_CUT
+                            IF MODPlayerRef_Song.tick = nOpY THEN
+                                MODPlayerRef_Channel(nChannel).volume = 0
+                                SoftSynth_SetVoiceVolume nChannel, MODPlayerRef_Channel(nChannel).volume / MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+                            END IF
+
+                        CASE MODPLAYERREF_FX_EXTENDED_NOTE_DELAY
+                            IF MODPlayerRef_Song.tick = nOpY THEN
+                                MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).volume
+                                IF nVolume <= MODPLAYERREF_INSTRUMENT_VOLUME_MAX THEN MODPlayerRef_Channel(nChannel).volume = nVolume
+                                SoftSynth_SetVoiceFrequency nChannel, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(nChannel).period)
+                                SoftSynth_SetVoiceVolume nChannel, MODPlayerRef_Channel(nChannel).volume / MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+                                SoftSynth_PlayVoice nChannel, MODPlayerRef_Channel(nChannel).instrument, SoftSynth_BytesToFrames(MODPlayerRef_Channel(nChannel).startPosition, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels), MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).playMode, SoftSynth_BytesToFrames(MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).loopStart, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels), SoftSynth_BytesToFrames(MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).loopEnd, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels)
+                            END IF
+                    END SELECT
+
+                CASE MODPLAYERREF_FX_VOLUME_FINE_SLIDE
+                    MODPlayerRef_DoVolumeSlide nChannel, _SHR(MODPlayerRef_Channel(nChannel).lastVolumeSlide, 4), MODPlayerRef_Channel(nChannel).lastVolumeSlide AND &HF, _FALSE ' false here means fine volume slide
+
+                CASE MODPLAYERREF_FX_PORTAMENTO_EXTRA_FINE_DOWN
+                    IF MODPlayerRef_Channel(nChannel).lastPortamento < &HE0 THEN MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period + _SHL(MODPlayerRef_Channel(nChannel).lastPortamento, 2)
+                    SoftSynth_SetVoiceFrequency nChannel, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(nChannel).period)
+
+                CASE MODPLAYERREF_FX_PORTAMENTO_EXTRA_FINE_UP
+                    IF MODPlayerRef_Channel(nChannel).lastPortamento < &HE0 THEN MODPlayerRef_Channel(nChannel).period = MODPlayerRef_Channel(nChannel).period - _SHL(MODPlayerRef_Channel(nChannel).lastPortamento, 2)
+                    SoftSynth_SetVoiceFrequency nChannel, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(nChannel).period)
+
+                CASE MODPLAYERREF_FX_TREMOR
+                    MODPlayerRef_DoS3MTremor nChannel
+
+                CASE MODPLAYERREF_FX_VIBRATO_VOLUME_FINE_SLIDE
+                    MODPlayerRef_DoVibrato nChannel, _TRUE ' true here means not fine vibrato
+                    MODPlayerRef_DoVolumeSlide nChannel, _SHR(MODPlayerRef_Channel(nChannel).lastVolumeSlide, 4), MODPlayerRef_Channel(nChannel).lastVolumeSlide AND &HF, _FALSE ' false here means fine volume slide
+
+                CASE MODPLAYERREF_FX_PORTAMENTO_VOLUME_FINE_SLIDE
+                    ERROR _ERR_FEATURE_UNAVAILABLE
+
+                CASE MODPLAYERREF_FX_NOTE_RETRIGGER_VOLUME_SLIDE
+                    IF MODPlayerRef_Channel(nChannel).retriggerTickCount THEN
+                        IF MODPlayerRef_Song.tick MOD MODPlayerRef_Channel(nChannel).retriggerTickCount = 0 THEN
+                            IF MODPlayerRef_Channel(nChannel).retriggerVolumeSlide THEN
+                                'Parameter  Effect              Parameter   Effect
+                                '0          No volume change    8           No volume change
+                                '1          Volume - 1          9           Volume + 1
+                                '2          Volume - 2          A           Volume + 2
+                                '3          Volume - 4          B           Volume + 4
+                                '4          Volume - 8          C           Volume + 8
+                                '5          Volume - 16         D           Volume + 16
+                                '6          Volume x 2/3        E           Volume x 1.5
+                                '7          Volume x 1/2        F           Volume x 2
+                                SELECT CASE MODPlayerRef_Channel(nChannel).retriggerVolumeSlide
+                                    CASE &H1
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume - 1
+
+                                    CASE &H2
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume - 2
+
+                                    CASE &H3
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume - 4
+
+                                    CASE &H4
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume - 8
+
+                                    CASE &H5
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume - 16
+
+                                    CASE &H6
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume * (2! / 3!)
+
+                                    CASE &H7
+                                        MODPlayerRef_Channel(nChannel).volume = _SHR(MODPlayerRef_Channel(nChannel).volume, 1)
+
+                                    CASE &H9
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume + 1
+
+                                    CASE &HA
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume + 2
+
+                                    CASE &HB
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume + 4
+
+                                    CASE &HC
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume + 8
+
+                                    CASE &HD
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume + 16
+
+                                    CASE &HE
+                                        MODPlayerRef_Channel(nChannel).volume = MODPlayerRef_Channel(nChannel).volume * (3! / 2!)
+
+                                    CASE &HF
+                                        MODPlayerRef_Channel(nChannel).volume = _SHL(MODPlayerRef_Channel(nChannel).volume, 1)
+
+                                END SELECT
+
+                                MODPlayerRef_Channel(nChannel).volume = Math_ClampLong(MODPlayerRef_Channel(nChannel).volume, 0, MODPLAYERREF_INSTRUMENT_VOLUME_MAX)
+
+                                SoftSynth_SetVoiceVolume nChannel, MODPlayerRef_Channel(nChannel).volume / MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+                            END IF
+
+                            SoftSynth_PlayVoice nChannel, MODPlayerRef_Channel(nChannel).instrument, SoftSynth_BytesToFrames(MODPlayerRef_Channel(nChannel).startPosition, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels), MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).playMode, SoftSynth_BytesToFrames(MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).loopStart, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels), SoftSynth_BytesToFrames(MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).loopEnd, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).bytesPerSample, MODPlayerRef_Instrument(MODPlayerRef_Channel(nChannel).instrument).channels)
+                        END IF
+                    END IF
+
+                CASE MODPLAYERREF_FX_VIBRATO_FINE
+                    MODPlayerRef_DoVibrato nChannel, _FALSE ' false here means fine vibrato
+
+            END SELECT
+        END IF
+    NEXT
+END SUB
+
+
+' We always set the global BPM using this and never directly
+SUB MODPlayerRef_SetBPM (nBPM AS _UNSIGNED _BYTE)
+    $CHECKING:OFF
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+
+    MODPlayerRef_Song.BPM = nBPM
+
+    ' Calculate the number of samples we have to mix per tick
+    MODPlayerRef_Song.framesPerTick = MODPlayerRef_Song.tempoTimerValue \ nBPM
+    $CHECKING:ON
+END SUB
+
+
+' Binary search the period table to find the closest value
+' I hope this is the right way to do glissando. Oh well...
+FUNCTION MODPlayerRef_GetClosestPeriod& (target AS LONG)
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+    SHARED MODPlayerRef_PeriodTable() AS _UNSIGNED INTEGER
+
+    DIM AS LONG startPos, endPos, midPos, leftVal, rightVal
+
+    IF target > 27392 THEN
+        MODPlayerRef_GetClosestPeriod = target
+        EXIT FUNCTION
+    ELSEIF target < 14 THEN
+        MODPlayerRef_GetClosestPeriod = target
+        EXIT FUNCTION
+    END IF
+
+    startPos = 0
+    endPos = MODPlayerRef_Song.periodTableMax
+    WHILE startPos + 1 < endPos
+        midPos = startPos + (endPos - startPos) \ 2
+        IF MODPlayerRef_PeriodTable(midPos) <= target THEN
+            endPos = midPos
+        ELSE
+            startPos = midPos
+        END IF
+    WEND
+
+    rightVal = ABS(MODPlayerRef_PeriodTable(startPos) - target)
+    leftVal = ABS(MODPlayerRef_PeriodTable(endPos) - target)
+
+    IF leftVal <= rightVal THEN
+        MODPlayerRef_GetClosestPeriod = MODPlayerRef_PeriodTable(endPos)
+    ELSE
+        MODPlayerRef_GetClosestPeriod = MODPlayerRef_PeriodTable(startPos)
+    END IF
+END FUNCTION
+
+
+' Carry out a tone portamento to a certain note
+SUB MODPlayerRef_DoPortamento (chan AS _UNSIGNED _BYTE)
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+
+    ' Slide up/down and clamp to destination
+    IF MODPlayerRef_Channel(chan).period < MODPlayerRef_Channel(chan).portamentoTo THEN
+        MODPlayerRef_Channel(chan).period = MODPlayerRef_Channel(chan).period + _SHL(MODPlayerRef_Channel(chan).portamentoSpeed, 2)
+        IF MODPlayerRef_Channel(chan).period > MODPlayerRef_Channel(chan).portamentoTo THEN
+            MODPlayerRef_Channel(chan).period = MODPlayerRef_Channel(chan).portamentoTo
+        END IF
+    ELSEIF MODPlayerRef_Channel(chan).period > MODPlayerRef_Channel(chan).portamentoTo THEN
+        MODPlayerRef_Channel(chan).period = MODPlayerRef_Channel(chan).period - _SHL(MODPlayerRef_Channel(chan).portamentoSpeed, 2)
+        IF MODPlayerRef_Channel(chan).period < MODPlayerRef_Channel(chan).portamentoTo THEN
+            MODPlayerRef_Channel(chan).period = MODPlayerRef_Channel(chan).portamentoTo
+        END IF
+    END IF
+
+    IF MODPlayerRef_Channel(chan).useGlissando THEN
+        SoftSynth_SetVoiceFrequency chan, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_GetClosestPeriod(MODPlayerRef_Channel(chan).period))
+    ELSE
+        SoftSynth_SetVoiceFrequency chan, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(chan).period)
+    END IF
+END SUB
+
+
+' Carry out a [fine] volume slide
+' Uses +x -y in non-fine mode, else D0x = slide down, Dx0 = slide up, DFx = fine slide down, DxF = fine slide up
+SUB MODPlayerRef_DoVolumeSlide (chan AS _UNSIGNED _BYTE, x AS _UNSIGNED _BYTE, y AS _UNSIGNED _BYTE, isNotFine AS _BYTE)
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+
+    IF isNotFine THEN
+        MODPlayerRef_Channel(chan).volume = MODPlayerRef_Channel(chan).volume + x - y
+    ELSE
+        IF y = 0 THEN MODPlayerRef_Channel(chan).volume = MODPlayerRef_Channel(chan).volume + x
+        IF x = 0 THEN MODPlayerRef_Channel(chan).volume = MODPlayerRef_Channel(chan).volume - y
+    END IF
+
+    IF MODPlayerRef_Channel(chan).volume > MODPLAYERREF_INSTRUMENT_VOLUME_MAX THEN MODPlayerRef_Channel(chan).volume = MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+    IF MODPlayerRef_Channel(chan).volume < 0 THEN MODPlayerRef_Channel(chan).volume = 0
+
+    SoftSynth_SetVoiceVolume chan, MODPlayerRef_Channel(chan).volume / MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+END SUB
+
+
+' Carry out an S3M tremor command
+SUB MODPlayerRef_DoS3MTremor (chan AS _UNSIGNED _BYTE)
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+
+    MODPlayerRef_Channel(chan).tremorPosition = MODPlayerRef_Channel(chan).tremorPosition MOD (_SHR(MODPlayerRef_Channel(chan).tremorParameters, 4) + (MODPlayerRef_Channel(chan).tremorParameters AND &HF))
+
+    IF MODPlayerRef_Channel(chan).tremorPosition < _SHR(MODPlayerRef_Channel(chan).tremorParameters, 4) THEN
+        SoftSynth_SetVoiceVolume chan, MODPlayerRef_Channel(chan).volume / MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+    ELSE
+        SoftSynth_SetVoiceVolume chan, 0
+    END IF
+
+    MODPlayerRef_Channel(chan).tremorPosition = MODPlayerRef_Channel(chan).tremorPosition + 1
+END SUB
+
+
+' Carry out a [fine] vibrato at a certain depth and speed
+SUB MODPlayerRef_DoVibrato (chan AS _UNSIGNED _BYTE, isNotFine AS _BYTE)
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+    SHARED MODPlayerRef_SineTable() AS _UNSIGNED _BYTE
+
+    DIM delta AS _UNSIGNED INTEGER
+    DIM temp AS _UNSIGNED _BYTE
+
+    temp = MODPlayerRef_Channel(chan).vibratoPosition AND 31
+
+    SELECT CASE MODPlayerRef_Channel(chan).waveControl AND 3
+        CASE 0 ' Sine
+            delta = MODPlayerRef_SineTable(temp)
+
+        CASE 1 ' Saw down
+            temp = _SHL(temp, 3)
+            IF MODPlayerRef_Channel(chan).vibratoPosition < 0 THEN temp = 255 - temp
+            delta = temp
+
+        CASE 2 ' Square
+            delta = 255
+
+        CASE 3 ' Random
+            delta = RND * 255!
+    END SELECT
+
+    delta = _SHR(delta * MODPlayerRef_Channel(chan).vibratoDepth, 7)
+    IF isNotFine THEN delta = _SHL(delta, 2) ' make vibrato 4 times bigger
+
+    IF MODPlayerRef_Channel(chan).vibratoPosition >= 0 THEN
+        SoftSynth_SetVoiceFrequency chan, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(chan).period + delta)
+    ELSE
+        SoftSynth_SetVoiceFrequency chan, MODPlayerRef_GetFrequencyFromPeriod(MODPlayerRef_Channel(chan).period - delta)
+    END IF
+
+    MODPlayerRef_Channel(chan).vibratoPosition = MODPlayerRef_Channel(chan).vibratoPosition + MODPlayerRef_Channel(chan).vibratoSpeed
+    IF MODPlayerRef_Channel(chan).vibratoPosition > 31 THEN
+        MODPlayerRef_Channel(chan).vibratoPosition = MODPlayerRef_Channel(chan).vibratoPosition - 64
+    END IF
+END SUB
+
+
+' Carry out a tremolo at a certain depth and speed
+SUB MODPlayerRef_DoTremolo (chan AS _UNSIGNED _BYTE)
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+    SHARED MODPlayerRef_SineTable() AS _UNSIGNED _BYTE
+
+    DIM delta AS _UNSIGNED INTEGER
+    DIM temp AS _UNSIGNED _BYTE
+
+    temp = MODPlayerRef_Channel(chan).tremoloPosition AND 31
+
+    SELECT CASE _SHR(MODPlayerRef_Channel(chan).waveControl, 4) AND 3
+        CASE 0 ' Sine
+            delta = MODPlayerRef_SineTable(temp)
+
+        CASE 1 ' Saw down
+            temp = _SHL(temp, 3)
+            IF MODPlayerRef_Channel(chan).tremoloPosition < 0 THEN temp = 255 - temp
+            delta = temp
+
+        CASE 2 ' Square
+            delta = 255
+
+        CASE 3 ' Random
+            delta = RND * 255!
+    END SELECT
+
+    delta = _SHR(delta * MODPlayerRef_Channel(chan).tremoloDepth, 6)
+
+    IF MODPlayerRef_Channel(chan).tremoloPosition >= 0 THEN
+        IF MODPlayerRef_Channel(chan).volume + delta > MODPLAYERREF_INSTRUMENT_VOLUME_MAX THEN delta = MODPLAYERREF_INSTRUMENT_VOLUME_MAX - MODPlayerRef_Channel(chan).volume
+        SoftSynth_SetVoiceVolume chan, (MODPlayerRef_Channel(chan).volume + delta) / MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+    ELSE
+        IF MODPlayerRef_Channel(chan).volume - delta < 0 THEN delta = MODPlayerRef_Channel(chan).volume
+        SoftSynth_SetVoiceVolume chan, (MODPlayerRef_Channel(chan).volume - delta) / MODPLAYERREF_INSTRUMENT_VOLUME_MAX
+    END IF
+
+    MODPlayerRef_Channel(chan).tremoloPosition = MODPlayerRef_Channel(chan).tremoloPosition + MODPlayerRef_Channel(chan).tremoloSpeed
+    IF MODPlayerRef_Channel(chan).tremoloPosition > 31 THEN MODPlayerRef_Channel(chan).tremoloPosition = MODPlayerRef_Channel(chan).tremoloPosition - 64
+END SUB
+
+
+' Carry out an invert loop (EFx) effect
+' This will trash the sample managed by the SoftSynth
+SUB MODPlayerRef_DoInvertLoop (chan AS _UNSIGNED _BYTE)
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+    SHARED MODPlayerRef_Instrument() AS MODPlayerRef_InstrumentType
+    SHARED MODPlayerRef_InvertLoopSpeedTable() AS _UNSIGNED _BYTE
+
+    MODPlayerRef_Channel(chan).invertLoopDelay = MODPlayerRef_Channel(chan).invertLoopDelay + MODPlayerRef_InvertLoopSpeedTable(MODPlayerRef_Channel(chan).invertLoopSpeed)
+
+    DIM sampleNumber AS _UNSIGNED _BYTE: sampleNumber = MODPlayerRef_Channel(chan).instrument ' cache the sample number case we'll use this often below
+
+    IF MODPlayerRef_Channel(chan).invertLoopDelay >= 128 AND MODPLAYERREF_PLAY_FORWARD_LOOP = MODPlayerRef_Instrument(sampleNumber).playMode THEN
+        MODPlayerRef_Channel(chan).invertLoopDelay = 0 ' reset delay
+        IF MODPlayerRef_Channel(chan).invertLoopPosition < MODPlayerRef_Instrument(sampleNumber).loopStart THEN
+            MODPlayerRef_Channel(chan).invertLoopPosition = MODPlayerRef_Instrument(sampleNumber).loopStart
+        END IF
+        MODPlayerRef_Channel(chan).invertLoopPosition = MODPlayerRef_Channel(chan).invertLoopPosition + 1 ' increment position by 1
+        IF MODPlayerRef_Channel(chan).invertLoopPosition >= MODPlayerRef_Instrument(sampleNumber).loopEnd THEN
+            MODPlayerRef_Channel(chan).invertLoopPosition = MODPlayerRef_Instrument(sampleNumber).loopStart
+        END IF
+
+        ' Yeah I know, this is weird. QB64 NOT is bitwise and not logical
+        DIM p AS _UNSIGNED LONG: p = SoftSynth_BytesToFrames(MODPlayerRef_Channel(chan).invertLoopPosition, MODPlayerRef_Instrument(sampleNumber).bytesPerSample, MODPlayerRef_Instrument(sampleNumber).channels)
+        SoftSynth_PokeSoundFrameByte sampleNumber, p, NOT SoftSynth_PeekSoundFrameByte(sampleNumber, p)
+    END IF
+END SUB
+
+
+' This gives us the frequency in khz based on the period
+FUNCTION MODPlayerRef_GetFrequencyFromPeriod~& (period AS LONG)
+    $CHECKING:OFF
+    MODPlayerRef_GetFrequencyFromPeriod = 14317056 \ period
+    $CHECKING:ON
+END FUNCTION
+
+
+' Return C2 speed for a finetune
+FUNCTION MODPlayerRef_GetC2Spd~% (ft AS _UNSIGNED _BYTE)
+    $CHECKING:OFF
+    SELECT CASE ft
+        CASE 0
+            MODPlayerRef_GetC2Spd = 8363
+        CASE 1
+            MODPlayerRef_GetC2Spd = 8413
+        CASE 2
+            MODPlayerRef_GetC2Spd = 8463
+        CASE 3
+            MODPlayerRef_GetC2Spd = 8529
+        CASE 4
+            MODPlayerRef_GetC2Spd = 8581
+        CASE 5
+            MODPlayerRef_GetC2Spd = 8651
+        CASE 6
+            MODPlayerRef_GetC2Spd = 8723
+        CASE 7
+            MODPlayerRef_GetC2Spd = 8757
+        CASE 8
+            MODPlayerRef_GetC2Spd = 7895
+        CASE 9
+            MODPlayerRef_GetC2Spd = 7941
+        CASE 10
+            MODPlayerRef_GetC2Spd = 7985
+        CASE 11
+            MODPlayerRef_GetC2Spd = 8046
+        CASE 12
+            MODPlayerRef_GetC2Spd = 8107
+        CASE 13
+            MODPlayerRef_GetC2Spd = 8169
+        CASE 14
+            MODPlayerRef_GetC2Spd = 8232
+        CASE 15
+            MODPlayerRef_GetC2Spd = 8280
+        CASE ELSE
+            MODPlayerRef_GetC2Spd = 8363
+    END SELECT
+    $CHECKING:ON
+END FUNCTION
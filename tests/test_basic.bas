@@ -3,23 +3,110 @@ $LET TOOLBOX64_STRICT = TRUE
 $CONSOLE:ONLY
 
 '$INCLUDE:'../DS/HashTable.bi'
+'$INCLUDE:'../DS/MemFile.bi'
+'$INCLUDE:'../Core/BitwiseOps.bi'
 '$INCLUDE:'../FS/Pathname.bi'
 '$INCLUDE:'../DS/StringFile.bi'
 '$INCLUDE:'../Math/Math.bi'
 '$INCLUDE:'../Math/Vector2f.bi'
 '$INCLUDE:'../Math/Vector2i.bi'
 '$INCLUDE:'../Math/Bounds2i.bi'
+'$INCLUDE:'MODPlayerRef.bi'
+
+DECLARE LIBRARY "HashTableBench"
+    FUNCTION HashTableBench_GetHardwareThreads~&
+    FUNCTION HashTableBench_RunConcurrent~& (BYVAL t AS _UNSIGNED _OFFSET, BYVAL threadCount AS _UNSIGNED LONG, BYVAL keysPerThread AS _UNSIGNED LONG)
+END DECLARE
+
+' SoftSynth.bi carries the sound pipe SUBs, so only the mixer entry points are declared here
+DECLARE LIBRARY "../Audio/SoftSynth"
+    FUNCTION __SoftSynth_Initialize%% (BYVAL sampleRate AS _UNSIGNED LONG)
+    SUB __SoftSynth_Finalize
+    SUB __SoftSynth_Update (buffer AS SINGLE, BYVAL frames AS _UNSIGNED LONG)
+    SUB __SoftSynth_LoadSound (BYVAL snd AS LONG, buffer AS STRING, BYVAL bytes AS _UNSIGNED LONG, BYVAL bytesPerSample AS _UNSIGNED _BYTE, BYVAL channels AS _UNSIGNED _BYTE)
+    SUB SoftSynth_SetTotalVoices (BYVAL voices AS _UNSIGNED LONG)
+    FUNCTION SoftSynth_GetActiveVoices~&
+    SUB SoftSynth_SetVoiceBalance (BYVAL voice AS _UNSIGNED LONG, BYVAL balance AS SINGLE)
+    SUB SoftSynth_SetVoiceFrequency (BYVAL voice AS _UNSIGNED LONG, BYVAL frequency AS _UNSIGNED LONG)
+    SUB SoftSynth_PlayVoice (BYVAL voice AS _UNSIGNED LONG, BYVAL snd AS LONG, BYVAL position AS _UNSIGNED LONG, BYVAL mode AS LONG, BYVAL startFrame AS _UNSIGNED LONG, BYVAL endFrame AS _UNSIGNED LONG)
+    SUB SoftSynth_StopVoice (BYVAL voice AS _UNSIGNED LONG)
+    SUB SoftSynth_SetBitExactMixing (BYVAL enable AS _BYTE)
+    SUB SoftSynth_SetVoiceInterpolation (BYVAL voice AS _UNSIGNED LONG, BYVAL interpolation AS LONG)
+    FUNCTION SoftSynth_GetVoiceInterpolation& (BYVAL voice AS _UNSIGNED LONG)
+    FUNCTION SoftSynth_GetMixerThreads~&
+    SUB SoftSynth_SetMixerThreads (BYVAL threads AS _UNSIGNED LONG)
+    SUB SoftSynth_SetNativeSoundStorage (BYVAL enable AS _BYTE)
+    FUNCTION SoftSynth_GetSoundBytesPerSample~%% (BYVAL snd AS LONG)
+    SUB SoftSynth_SetRampFrames (BYVAL frames AS _UNSIGNED LONG)
+    SUB SoftSynth_SetVoiceVolume (BYVAL voice AS _UNSIGNED LONG, BYVAL volume AS SINGLE)
+    SUB SoftSynth_SetGlobalVolume (BYVAL volume AS SINGLE)
+    FUNCTION __SoftSynth_GetBus& (busName AS STRING)
+    FUNCTION __SoftSynth_CreateBus& (busName AS STRING)
+    SUB SoftSynth_SetBusGain (BYVAL bus AS _UNSIGNED LONG, BYVAL gain AS SINGLE)
+    SUB SoftSynth_SetVoiceBus (BYVAL voice AS _UNSIGNED LONG, BYVAL bus AS _UNSIGNED LONG)
+    SUB SoftSynth_MixBusBuffer (BYVAL bus AS _UNSIGNED LONG, buffer AS SINGLE, BYVAL frames AS _UNSIGNED LONG)
+    SUB SoftSynth_SetReverbEnabled (BYVAL enable AS _BYTE)
+    FUNCTION SoftSynth_GetReverbBus&
+    SUB SoftSynth_SetVoiceReverbSend (BYVAL voice AS _UNSIGNED LONG, BYVAL level AS SINGLE)
+    SUB SoftSynth_SetCommandQueueEnabled (BYVAL enable AS _BYTE)
+    SUB SoftSynth_SetCommandOffset (BYVAL frames AS _UNSIGNED LONG)
+    FUNCTION SoftSynth_IsRenderThreadRunning%%
+    SUB SoftSynth_StartRenderThread (BYVAL latency AS _UNSIGNED LONG, BYVAL blockFrames AS _UNSIGNED LONG)
+    SUB SoftSynth_StopRenderThread
+    FUNCTION __SoftSynth_ReadRenderBuffer~& (buffer AS SINGLE, BYVAL frames AS _UNSIGNED LONG)
+    FUNCTION SoftSynth_GetRenderBufferedFrames~&
+    FUNCTION SoftSynth_GetRenderUnderruns~&&
+    FUNCTION SoftSynth_GetSampleRate~&
+    FUNCTION SoftSynth_GetVoiceFrequency~& (BYVAL voice AS _UNSIGNED LONG)
+    FUNCTION SoftSynth_GetVoiceVolume! (BYVAL voice AS _UNSIGNED LONG)
+    FUNCTION SoftSynth_GetVoiceBalance! (BYVAL voice AS _UNSIGNED LONG)
+    FUNCTION SoftSynth_BytesToFrames~& (BYVAL bytes AS _UNSIGNED LONG, BYVAL bytesPerSample AS _UNSIGNED _BYTE, BYVAL channels AS _UNSIGNED _BYTE)
+    FUNCTION SoftSynth_PeekSoundFrameByte%% (BYVAL snd AS LONG, BYVAL position AS _UNSIGNED LONG)
+    SUB SoftSynth_PokeSoundFrameByte (BYVAL snd AS LONG, BYVAL position AS _UNSIGNED LONG, BYVAL frame AS _BYTE)
+END DECLARE
+
+' MODPlayer.bi pulls in SoftSynth.bi, so only the native sequencer entry points are declared here
+DECLARE LIBRARY "../Audio/MODPlayer"
+    FUNCTION __MODPlayer_Initialize%% (BYVAL channels AS _UNSIGNED LONG, BYVAL orders AS _UNSIGNED INTEGER, BYVAL rows AS _UNSIGNED _BYTE, BYVAL patterns AS _UNSIGNED INTEGER, BYVAL instruments AS _UNSIGNED LONG, BYVAL endJumpOrder AS _UNSIGNED _BYTE, BYVAL defaultSpeed AS _UNSIGNED _BYTE, BYVAL defaultBPM AS _UNSIGNED _BYTE, BYVAL useST300VolumeSlides AS _BYTE)
+    SUB __MODPlayer_Finalize
+    SUB __MODPlayer_SetTables (periodTable AS _UNSIGNED INTEGER, BYVAL periods AS _UNSIGNED LONG, sineTable AS _UNSIGNED _BYTE, BYVAL sines AS _UNSIGNED LONG, invertLoopSpeedTable AS _UNSIGNED _BYTE, BYVAL invertLoopSpeeds AS _UNSIGNED LONG)
+    SUB __MODPlayer_SetOrders (orders AS _UNSIGNED INTEGER)
+    SUB __MODPlayer_SetInstrument (BYVAL instrument AS _UNSIGNED LONG, BYVAL length AS _UNSIGNED LONG, BYVAL c2Spd AS _UNSIGNED INTEGER, BYVAL volume AS _UNSIGNED _BYTE, BYVAL loopStart AS _UNSIGNED LONG, BYVAL loopEnd AS _UNSIGNED LONG, BYVAL playMode AS LONG, BYVAL bytesPerSample AS _UNSIGNED _BYTE, BYVAL channels AS _UNSIGNED _BYTE)
+    SUB __MODPlayer_SetNote (BYVAL pattern AS _UNSIGNED INTEGER, BYVAL row AS _UNSIGNED _BYTE, BYVAL channel AS _UNSIGNED _BYTE, BYVAL note AS _UNSIGNED _BYTE, BYVAL instrument AS _UNSIGNED _BYTE, BYVAL volume AS _UNSIGNED _BYTE, BYVAL effect AS _UNSIGNED _BYTE, BYVAL operand AS _UNSIGNED _BYTE)
+    SUB __MODPlayer_Play
+    FUNCTION __MODPlayer_Update~&
+    FUNCTION __MODPlayer_IsPlaying%%
+    SUB __MODPlayer_SetLooping (BYVAL state AS _BYTE)
+    FUNCTION __MODPlayer_GetPosition&
+    FUNCTION __MODPlayer_GetRow%
+    FUNCTION __MODPlayer_GetSpeed~%%
+    FUNCTION __MODPlayer_GetBPM~%%
+END DECLARE
 
 TEST_BEGIN_ALL
 
 Test_Test
 Test_Hash
+Test_HashFlat
+Test_HashNumeric
+Test_HashBatch
+Test_HashSnapshot
+Test_HashIter
+Test_HashConcurrent
+Test_HashStats
+Test_MemFileMapped
+Test_MemFileChunked
+Test_MemFileArray
+Test_MemFileBits
+Test_MemFileStream
 Test_Pathname
 Test_StringFile
 Test_Math
 Test_Vector2f
 Test_Vector2i
 Test_Bounds2i
+Test_SoftSynth
+Test_MODPlayer
 
 TEST_END_ALL
 
@@ -123,6 +210,648 @@ SUB Test_Hash
     HashTable_Destroy myHashTable
 END SUB
 
+SUB Test_HashFlat
+    CONST TEST_LB = 0
+    CONST TEST_UB = 99999
+
+    DIM myHashTable AS _UNSIGNED _OFFSET: myHashTable = HashTable_CreateEx(HASHTABLE_BACKEND_FLAT)
+    DIM i AS _UNSIGNED LONG
+
+    TEST_CASE_BEGIN "HashTable (flat): Add element to hash table performance"
+    FOR i = TEST_LB TO TEST_UB
+        HashTable_SetLong myHashTable, i, i * 3
+    NEXT
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (flat): Lookup test"
+    TEST_REQUIRE HashTable_GetSize(myHashTable) = TEST_UB + 1, "HashTable_GetSize(myHashTable) = TEST_UB + 1"
+    DIM lookupFailed AS _BYTE
+    FOR i = TEST_LB TO TEST_UB
+        IF HashTable_GetLong(myHashTable, i) <> i * 3 THEN
+            lookupFailed = _TRUE
+            EXIT FOR
+        END IF
+    NEXT
+    TEST_REQUIRE NOT lookupFailed, "NOT lookupFailed"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (flat): Remove and insert test"
+    FOR i = TEST_LB TO TEST_UB STEP 2
+        HashTable_Remove myHashTable, i
+    NEXT
+    TEST_CHECK HashTable_GetSize(myHashTable) = (TEST_UB + 1) \ 2, "HashTable_GetSize(myHashTable) = (TEST_UB + 1) \ 2"
+    TEST_CHECK_FALSE HashTable_Contains(myHashTable, 42), "HashTable_Contains(myHashTable, 42)"
+    TEST_CHECK HashTable_Contains(myHashTable, 43), "HashTable_Contains(myHashTable, 43)"
+
+    HashTable_SetLong myHashTable, 42, 666
+    TEST_CHECK HashTable_GetLong(myHashTable, 42) = 666, "HashTable_GetLong(myHashTable, 42) = 666"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (flat): String keys and values"
+    HashTable_Clear myHashTable
+    TEST_CHECK HashTable_IsEmpty(myHashTable), "HashTable_IsEmpty(myHashTable)"
+
+    HashTable_StringSetString myHashTable, "short", "inline"
+    HashTable_StringSetString myHashTable, "a key that is too long to be stored inline", "a value that is too long to be stored inline"
+    HashTable_StringSetDouble myHashTable, "pi", 3.141592653589793#
+
+    TEST_CHECK HashTable_StringGetString(myHashTable, "short") = "inline", "HashTable_StringGetString(myHashTable, 'short') = 'inline'"
+    TEST_CHECK HashTable_StringGetString(myHashTable, "a key that is too long to be stored inline") = "a value that is too long to be stored inline", "HashTable_StringGetString(long key)"
+    TEST_CHECK HashTable_StringGetDouble(myHashTable, "pi") = 3.141592653589793#, "HashTable_StringGetDouble(myHashTable, 'pi')"
+
+    HashTable_StringSetString myHashTable, "short", "a replacement value that no longer fits inline"
+    TEST_CHECK HashTable_StringGetString(myHashTable, "short") = "a replacement value that no longer fits inline", "HashTable_StringGetString(myHashTable, 'short') after grow"
+
+    TEST_CHECK HashTable_StringRemove(myHashTable, "pi"), "HashTable_StringRemove(myHashTable, 'pi')"
+    TEST_CHECK_FALSE HashTable_StringContains(myHashTable, "pi"), "HashTable_StringContains(myHashTable, 'pi')"
+    TEST_CHECK HashTable_GetSize(myHashTable) = 2, "HashTable_GetSize(myHashTable) = 2"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (flat): Arena value churn"
+    HashTable_Clear myHashTable
+
+    DIM pass AS LONG
+    FOR pass = 1 TO 4
+        FOR i = TEST_LB TO TEST_UB STEP 10
+            HashTable_SetString myHashTable, i, STRING$(16 + (i + pass * 7) MOD 200, 65 + pass)
+        NEXT
+        FOR i = TEST_LB TO TEST_UB STEP 20
+            HashTable_Remove myHashTable, i
+        NEXT
+    NEXT
+
+    DIM valueFailed AS _BYTE
+    FOR i = TEST_LB + 10 TO TEST_UB STEP 20
+        IF HashTable_GetString(myHashTable, i) <> STRING$(16 + (i + 4 * 7) MOD 200, 69) THEN
+            valueFailed = _TRUE
+            EXIT FOR
+        END IF
+    NEXT
+    TEST_CHECK NOT valueFailed, "NOT valueFailed"
+    TEST_CHECK HashTable_GetSize(myHashTable) = (TEST_UB + 1) \ 20, "HashTable_GetSize(myHashTable) = (TEST_UB + 1) \ 20"
+    TEST_CASE_END
+
+    HashTable_Destroy myHashTable
+END SUB
+
+SUB Test_HashNumeric
+    CONST TEST_LB = 0
+    CONST TEST_UB = 99999
+
+    DIM myHashTable AS _UNSIGNED _OFFSET: myHashTable = HashTable_CreateNumeric
+    DIM i AS _UNSIGNED LONG
+
+    TEST_CASE_BEGIN "HashTable (numeric): Add element to hash table performance"
+    FOR i = TEST_LB TO TEST_UB
+        HashTable_NumericSetLong myHashTable, i, i * 3
+    NEXT
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (numeric): Lookup performance"
+    TEST_REQUIRE HashTable_NumericGetSize(myHashTable) = TEST_UB + 1, "HashTable_NumericGetSize(myHashTable) = TEST_UB + 1"
+    DIM lookupFailed AS _BYTE
+    FOR i = TEST_LB TO TEST_UB
+        IF HashTable_NumericGetLong(myHashTable, i) <> i * 3 THEN
+            lookupFailed = _TRUE
+            EXIT FOR
+        END IF
+    NEXT
+    TEST_REQUIRE NOT lookupFailed, "NOT lookupFailed"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (numeric): Remove and insert test"
+    FOR i = TEST_LB TO TEST_UB STEP 2
+        HashTable_NumericRemove myHashTable, i
+    NEXT
+    TEST_CHECK HashTable_NumericGetSize(myHashTable) = (TEST_UB + 1) \ 2, "HashTable_NumericGetSize(myHashTable) = (TEST_UB + 1) \ 2"
+    TEST_CHECK_FALSE HashTable_NumericContains(myHashTable, 42), "HashTable_NumericContains(myHashTable, 42)"
+    TEST_CHECK HashTable_NumericContains(myHashTable, 43), "HashTable_NumericContains(myHashTable, 43)"
+    TEST_CHECK HashTable_NumericGetLong(myHashTable, 42) = 0, "HashTable_NumericGetLong(myHashTable, 42) = 0"
+
+    HashTable_NumericSetLong myHashTable, 42, 666
+    TEST_CHECK HashTable_NumericGetLong(myHashTable, 42) = 666, "HashTable_NumericGetLong(myHashTable, 42) = 666"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (numeric): 64-bit keys and value types"
+    HashTable_NumericClear myHashTable
+    TEST_CHECK HashTable_NumericIsEmpty(myHashTable), "HashTable_NumericIsEmpty(myHashTable)"
+
+    HashTable_NumericSetDouble myHashTable, &HFFFFFFFFFFFFFFFF~&&, 3.141592653589793#
+    HashTable_NumericSetInteger64 myHashTable, &H100000000~&&, -1234567890123&&
+    HashTable_NumericSetByte myHashTable, 1, -7
+
+    TEST_CHECK HashTable_NumericGetDouble(myHashTable, &HFFFFFFFFFFFFFFFF~&&) = 3.141592653589793#, "HashTable_NumericGetDouble(myHashTable, &HFFFFFFFFFFFFFFFF~&&)"
+    TEST_CHECK HashTable_NumericGetInteger64(myHashTable, &H100000000~&&) = -1234567890123&&, "HashTable_NumericGetInteger64(myHashTable, &H100000000~&&)"
+    TEST_CHECK_FALSE HashTable_NumericContains(myHashTable, 0), "HashTable_NumericContains(myHashTable, 0)"
+    TEST_CHECK HashTable_NumericGetByte(myHashTable, 1) = -7, "HashTable_NumericGetByte(myHashTable, 1) = -7"
+    TEST_CHECK HashTable_NumericGetSize(myHashTable) = 3, "HashTable_NumericGetSize(myHashTable) = 3"
+    TEST_CASE_END
+
+    HashTable_NumericDestroy myHashTable
+END SUB
+
+SUB Test_HashBatch
+    CONST TEST_LB = 0
+    CONST TEST_UB = 99999
+
+    DIM myHashTable AS _UNSIGNED _OFFSET: myHashTable = HashTable_CreateEx(HASHTABLE_BACKEND_FLAT)
+    DIM myNumericTable AS _UNSIGNED _OFFSET: myNumericTable = HashTable_CreateNumeric
+    DIM keys(TEST_LB TO TEST_UB) AS _UNSIGNED _OFFSET, numericKeys(TEST_LB TO TEST_UB) AS _UNSIGNED _INTEGER64
+    DIM values(TEST_LB TO TEST_UB) AS LONG, results(TEST_LB TO TEST_UB) AS LONG
+    DIM i AS _UNSIGNED LONG
+
+    FOR i = TEST_LB TO TEST_UB
+        keys(i) = i
+        numericKeys(i) = i
+        values(i) = i * 3
+    NEXT
+
+    TEST_CASE_BEGIN "HashTable (batch): Add elements to hash table performance"
+    HashTable_SetManyLong myHashTable, keys(), values()
+    HashTable_NumericSetManyLong myNumericTable, numericKeys(), values()
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (batch): Lookup test"
+    TEST_REQUIRE HashTable_GetSize(myHashTable) = TEST_UB + 1, "HashTable_GetSize(myHashTable) = TEST_UB + 1"
+    TEST_CHECK HashTable_GetManyLong(myHashTable, keys(), results()) = TEST_UB + 1, "HashTable_GetManyLong(myHashTable, keys(), results()) = TEST_UB + 1"
+    TEST_CHECK results(TEST_UB) = TEST_UB * 3, "results(TEST_UB) = TEST_UB * 3"
+    TEST_CHECK HashTable_NumericGetManyLong(myNumericTable, numericKeys(), results()) = TEST_UB + 1, "HashTable_NumericGetManyLong(myNumericTable, numericKeys(), results()) = TEST_UB + 1"
+    TEST_CHECK results(42) = 126, "results(42) = 126"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (batch): Remove test"
+    REDIM evenKeys(0 TO (TEST_UB + 1) \ 2 - 1) AS _UNSIGNED _OFFSET
+    FOR i = 0 TO UBOUND(evenKeys)
+        evenKeys(i) = i * 2
+    NEXT
+    TEST_CHECK HashTable_RemoveMany(myHashTable, evenKeys()) = (TEST_UB + 1) \ 2, "HashTable_RemoveMany(myHashTable, evenKeys()) = (TEST_UB + 1) \ 2"
+    TEST_CHECK HashTable_GetManyLong(myHashTable, keys(), results()) = (TEST_UB + 1) \ 2, "HashTable_GetManyLong(myHashTable, keys(), results()) = (TEST_UB + 1) \ 2"
+    TEST_CHECK results(42) = 0 AND results(43) = 129, "results(42) = 0 AND results(43) = 129"
+    TEST_CHECK HashTable_NumericRemoveMany(myNumericTable, numericKeys()) = TEST_UB + 1, "HashTable_NumericRemoveMany(myNumericTable, numericKeys()) = TEST_UB + 1"
+    TEST_CHECK HashTable_NumericIsEmpty(myNumericTable), "HashTable_NumericIsEmpty(myNumericTable)"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (batch): Packed string keys and values"
+    HashTable_Clear myHashTable
+
+    DIM pairs AS _UNSIGNED _OFFSET: pairs = MemFile_Create(0, 0)
+    DIM k AS STRING, v AS STRING
+    FOR i = 1 TO 3
+        k = "key" + STR$(i)
+        v = STRING$(i * 10, 64 + i)
+        MemFile_WriteLong pairs, LEN(k): MemFile_WriteString pairs, k
+        MemFile_WriteLong pairs, LEN(v): MemFile_WriteString pairs, v
+    NEXT
+    MemFile_Seek pairs, 0
+    TEST_CHECK HashTable_StringSetMany(myHashTable, pairs) = 3, "HashTable_StringSetMany(myHashTable, pairs) = 3"
+    TEST_CHECK HashTable_StringGetString(myHashTable, "key 2") = STRING$(20, 66), "HashTable_StringGetString(myHashTable, 'key 2')"
+
+    DIM packedKeys AS _UNSIGNED _OFFSET: packedKeys = MemFile_Create(0, 0)
+    DIM packedValues AS _UNSIGNED _OFFSET: packedValues = MemFile_Create(0, 0)
+    k = "key 3": MemFile_WriteLong packedKeys, LEN(k): MemFile_WriteString packedKeys, k
+    k = "nope": MemFile_WriteLong packedKeys, LEN(k): MemFile_WriteString packedKeys, k
+    MemFile_Seek packedKeys, 0
+    TEST_CHECK HashTable_StringGetMany(myHashTable, packedKeys, packedValues) = 1, "HashTable_StringGetMany(myHashTable, packedKeys, packedValues) = 1"
+    MemFile_Seek packedValues, 0
+    TEST_CHECK MemFile_ReadLong(packedValues) = 30, "MemFile_ReadLong(packedValues) = 30"
+    TEST_CHECK MemFile_ReadString(packedValues, 30) = STRING$(30, 67), "MemFile_ReadString(packedValues, 30)"
+    TEST_CHECK MemFile_ReadLong(packedValues) = HASHTABLE_PACKED_MISSING, "MemFile_ReadLong(packedValues) = HASHTABLE_PACKED_MISSING"
+
+    MemFile_Seek packedKeys, 0
+    TEST_CHECK HashTable_StringRemoveMany(myHashTable, packedKeys) = 1, "HashTable_StringRemoveMany(myHashTable, packedKeys) = 1"
+    TEST_CHECK HashTable_GetSize(myHashTable) = 2, "HashTable_GetSize(myHashTable) = 2"
+
+    MemFile_Destroy pairs
+    MemFile_Destroy packedKeys
+    MemFile_Destroy packedValues
+    TEST_CASE_END
+
+    HashTable_NumericDestroy myNumericTable
+    HashTable_Destroy myHashTable
+END SUB
+
+SUB Test_HashSnapshot
+    CONST TEST_LB = 0
+    CONST TEST_UB = 99999
+    CONST TEST_FILE = "test_hashtable.snapshot"
+
+    DIM myHashTable AS _UNSIGNED _OFFSET: myHashTable = HashTable_CreateEx(HASHTABLE_BACKEND_FLAT)
+    DIM i AS _UNSIGNED LONG
+
+    FOR i = TEST_LB TO TEST_UB
+        HashTable_SetLong myHashTable, i, i * 3
+    NEXT
+    HashTable_StringSetString myHashTable, "hello", "world"
+
+    TEST_CASE_BEGIN "HashTable (snapshot): Save performance"
+    TEST_REQUIRE HashTable_SaveSnapshot(myHashTable, TEST_FILE), "HashTable_SaveSnapshot(myHashTable, TEST_FILE)"
+    TEST_CASE_END
+
+    HashTable_Destroy myHashTable
+
+    TEST_CASE_BEGIN "HashTable (snapshot): Open and lookup test"
+    myHashTable = HashTable_OpenSnapshot(TEST_FILE)
+    TEST_REQUIRE myHashTable <> 0, "myHashTable <> 0"
+    TEST_CHECK HashTable_GetSize(myHashTable) = TEST_UB + 2, "HashTable_GetSize(myHashTable) = TEST_UB + 2"
+
+    DIM lookupFailed AS _BYTE
+    FOR i = TEST_LB TO TEST_UB
+        IF HashTable_GetLong(myHashTable, i) <> i * 3 THEN
+            lookupFailed = _TRUE
+            EXIT FOR
+        END IF
+    NEXT
+    TEST_CHECK NOT lookupFailed, "NOT lookupFailed"
+    TEST_CHECK_FALSE HashTable_Contains(myHashTable, TEST_UB + 1), "HashTable_Contains(myHashTable, TEST_UB + 1)"
+    TEST_CHECK HashTable_StringGetString(myHashTable, "hello") = "world", "HashTable_StringGetString(myHashTable, 'hello') = 'world'"
+
+    HashTable_Destroy myHashTable
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "HashTable (snapshot): Invalid files"
+    TEST_CHECK HashTable_OpenSnapshot("") = 0, "HashTable_OpenSnapshot('') = 0"
+
+    DIM fh AS LONG: fh = FREEFILE
+    OPEN TEST_FILE FOR OUTPUT AS fh
+    PRINT #fh, "This is not a snapshot"
+    CLOSE fh
+    TEST_CHECK HashTable_OpenSnapshot(TEST_FILE) = 0, "HashTable_OpenSnapshot(TEST_FILE) = 0"
+
+    KILL TEST_FILE
+    TEST_CASE_END
+END SUB
+
+SUB Test_HashIter
+    CONST TEST_LB = 1
+    CONST TEST_UB = 1000
+
+    DIM backend AS LONG, i AS _UNSIGNED LONG, c AS _UNSIGNED _OFFSET, count AS _UNSIGNED LONG, keySum AS _UNSIGNED _INTEGER64
+    DIM myHashTable AS _UNSIGNED _OFFSET
+
+    FOR backend = HASHTABLE_BACKEND_NODE TO HASHTABLE_BACKEND_FLAT
+        myHashTable = HashTable_CreateEx(backend)
+
+        TEST_CASE_BEGIN "HashTable (iterator): Walk test (backend" + STR$(backend) + ")"
+        TEST_CHECK HashTable_IterBegin(myHashTable) = 0, "HashTable_IterBegin(myHashTable) = 0"
+
+        FOR i = TEST_LB TO TEST_UB
+            HashTable_SetLong myHashTable, i, i * 3
+        NEXT
+
+        count = 0: keySum = 0
+        c = HashTable_IterBegin(myHashTable)
+        DO WHILE c
+            IF HashTable_IterGetValueLong(myHashTable, c) = HashTable_IterGetKey(myHashTable, c) * 3 THEN count = count + 1
+            keySum = keySum + HashTable_IterGetKey(myHashTable, c)
+            HashTable_SetLong myHashTable, HashTable_IterGetKey(myHashTable, c), -1 ' updating values must not disturb the walk
+            c = HashTable_IterNext(myHashTable, c)
+        LOOP
+        TEST_CHECK count = TEST_UB, "count = TEST_UB"
+        TEST_CHECK keySum = (TEST_UB * (TEST_UB + 1)) \ 2, "keySum = (TEST_UB * (TEST_UB + 1)) \ 2"
+        TEST_CHECK HashTable_GetLong(myHashTable, TEST_UB) = -1, "HashTable_GetLong(myHashTable, TEST_UB) = -1"
+
+        HashTable_Clear myHashTable
+        HashTable_StringSetString myHashTable, "hello", "world"
+        c = HashTable_IterBegin(myHashTable)
+        TEST_CHECK HashTable_IterGetKeyString(myHashTable, c) = "hello", "HashTable_IterGetKeyString(myHashTable, c) = 'hello'"
+        TEST_CHECK HashTable_IterGetValueString(myHashTable, c) = "world", "HashTable_IterGetValueString(myHashTable, c) = 'world'"
+        TEST_CHECK HashTable_IterNext(myHashTable, c) = 0, "HashTable_IterNext(myHashTable, c) = 0"
+        TEST_CASE_END
+
+        HashTable_Destroy myHashTable
+    NEXT
+
+    TEST_CASE_BEGIN "HashTable (iterator): Numeric table walk and remove test"
+    DIM myNumericTable AS _UNSIGNED _OFFSET: myNumericTable = HashTable_CreateNumeric
+    FOR i = TEST_LB TO TEST_UB
+        HashTable_NumericSetDouble myNumericTable, i, i / 2
+    NEXT
+
+    count = 0
+    c = HashTable_NumericIterBegin(myNumericTable)
+    DO WHILE c
+        IF HashTable_NumericIterGetValueDouble(myNumericTable, c) = HashTable_NumericIterGetKey(myNumericTable, c) / 2 THEN count = count + 1
+        IF HashTable_NumericIterGetKey(myNumericTable, c) MOD 2 = 0 THEN HashTable_NumericRemove myNumericTable, HashTable_NumericIterGetKey(myNumericTable, c)
+        c = HashTable_NumericIterNext(myNumericTable, c)
+    LOOP
+    TEST_CHECK count = TEST_UB, "count = TEST_UB"
+    TEST_CHECK HashTable_NumericGetSize(myNumericTable) = TEST_UB \ 2, "HashTable_NumericGetSize(myNumericTable) = TEST_UB \ 2"
+
+    HashTable_NumericDestroy myNumericTable
+    TEST_CASE_END
+END SUB
+
+SUB Test_HashConcurrent
+    CONST TEST_KEYS_PER_THREAD = 100000
+
+    DIM myHashTable AS _UNSIGNED _OFFSET: myHashTable = HashTable_CreateConcurrent(0)
+
+    TEST_CASE_BEGIN "HashTable (concurrent): API test"
+    HashTable_SetLong myHashTable, 42, 666
+    HashTable_StringSetString myHashTable, "hello", "world"
+    TEST_CHECK HashTable_GetLong(myHashTable, 42) = 666, "HashTable_GetLong(myHashTable, 42) = 666"
+    TEST_CHECK HashTable_StringGetString(myHashTable, "hello") = "world", "HashTable_StringGetString(myHashTable, 'hello') = 'world'"
+    TEST_CHECK HashTable_GetSize(myHashTable) = 2, "HashTable_GetSize(myHashTable) = 2"
+
+    DIM c AS _UNSIGNED _OFFSET, count AS LONG
+    c = HashTable_IterBegin(myHashTable)
+    DO WHILE c
+        count = count + 1
+        c = HashTable_IterNext(myHashTable, c)
+    LOOP
+    TEST_CHECK count = 2, "count = 2"
+
+    HashTable_Clear myHashTable
+    TEST_CHECK HashTable_IsEmpty(myHashTable), "HashTable_IsEmpty(myHashTable)"
+    TEST_CASE_END
+
+    ' Every thread does the same amount of work, so good scaling shows up as a flat run time as the thread count goes up. The single shard
+    ' table is the same as a table behind one global lock and is there for comparison
+    DIM threads AS _UNSIGNED LONG: threads = 1
+    DO
+        TEST_CASE_BEGIN "HashTable (concurrent): " + _TRIM$(STR$(threads)) + " thread(s), default shards"
+        TEST_CHECK HashTableBench_RunConcurrent(myHashTable, threads, TEST_KEYS_PER_THREAD) = 0, "HashTableBench_RunConcurrent() = 0"
+        TEST_CHECK HashTable_GetSize(myHashTable) = threads * TEST_KEYS_PER_THREAD \ 2, "HashTable_GetSize(myHashTable) = threads * TEST_KEYS_PER_THREAD \ 2"
+        HashTable_Clear myHashTable
+        TEST_CASE_END
+
+        DIM lockedHashTable AS _UNSIGNED _OFFSET: lockedHashTable = HashTable_CreateConcurrent(1)
+        TEST_CASE_BEGIN "HashTable (concurrent): " + _TRIM$(STR$(threads)) + " thread(s), 1 shard"
+        TEST_CHECK HashTableBench_RunConcurrent(lockedHashTable, threads, TEST_KEYS_PER_THREAD) = 0, "HashTableBench_RunConcurrent() = 0"
+        TEST_CASE_END
+        HashTable_Destroy lockedHashTable
+
+        IF threads >= HashTableBench_GetHardwareThreads THEN EXIT DO
+        threads = _MIN(threads * 2, HashTableBench_GetHardwareThreads)
+    LOOP
+
+    HashTable_Destroy myHashTable
+END SUB
+
+SUB Test_HashStats
+    CONST TEST_ENTRIES = 10000
+
+    DIM backend AS LONG, i AS LONG, stats AS HashTable_StatsType
+    FOR backend = HASHTABLE_BACKEND_NODE TO HASHTABLE_BACKEND_CONCURRENT
+        DIM myHashTable AS _UNSIGNED _OFFSET: myHashTable = HashTable_CreateEx(backend)
+
+        TEST_CASE_BEGIN "HashTable (backend" + STR$(backend) + "): Statistics"
+        HashTable_GetStats myHashTable, stats
+        TEST_CHECK stats.size = 0, "stats.size = 0"
+        TEST_CHECK stats.keyBytes = 0, "stats.keyBytes = 0"
+
+        FOR i = 1 TO TEST_ENTRIES
+            HashTable_StringSetString myHashTable, "key" + _TRIM$(STR$(i)), "value"
+        NEXT i
+
+        HashTable_GetStats myHashTable, stats
+        TEST_CHECK stats.size = TEST_ENTRIES, "stats.size = TEST_ENTRIES"
+        TEST_CHECK stats.slots >= stats.size, "stats.slots >= stats.size"
+        TEST_CHECK stats.loadFactor > 0 _ANDALSO stats.loadFactor <= 1!, "stats.loadFactor > 0 _ANDALSO stats.loadFactor <= 1"
+        TEST_CHECK stats.valueBytes = TEST_ENTRIES * 5, "stats.valueBytes = TEST_ENTRIES * 5"
+        TEST_CHECK stats.maxProbeLength >= 1, "stats.maxProbeLength >= 1"
+        TEST_CHECK stats.meanProbeLength >= 1! _ANDALSO stats.meanProbeLength <= stats.maxProbeLength, "stats.meanProbeLength >= 1 _ANDALSO stats.meanProbeLength <= stats.maxProbeLength"
+        TEST_CHECK stats.rehashCount > 0, "stats.rehashCount > 0"
+        TEST_CHECK stats.metadataBytes > 0, "stats.metadataBytes > 0"
+        TEST_CASE_END
+
+        HashTable_Destroy myHashTable
+    NEXT backend
+
+    DIM myNumericTable AS _UNSIGNED _OFFSET: myNumericTable = HashTable_CreateNumeric
+
+    TEST_CASE_BEGIN "HashTable (numeric): Statistics"
+    FOR i = 1 TO TEST_ENTRIES
+        HashTable_NumericSetLong myNumericTable, i, i
+    NEXT i
+
+    HashTable_NumericGetStats myNumericTable, stats
+    TEST_CHECK stats.size = TEST_ENTRIES, "stats.size = TEST_ENTRIES"
+    TEST_CHECK stats.keyBytes = TEST_ENTRIES * 8, "stats.keyBytes = TEST_ENTRIES * 8"
+    TEST_CHECK stats.loadFactor <= 0.875!, "stats.loadFactor <= 0.875"
+    TEST_CASE_END
+
+    HashTable_NumericDestroy myNumericTable
+END SUB
+
+SUB Test_MemFileMapped
+    CONST TEST_FILE = "test_memfile.bin"
+    CONST TEST_DATA = "The quick brown fox jumps over the lazy dog"
+
+    DIM fh AS LONG: fh = FREEFILE
+    OPEN TEST_FILE FOR BINARY AS fh
+    PUT #fh, , TEST_DATA
+    CLOSE fh
+
+    TEST_CASE_BEGIN "MemFile (mapped): Read-only"
+    DIM memFile AS _UNSIGNED _OFFSET: memFile = MemFile_CreateFromFile(TEST_FILE, _FALSE)
+    TEST_REQUIRE memFile <> 0, "memFile <> 0"
+    TEST_CHECK MemFile_GetSize(memFile) = LEN(TEST_DATA), "MemFile_GetSize(memFile) = LEN(TEST_DATA)"
+    TEST_CHECK MemFile_ReadString(memFile, 3) = "The", "MemFile_ReadString(memFile, 3) = 'The'"
+    MemFile_Seek memFile, 40
+    TEST_CHECK MemFile_ReadString(memFile, 10) = "dog", "MemFile_ReadString(memFile, 10) = 'dog'"
+    TEST_CHECK MemFile_IsEOF(memFile), "MemFile_IsEOF(memFile)"
+    DIM b AS _UNSIGNED _BYTE: b = 88
+    MemFile_Seek memFile, 0
+    TEST_CHECK MemFile_Write(memFile, _OFFSET(b), 1) = 0, "MemFile_Write(memFile, _OFFSET(b), 1) = 0"
+    MemFile_Destroy memFile
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "MemFile (mapped): Copy-on-write"
+    memFile = MemFile_CreateFromFile(TEST_FILE, _TRUE)
+    TEST_REQUIRE memFile <> 0, "memFile <> 0"
+    MemFile_WriteString memFile, "A"
+    MemFile_Seek memFile, 0
+    TEST_CHECK MemFile_ReadString(memFile, 5) = "A qui", "MemFile_ReadString(memFile, 5) = 'A qui'"
+    MemFile_Seek memFile, MemFile_GetSize(memFile)
+    MemFile_WriteString memFile, "!"
+    TEST_CHECK MemFile_GetSize(memFile) = LEN(TEST_DATA) + 1, "MemFile_GetSize(memFile) = LEN(TEST_DATA) + 1"
+    MemFile_Seek memFile, 0
+    TEST_CHECK MemFile_ReadString(memFile, 100) = "A" + MID$(TEST_DATA, 2) + "!", "MemFile_ReadString(memFile, 100) = 'A' + MID$(TEST_DATA, 2) + '!'"
+    MemFile_Destroy memFile
+
+    memFile = MemFile_CreateFromFile(TEST_FILE, _FALSE)
+    TEST_CHECK MemFile_ReadString(memFile, 100) = TEST_DATA, "MemFile_ReadString(memFile, 100) = TEST_DATA"
+    MemFile_Destroy memFile
+    TEST_CASE_END
+
+    TEST_CHECK MemFile_CreateFromFile("", _FALSE) = 0, "MemFile_CreateFromFile('', _FALSE) = 0"
+
+    KILL TEST_FILE
+END SUB
+
+SUB Test_MemFileChunked
+    CONST TEST_BYTES = 10000000
+
+    TEST_CASE_BEGIN "MemFile (chunked): API test"
+    DIM memFile AS _UNSIGNED _OFFSET: memFile = MemFile_CreateChunked(16)
+    TEST_REQUIRE memFile <> 0, "memFile <> 0"
+    MemFile_WriteString memFile, "The quick brown fox jumps over the lazy dog"
+    TEST_CHECK MemFile_GetSize(memFile) = 43, "MemFile_GetSize(memFile) = 43"
+    MemFile_Seek memFile, 10
+    TEST_CHECK MemFile_ReadString(memFile, 15) = "brown fox jumps", "MemFile_ReadString(memFile, 15) = 'brown fox jumps'"
+    MemFile_Resize memFile, 12
+    MemFile_Resize memFile, 20
+    MemFile_Seek memFile, 0
+    TEST_CHECK MemFile_ReadString(memFile, 20) = "The quick br" + STRING$(8, 0), "MemFile_ReadString(memFile, 20) = 'The quick br' + STRING$(8, 0)"
+    MemFile_Flatten memFile
+    TEST_CHECK MemFile_GetSize(memFile) = 20, "MemFile_GetSize(memFile) = 20"
+    TEST_CHECK MemFile_GetPosition(memFile) = 20, "MemFile_GetPosition(memFile) = 20"
+    MemFile_Seek memFile, 4
+    TEST_CHECK MemFile_ReadString(memFile, 5) = "quick", "MemFile_ReadString(memFile, 5) = 'quick'"
+    MemFile_Destroy memFile
+    TEST_CASE_END
+
+    DIM i AS _UNSIGNED LONG
+
+    TEST_CASE_BEGIN "MemFile (chunked): Append performance"
+    memFile = MemFile_CreateChunked(0)
+    FOR i = 1 TO TEST_BYTES
+        MemFile_WriteByte memFile, i
+    NEXT i
+    MemFile_Flatten memFile
+    TEST_CHECK MemFile_GetSize(memFile) = TEST_BYTES, "MemFile_GetSize(memFile) = TEST_BYTES"
+    MemFile_Destroy memFile
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "MemFile (buffer): Append performance"
+    memFile = MemFile_Create(0, 0)
+    FOR i = 1 TO TEST_BYTES
+        MemFile_WriteByte memFile, i
+    NEXT i
+    TEST_CHECK MemFile_GetSize(memFile) = TEST_BYTES, "MemFile_GetSize(memFile) = TEST_BYTES"
+    MemFile_Destroy memFile
+    TEST_CASE_END
+END SUB
+
+SUB Test_MemFileArray
+    CONST TEST_ELEMENTS = 1000000
+
+    DIM memFile AS _UNSIGNED _OFFSET: memFile = MemFile_Create(0, 0)
+    DIM i AS LONG
+
+    TEST_CASE_BEGIN "MemFile (array): Byte order"
+    DIM w(1 TO 3) AS LONG: w(1) = &H01020304: w(2) = -2: w(3) = 42
+    MemFile_WriteArrayLong memFile, w(), _TRUE
+    TEST_CHECK w(1) = &H01020304, "w(1) = &H01020304"
+    MemFile_Seek memFile, 0
+    TEST_CHECK MemFile_ReadString(memFile, 4) = CHR$(1) + CHR$(2) + CHR$(3) + CHR$(4), "MemFile_ReadString(memFile, 4) = CHR$(1) + CHR$(2) + CHR$(3) + CHR$(4)"
+
+    DIM r(0 TO 9) AS LONG
+    MemFile_Seek memFile, 0
+    TEST_CHECK MemFile_ReadArrayLong(memFile, r(), _TRUE) = 3, "MemFile_ReadArrayLong(memFile, r(), _TRUE) = 3"
+    TEST_CHECK r(0) = &H01020304 _ANDALSO r(1) = -2 _ANDALSO r(2) = 42, "r(0) = &H01020304 _ANDALSO r(1) = -2 _ANDALSO r(2) = 42"
+    TEST_CHECK MemFile_ReadArrayLong(memFile, r(), _TRUE) = 0, "MemFile_ReadArrayLong(memFile, r(), _TRUE) = 0"
+    TEST_CASE_END
+
+    DIM d(1 TO TEST_ELEMENTS) AS DOUBLE, e(1 TO TEST_ELEMENTS) AS DOUBLE
+    FOR i = 1 TO TEST_ELEMENTS
+        d(i) = i / 3#
+    NEXT i
+
+    TEST_CASE_BEGIN "MemFile (array): Swapped DOUBLE round trip performance"
+    MemFile_Resize memFile, 0
+    MemFile_WriteArrayDouble memFile, d(), _TRUE
+    MemFile_Seek memFile, 0
+    TEST_CHECK MemFile_ReadArrayDouble(memFile, e(), _TRUE) = TEST_ELEMENTS, "MemFile_ReadArrayDouble(memFile, e(), _TRUE) = TEST_ELEMENTS"
+    TEST_CHECK e(TEST_ELEMENTS) = d(TEST_ELEMENTS), "e(TEST_ELEMENTS) = d(TEST_ELEMENTS)"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "MemFile (array): Swapped DOUBLE per element performance"
+    MemFile_Seek memFile, 0
+    DIM q AS _UNSIGNED _INTEGER64
+    FOR i = 1 TO TEST_ELEMENTS
+        q = MemFile_ReadInteger64(memFile)
+        e(i) = _CV(DOUBLE, _MK$(_UNSIGNED _INTEGER64, ByteSwapInteger64(q)))
+    NEXT i
+    TEST_CHECK e(TEST_ELEMENTS) = d(TEST_ELEMENTS), "e(TEST_ELEMENTS) = d(TEST_ELEMENTS)"
+    TEST_CASE_END
+
+    MemFile_Destroy memFile
+END SUB
+
+SUB Test_MemFileBits
+    CONST TEST_CODES = 1000000
+
+    DIM memFile AS _UNSIGNED _OFFSET: memFile = MemFile_CreateFromString(CHR$(&HB2) + CHR$(&H0F))
+
+    TEST_CASE_BEGIN "MemFile (bits): Bit order"
+    TEST_CHECK MemFile_ReadBits(memFile, 3) = 2, "MemFile_ReadBits(memFile, 3) = 2"
+    TEST_CHECK MemFile_PeekBits(memFile, 5) = &H16, "MemFile_PeekBits(memFile, 5) = &H16"
+    TEST_CHECK MemFile_ReadBits(memFile, 9) = &H1F6, "MemFile_ReadBits(memFile, 9) = &H1F6"
+    MemFile_SetBitOrder memFile, _TRUE
+    MemFile_Seek memFile, 0
+    TEST_CHECK MemFile_ReadBits(memFile, 3) = 5, "MemFile_ReadBits(memFile, 3) = 5"
+    TEST_CHECK MemFile_ReadBits(memFile, 9) = &H120, "MemFile_ReadBits(memFile, 9) = &H120"
+    MemFile_AlignBits memFile
+    TEST_CHECK MemFile_IsEOF(memFile), "MemFile_IsEOF(memFile)"
+    TEST_CASE_END
+
+    MemFile_Destroy memFile
+
+    DIM i AS LONG, codeSize AS _UNSIGNED LONG, failed AS _UNSIGNED LONG
+
+    TEST_CASE_BEGIN "MemFile (bits): Variable width code round trip performance"
+    memFile = MemFile_Create(0, 0)
+    FOR i = 1 TO TEST_CODES
+        codeSize = 3 + i MOD 10
+        MemFile_WriteBits memFile, i, codeSize
+    NEXT i
+    MemFile_FlushBits memFile
+    MemFile_Seek memFile, 0
+    FOR i = 1 TO TEST_CODES
+        codeSize = 3 + i MOD 10
+        IF MemFile_ReadBits(memFile, codeSize) <> (i AND (_SHL(1, codeSize) - 1)) THEN failed = failed + 1
+    NEXT i
+    TEST_CHECK failed = 0, "failed = 0"
+    MemFile_Destroy memFile
+    TEST_CASE_END
+END SUB
+
+SUB Test_MemFileStream
+    CONST TEST_LINES = 100000
+
+    DIM i AS LONG, text AS STRING, chunk AS STRING, decoded AS STRING
+
+    FOR i = 1 TO TEST_LINES
+        text = text + "Line" + STR$(i) + CHR$(10)
+    NEXT i
+
+    TEST_CASE_BEGIN "MemFile (stream): Inflate performance"
+    DIM source AS _UNSIGNED _OFFSET: source = MemFile_CreateFromString(_DEFLATE$(text))
+    DIM stream AS _UNSIGNED _OFFSET: stream = MemFile_OpenInflateStream(source)
+    DO UNTIL MemFile_IsEOF(stream)
+        chunk = MemFile_ReadString(stream, 4096)
+        decoded = decoded + chunk
+    LOOP
+    TEST_CHECK decoded = text, "decoded = text"
+    MemFile_Seek stream, 7
+    TEST_CHECK MemFile_ReadString(stream, 6) = "Line 2", "MemFile_ReadString(stream, 6) = 'Line 2'"
+    MemFile_Destroy stream
+    MemFile_Destroy source
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "MemFile (stream): Deflate performance"
+    DIM target AS _UNSIGNED _OFFSET: target = MemFile_Create(0, 0)
+    stream = MemFile_OpenDeflateStream(target)
+    MemFile_WriteString stream, text
+    TEST_CHECK MemFile_GetSize(stream) = LEN(text), "MemFile_GetSize(stream) = LEN(text)"
+    MemFile_Destroy stream
+    TEST_CHECK MemFile_GetSize(target) < LEN(text), "MemFile_GetSize(target) < LEN(text)"
+    MemFile_Seek target, 0
+    TEST_CHECK _INFLATE$(MemFile_ReadString(target, MemFile_GetSize(target))) = text, "_INFLATE$(MemFile_ReadString(target, MemFile_GetSize(target))) = text"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "MemFile (stream): Round trip"
+    MemFile_Seek target, 0
+    stream = MemFile_OpenInflateStream(target)
+    TEST_CHECK MemFile_ReadString(stream, LEN(text)) = text, "MemFile_ReadString(stream, LEN(text)) = text"
+    TEST_CHECK MemFile_IsEOF(stream), "MemFile_IsEOF(stream)"
+    MemFile_Destroy stream
+    MemFile_Destroy target
+    TEST_CASE_END
+END SUB
+
 SUB Test_Pathname
     TEST_CASE_BEGIN "Pathname"
 
@@ -330,6 +1059,25 @@ SUB Test_StringFile
     TEST_CHECK StringFile_ReadString(sf, 6) = "123456", "Content after EOF write"
 
     TEST_CASE_END
+
+    CONST TEST_RECORDS = 1000000
+
+    DIM i AS LONG, sum AS _UNSIGNED _INTEGER64
+
+    TEST_CASE_BEGIN "StringFile: Unaligned read performance"
+    StringFile_Create sf, ""
+    FOR i = 1 TO TEST_RECORDS
+        StringFile_WriteByte sf, i
+        StringFile_WriteLong sf, i
+    NEXT i
+    TEST_CHECK StringFile_GetSize(sf) = TEST_RECORDS * 5, "StringFile_GetSize(sf) = TEST_RECORDS * 5"
+    StringFile_Seek sf, 0
+    FOR i = 1 TO TEST_RECORDS
+        sum = sum + StringFile_ReadByte(sf) + StringFile_ReadLong(sf)
+    NEXT i
+    TEST_CHECK StringFile_IsEOF(sf), "StringFile_IsEOF(sf)"
+    TEST_CHECK sum > 0, "sum > 0"
+    TEST_CASE_END
 END SUB
 
 SUB Test_Math
@@ -807,5 +1555,632 @@ SUB Test_Bounds2i
     TEST_CASE_END
 END SUB
 
+' Starts the same set of voices on every call so that mixer output can be compared
+SUB Test_SoftSynthStartVoices (voices AS _UNSIGNED LONG, soundFrames AS _UNSIGNED LONG)
+    DIM v AS _UNSIGNED LONG
+
+    FOR v = 0 TO voices - 1
+        SoftSynth_SetVoiceFrequency v, 8363 + v * 997
+        SoftSynth_SetVoiceBalance v, (v MOD 5) / 2! - 1!
+        SoftSynth_PlayVoice v, 0, v, 1, soundFrames \ 4, soundFrames - 1 - v
+    NEXT v
+END SUB
+
+SUB Test_SoftSynth
+    CONST TEST_VOICES = 64
+    CONST TEST_SOUND_FRAMES = 20000
+    CONST TEST_BUFFER_FRAMES = 2048
+    CONST TEST_UPDATES = 200
+    CONST TEST_RAMP_FRAMES = 100
+
+    DIM i AS LONG, sample AS STRING, maxError AS SINGLE
+    REDIM exact(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE, fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+
+    ' 16-bit sawtooth
+    sample = SPACE$(TEST_SOUND_FRAMES * 2)
+    FOR i = 0 TO TEST_SOUND_FRAMES - 1
+        MID$(sample, i * 2 + 1, 2) = MKI$((i * 613) MOD 65536 - 32768)
+    NEXT i
+
+    TEST_CASE_BEGIN "SoftSynth: Block mixer"
+    TEST_CHECK __SoftSynth_Initialize(44100), "__SoftSynth_Initialize(44100)"
+    __SoftSynth_LoadSound 0, sample, LEN(sample), 2, 1
+    SoftSynth_SetTotalVoices TEST_VOICES
+
+    SoftSynth_SetBitExactMixing _TRUE
+    Test_SoftSynthStartVoices TEST_VOICES, TEST_SOUND_FRAMES
+    __SoftSynth_Update exact(0), TEST_BUFFER_FRAMES
+
+    SoftSynth_SetBitExactMixing _FALSE
+    Test_SoftSynthStartVoices TEST_VOICES, TEST_SOUND_FRAMES
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+
+    FOR i = 0 TO TEST_BUFFER_FRAMES * 2 - 1
+        IF ABS(exact(i) - fast(i)) > maxError THEN maxError = ABS(exact(i) - fast(i))
+    NEXT i
+    TEST_CHECK maxError < 0.0001!, "maxError < 0.0001"
+    TEST_CHECK SoftSynth_GetActiveVoices = TEST_VOICES, "SoftSynth_GetActiveVoices = TEST_VOICES"
+
+    ' A one-shot voice stops at its end frame
+    SoftSynth_SetTotalVoices 1
+    SoftSynth_SetVoiceFrequency 0, 44100
+    SoftSynth_PlayVoice 0, 0, 0, 0, 0, 99
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    TEST_CHECK SoftSynth_GetActiveVoices = 0, "SoftSynth_GetActiveVoices = 0"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "SoftSynth: Block mixer performance"
+    SoftSynth_SetTotalVoices TEST_VOICES
+    Test_SoftSynthStartVoices TEST_VOICES, TEST_SOUND_FRAMES
+    FOR i = 1 TO TEST_UPDATES
+        __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    NEXT i
+    TEST_CHECK SoftSynth_GetActiveVoices = TEST_VOICES, "SoftSynth_GetActiveVoices = TEST_VOICES"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "SoftSynth: Interpolation modes"
+    SoftSynth_SetVoiceInterpolation 0, 2
+    TEST_CHECK SoftSynth_GetVoiceInterpolation(0) = 2, "SoftSynth_GetVoiceInterpolation(0) = 2"
+    SoftSynth_StopVoice 0
+    TEST_CHECK SoftSynth_GetVoiceInterpolation(0) = 2, "SoftSynth_GetVoiceInterpolation(0) = 2 after SoftSynth_StopVoice"
+    TEST_CASE_END
+
+    ' Each mode mixes the same voices. The per-voice cost is the time taken for one voice to render one second of audio
+    DIM mode AS LONG, v AS _UNSIGNED LONG, startTime AS DOUBLE, elapsed AS DOUBLE
+    DIM modeName(0 TO 3) AS STRING: modeName(0) = "nearest": modeName(1) = "linear": modeName(2) = "cubic": modeName(3) = "sinc"
+
+    FOR mode = 0 TO 3
+        TEST_CASE_BEGIN "SoftSynth: " + modeName(mode) + " interpolation performance"
+        FOR v = 0 TO TEST_VOICES - 1
+            SoftSynth_SetVoiceInterpolation v, mode
+        NEXT v
+        Test_SoftSynthStartVoices TEST_VOICES, TEST_SOUND_FRAMES
+        startTime = TIMER(0.001)
+        FOR i = 1 TO TEST_UPDATES
+            __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+        NEXT i
+        elapsed = TIMER(0.001) - startTime
+        IF elapsed < 0 THEN elapsed = elapsed + 86400 ' midnight rollover
+        TEST_CHECK SoftSynth_GetActiveVoices = TEST_VOICES, "SoftSynth_GetActiveVoices = TEST_VOICES"
+        TEST_CASE_END
+        PRINT USING "  ####.## us per voice per second of audio"; elapsed * 1000000# / TEST_VOICES / (TEST_UPDATES * TEST_BUFFER_FRAMES / 44100#)
+    NEXT mode
+
+    FOR v = 0 TO TEST_VOICES - 1
+        SoftSynth_SetVoiceInterpolation v, 1
+    NEXT v
+
+    TEST_CASE_BEGIN "SoftSynth: Multi-threaded mixing"
+    SoftSynth_SetMixerThreads 4
+    TEST_CHECK SoftSynth_GetMixerThreads = 4, "SoftSynth_GetMixerThreads = 4"
+    Test_SoftSynthStartVoices TEST_VOICES, TEST_SOUND_FRAMES
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    maxError = 0
+    FOR i = 0 TO TEST_BUFFER_FRAMES * 2 - 1
+        IF ABS(exact(i) - fast(i)) > maxError THEN maxError = ABS(exact(i) - fast(i))
+    NEXT i
+    TEST_CHECK maxError < 0.0001!, "maxError < 0.0001"
+    TEST_CHECK SoftSynth_GetActiveVoices = TEST_VOICES, "SoftSynth_GetActiveVoices = TEST_VOICES"
+    TEST_CASE_END
+
+    ' With good scaling the run time drops as threads are added. The voice count is raised along with the threads to show the other axis
+    DIM threads AS _UNSIGNED LONG, voices AS _UNSIGNED LONG
+    FOR voices = TEST_VOICES TO TEST_VOICES * 4 STEP TEST_VOICES * 3
+        SoftSynth_SetTotalVoices voices
+        threads = 1
+        DO
+            TEST_CASE_BEGIN "SoftSynth: " + _TRIM$(STR$(voices)) + " voices, " + _TRIM$(STR$(threads)) + " thread(s)"
+            SoftSynth_SetMixerThreads threads
+            Test_SoftSynthStartVoices voices, TEST_SOUND_FRAMES
+            FOR i = 1 TO TEST_UPDATES
+                __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+            NEXT i
+            TEST_CHECK SoftSynth_GetActiveVoices = voices, "SoftSynth_GetActiveVoices = voices"
+            TEST_CASE_END
+
+            IF threads >= HashTableBench_GetHardwareThreads THEN EXIT DO
+            threads = _MIN(threads * 2, HashTableBench_GetHardwareThreads)
+        LOOP
+    NEXT voices
+
+    SoftSynth_SetMixerThreads 1
+
+    TEST_CASE_BEGIN "SoftSynth: Native sound storage"
+    SoftSynth_SetNativeSoundStorage _TRUE
+    __SoftSynth_LoadSound 0, sample, LEN(sample), 2, 1
+    TEST_CHECK SoftSynth_GetSoundBytesPerSample(0) = 2, "SoftSynth_GetSoundBytesPerSample(0) = 2"
+    SoftSynth_SetTotalVoices TEST_VOICES
+    SoftSynth_SetBitExactMixing _TRUE
+    Test_SoftSynthStartVoices TEST_VOICES, TEST_SOUND_FRAMES
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    FOR i = 0 TO TEST_BUFFER_FRAMES * 2 - 1
+        IF exact(i) <> fast(i) THEN EXIT FOR
+    NEXT i
+    TEST_CHECK i = TEST_BUFFER_FRAMES * 2, "native output = converted output"
+    SoftSynth_SetBitExactMixing _FALSE
+    SoftSynth_SetNativeSoundStorage _FALSE
+    __SoftSynth_LoadSound 0, sample, LEN(sample), 2, 1
+    TEST_CHECK SoftSynth_GetSoundBytesPerSample(0) = 4, "SoftSynth_GetSoundBytesPerSample(0) = 4"
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "SoftSynth: Volume ramps"
+    sample = STRING$(TEST_SOUND_FRAMES, 64) ' 8-bit DC at half scale
+    __SoftSynth_LoadSound 1, sample, LEN(sample), 1, 1
+    SoftSynth_SetTotalVoices 1
+    SoftSynth_SetVoiceFrequency 0, 44100
+    SoftSynth_PlayVoice 0, 1, 0, 1, 0, TEST_SOUND_FRAMES - 1
+    SoftSynth_SetRampFrames TEST_RAMP_FRAMES
+    SoftSynth_SetVoiceVolume 0, 0!
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    TEST_CHECK ABS(fast(0) - 0.5! * COS(_PI / 4!)) < 0.0001!, "ramp starts at the old volume"
+    TEST_CHECK ABS(fast(TEST_RAMP_FRAMES) - 0.25! * COS(_PI / 4!)) < 0.0001!, "ramp is half way at the mid point"
+    TEST_CHECK fast(TEST_RAMP_FRAMES * 2) = 0!, "ramp ends at the new volume"
+    SoftSynth_SetRampFrames 0
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "SoftSynth: Reverse and ping-pong loops"
+    sample = SPACE$(1000 * 4) ' 32-bit ramp
+    FOR i = 0 TO 999
+        MID$(sample, i * 4 + 1, 4) = MKS$(i / 1000!)
+    NEXT i
+    __SoftSynth_LoadSound 2, sample, LEN(sample), 4, 1
+    SoftSynth_SetVoiceVolume 0, 1!
+    SoftSynth_SetVoiceBalance 0, -1!
+    SoftSynth_PlayVoice 0, 2, 999, 3, 0, 999
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    maxError = 0!
+    FOR i = 0 TO 999
+        maxError = _MAX(maxError, ABS(fast(i * 2) - (999 - i + SGN(i)) / 1000!)) ' like forward playback, the voice lags one frame behind
+    NEXT i
+    TEST_CHECK maxError < 0.0001!, "reverse playback"
+    TEST_CHECK fast(2000) = 0!, "reverse playback stops at the start frame"
+    ' A ping-pong loop must sound the same as a forward loop over a mirrored copy of the loop
+    FOR i = 0 TO 999
+        MID$(sample, i * 4 + 1, 4) = MKS$(((i * 37) MOD 101) / 101!) ' jagged so that a skipped or repeated frame shows up
+    NEXT i
+    __SoftSynth_LoadSound 3, sample, LEN(sample), 4, 1
+    DIM mirrored AS STRING: mirrored = LEFT$(sample, 200 * 4) ' frames 0 - 199 and then 198 - 100, so the loop is 100 - 298
+    FOR i = 198 TO 100 STEP -1
+        mirrored = mirrored + MID$(sample, i * 4 + 1, 4)
+    NEXT i
+    __SoftSynth_LoadSound 4, mirrored, LEN(mirrored), 4, 1
+    SoftSynth_SetVoiceInterpolation 0, 1
+    SoftSynth_SetVoiceFrequency 0, 33075 ' 3/4 speed, so that the loop ends fall between frames
+    SoftSynth_PlayVoice 0, 3, 0, 2, 100, 199
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    SoftSynth_PlayVoice 0, 4, 0, 1, 100, 298
+    REDIM exact(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update exact(0), TEST_BUFFER_FRAMES
+    maxError = 0!
+    FOR i = 0 TO TEST_BUFFER_FRAMES * 2 - 1
+        maxError = _MAX(maxError, ABS(fast(i) - exact(i)))
+    NEXT i
+    TEST_CHECK maxError < 0.0001!, "ping-pong loop = forward loop over a mirrored copy"
+    SoftSynth_SetVoiceFrequency 0, 44100
+    SoftSynth_SetVoiceBalance 0, 0!
+    SoftSynth_PlayVoice 0, 1, 0, 1, 0, TEST_SOUND_FRAMES - 1 ' back to the DC loop for the next test
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "SoftSynth: Mix buses"
+    DIM fxBus AS LONG: fxBus = __SoftSynth_CreateBus("fx" + _CHR_NUL)
+    TEST_CHECK fxBus = 1, "fxBus = 1"
+    TEST_CHECK __SoftSynth_CreateBus("fx" + _CHR_NUL) = fxBus, "creating an existing bus returns it"
+    TEST_CHECK __SoftSynth_GetBus("main" + _CHR_NUL) = 0, "main bus exists"
+    TEST_CHECK __SoftSynth_GetBus("none" + _CHR_NUL) = -1, "unknown bus"
+    SoftSynth_SetVoiceVolume 0, 1!
+    SoftSynth_SetVoiceBus 0, fxBus
+    SoftSynth_SetBusGain fxBus, 0.5!
+    SoftSynth_SetGlobalVolume 0.5!
+    REDIM exact(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    FOR i = 0 TO TEST_BUFFER_FRAMES * 2 - 1
+        exact(i) = 0.25!
+    NEXT i
+    SoftSynth_MixBusBuffer 0, exact(0), TEST_BUFFER_FRAMES
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    TEST_CHECK ABS(fast(0) - (0.25! + 0.25! * COS(_PI / 4!)) * 0.5!) < 0.0001!, "buses are summed before the global volume"
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    TEST_CHECK ABS(fast(0) - 0.125! * COS(_PI / 4!)) < 0.0001!, "external buffers are mixed once"
+    SoftSynth_SetGlobalVolume 1!
+    FOR i = 0 TO TEST_BUFFER_FRAMES * 2 - 1
+        exact(i) = 4!
+    NEXT i
+    SoftSynth_MixBusBuffer fxBus, exact(0), TEST_BUFFER_FRAMES
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    TEST_CHECK fast(0) = 1! AND fast(TEST_BUFFER_FRAMES * 2 - 1) = 1!, "output is clipped"
+    SoftSynth_SetVoiceBus 0, 0
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "SoftSynth: Reverb send"
+    SoftSynth_SetVoiceReverbSend 0, 1!
+    REDIM exact(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update exact(0), TEST_BUFFER_FRAMES
+    TEST_CHECK ABS(exact(0) - 0.5! * COS(_PI / 4!)) < 0.0001!, "sends are ignored while the reverb is off"
+    SoftSynth_SetReverbEnabled _TRUE
+    TEST_CHECK SoftSynth_GetReverbBus = fxBus + 1, "SoftSynth_GetReverbBus = fxBus + 1"
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    TEST_CHECK fast(TEST_BUFFER_FRAMES * 2 - 1) <> exact(TEST_BUFFER_FRAMES * 2 - 1), "the reverb is mixed in"
+    SoftSynth_StopVoice 0
+    REDIM fast(0 TO TEST_BUFFER_FRAMES * 2 - 1) AS SINGLE
+    __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+    TEST_CHECK fast(0) <> 0!, "the reverb tail outlives the voice"
+    SoftSynth_SetReverbEnabled _FALSE
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "SoftSynth: Command queue"
+    SoftSynth_SetCommandQueueEnabled _TRUE
+    SoftSynth_SetCommandOffset 100
+    SoftSynth_PlayVoice 0, 1, 0, 1, 0, TEST_SOUND_FRAMES - 1
+    SoftSynth_SetVoiceVolume 0, 0.5!
+    TEST_CHECK SoftSynth_GetVoiceVolume(0) = 0.5!, "voice getters return queued settings"
+    REDIM fast(0 TO 511) AS SINGLE
+    __SoftSynth_Update fast(0), 256
+    TEST_CHECK fast(198) = 0! AND fast(200) <> 0!, "queued commands are applied at their frame"
+    SoftSynth_SetCommandOffset 300
+    SoftSynth_StopVoice 0
+    REDIM fast(0 TO 511) AS SINGLE
+    __SoftSynth_Update fast(0), 256
+    TEST_CHECK fast(511) <> 0!, "commands due after the update wait"
+    REDIM fast(0 TO 511) AS SINGLE
+    __SoftSynth_Update fast(0), 256
+    TEST_CHECK fast(86) <> 0! AND fast(88) = 0!, "commands are applied in the update they are due in"
+    SoftSynth_SetCommandOffset 0
+    SoftSynth_SetVoiceVolume 0, 0!
+    SoftSynth_SetCommandQueueEnabled _FALSE
+    SoftSynth_SetVoiceVolume 0, 1!
+    SoftSynth_PlayVoice 0, 1, 0, 1, 0, TEST_SOUND_FRAMES - 1
+    REDIM fast(0 TO 511) AS SINGLE
+    __SoftSynth_Update fast(0), 256
+    TEST_CHECK fast(0) <> 0! AND fast(511) <> 0!, "disabling the queue applies queued commands before direct changes"
+    SoftSynth_StopVoice 0
+    TEST_CASE_END
+
+    TEST_CASE_BEGIN "SoftSynth: Render thread"
+    SoftSynth_SetVoiceFrequency 0, 22050
+    SoftSynth_PlayVoice 0, 1, 0, 1, 0, TEST_SOUND_FRAMES - 1
+    SoftSynth_StartRenderThread 4096, 256
+    TEST_CHECK SoftSynth_IsRenderThreadRunning, "SoftSynth_IsRenderThreadRunning"
+    startTime = TIMER(0.001)
+    DO WHILE SoftSynth_GetRenderBufferedFrames < 4096 AND ABS(TIMER(0.001) - startTime) < 5#
+        _DELAY 0.001
+    LOOP
+    TEST_CHECK SoftSynth_GetRenderBufferedFrames >= 4096, "the render thread mixes ahead to the latency target"
+    REDIM fast(0 TO 2047) AS SINGLE
+    TEST_CHECK __SoftSynth_ReadRenderBuffer(fast(0), 1024) = 1024, "__SoftSynth_ReadRenderBuffer(fast(0), 1024) = 1024"
+    TEST_CHECK fast(2047) <> 0! AND SoftSynth_GetRenderUnderruns = 0, "mixed frames are read from the ring"
+    REDIM fast(0 TO 39999) AS SINGLE
+    TEST_CHECK __SoftSynth_ReadRenderBuffer(fast(0), 20000) < 20000, "reads are limited to what has been mixed"
+    TEST_CHECK SoftSynth_GetRenderUnderruns = 1 AND fast(39999) = 0!, "running out of mixed frames is an underrun"
+    SoftSynth_PokeSoundFrameByte 1, 0, -1
+    TEST_CHECK SoftSynth_PeekSoundFrameByte(1, 0) = -1, "sound frames can be poked while the render thread runs"
+    SoftSynth_PokeSoundFrameByte 1, 0, 64
+    SoftSynth_StopRenderThread
+    TEST_CHECK _NEGATE SoftSynth_IsRenderThreadRunning, "_NEGATE SoftSynth_IsRenderThreadRunning"
+    SoftSynth_SetCommandQueueEnabled _FALSE
+    SoftSynth_StopVoice 0
+    TEST_CASE_END
+
+    ' The reverb runs once per update, so its cost does not depend on the voices. It is the extra time taken to render one second of audio
+    DIM rate AS LONG, reverbTime(0 TO 1) AS DOUBLE
+    DIM sampleRate(0 TO 1) AS _UNSIGNED LONG: sampleRate(0) = 44100: sampleRate(1) = 48000
+
+    FOR rate = 0 TO 1
+        TEST_CASE_BEGIN "SoftSynth: Reverb performance at" + STR$(sampleRate(rate)) + " Hz"
+        __SoftSynth_Finalize
+        TEST_CHECK __SoftSynth_Initialize(sampleRate(rate)), "__SoftSynth_Initialize(sampleRate(rate))"
+        __SoftSynth_LoadSound 0, sample, LEN(sample), 1, 1
+        SoftSynth_SetTotalVoices TEST_VOICES
+        FOR v = 0 TO TEST_VOICES - 1
+            SoftSynth_SetVoiceReverbSend v, 0.5!
+        NEXT v
+        FOR mode = 0 TO 1
+            SoftSynth_SetReverbEnabled mode
+            Test_SoftSynthStartVoices TEST_VOICES, TEST_SOUND_FRAMES
+            startTime = TIMER(0.001)
+            FOR i = 1 TO TEST_UPDATES
+                __SoftSynth_Update fast(0), TEST_BUFFER_FRAMES
+            NEXT i
+            reverbTime(mode) = TIMER(0.001) - startTime
+            IF reverbTime(mode) < 0 THEN reverbTime(mode) = reverbTime(mode) + 86400 ' midnight rollover
+        NEXT mode
+        TEST_CHECK SoftSynth_GetActiveVoices = TEST_VOICES, "SoftSynth_GetActiveVoices = TEST_VOICES"
+        TEST_CASE_END
+        PRINT USING "  ####.## us reverb per second of audio"; (reverbTime(1) - reverbTime(0)) * 1000000# / (TEST_UPDATES * TEST_BUFFER_FRAMES / sampleRate(rate))
+    NEXT rate
+
+    __SoftSynth_Finalize
+END SUB
+
+' Builds a song in the reference player arrays that exercises the implemented effects (except the random waveforms)
+SUB Test_MODPlayerMakeSong (channels AS _UNSIGNED LONG)
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+    SHARED MODPlayerRef_Order() AS _UNSIGNED INTEGER
+    SHARED MODPlayerRef_Pattern() AS MODPlayerRef_NoteType
+    SHARED MODPlayerRef_Instrument() AS MODPlayerRef_InstrumentType
+    SHARED MODPlayerRef_Channel() AS MODPlayerRef_ChannelType
+
+    DIM AS LONG p, r, c, k
+    DIM extended(0 TO 14) AS _UNSIGNED _BYTE
+
+    extended(0) = &H12: extended(1) = &H23: extended(2) = &H31: extended(3) = &H41: extended(4) = &H42
+    extended(5) = &H52: extended(6) = &H71: extended(7) = &H72: extended(8) = &H8A: extended(9) = &H92
+    extended(10) = &HA3: extended(11) = &HB2: extended(12) = &HC2: extended(13) = &HD1: extended(14) = &HF6
+
+    MODPlayerRef_LoadTables
+
+    MODPlayerRef_Song.channels = channels
+    MODPlayerRef_Song.instruments = 3
+    MODPlayerRef_Song.orders = 4
+    MODPlayerRef_Song.rows = 32
+    MODPlayerRef_Song.patterns = 3
+    MODPlayerRef_Song.endJumpOrder = 0
+    MODPlayerRef_Song.defaultSpeed = 4
+    MODPlayerRef_Song.defaultBPM = 125
+    MODPlayerRef_Song.useST300VolumeSlides = _TRUE
+    MODPlayerRef_Song.isLooping = _FALSE
+    MODPlayerRef_Song.patternDelay = 0
+
+    REDIM MODPlayerRef_Order(0 TO 3) AS _UNSIGNED INTEGER
+    MODPlayerRef_Order(0) = 0: MODPlayerRef_Order(1) = 1: MODPlayerRef_Order(2) = MODPLAYERREF_PATTERN_MARKER: MODPlayerRef_Order(3) = 2
+
+    ' Forward looping 8-bit, one-shot 16-bit and a detuned forward looping 8-bit instrument
+    REDIM MODPlayerRef_Instrument(0 TO 2) AS MODPlayerRef_InstrumentType
+    MODPlayerRef_Instrument(0).length = 4000: MODPlayerRef_Instrument(0).c2Spd = 8363: MODPlayerRef_Instrument(0).volume = 64
+    MODPlayerRef_Instrument(0).loopStart = 1000: MODPlayerRef_Instrument(0).loopEnd = 4000: MODPlayerRef_Instrument(0).playMode = MODPLAYERREF_PLAY_FORWARD_LOOP
+    MODPlayerRef_Instrument(0).bytesPerSample = 1: MODPlayerRef_Instrument(0).channels = 1
+    MODPlayerRef_Instrument(1).length = 8000: MODPlayerRef_Instrument(1).c2Spd = 8363: MODPlayerRef_Instrument(1).volume = 56
+    MODPlayerRef_Instrument(1).loopStart = 0: MODPlayerRef_Instrument(1).loopEnd = 8000: MODPlayerRef_Instrument(1).playMode = 0
+    MODPlayerRef_Instrument(1).bytesPerSample = 2: MODPlayerRef_Instrument(1).channels = 1
+    MODPlayerRef_Instrument(2).length = 4000: MODPlayerRef_Instrument(2).c2Spd = 8000: MODPlayerRef_Instrument(2).volume = 48
+    MODPlayerRef_Instrument(2).loopStart = 0: MODPlayerRef_Instrument(2).loopEnd = 4000: MODPlayerRef_Instrument(2).playMode = MODPLAYERREF_PLAY_FORWARD_LOOP
+    MODPlayerRef_Instrument(2).bytesPerSample = 1: MODPlayerRef_Instrument(2).channels = 1
+
+    REDIM MODPlayerRef_Channel(0 TO channels - 1) AS MODPlayerRef_ChannelType
+    REDIM MODPlayerRef_Pattern(0 TO 2, 0 TO 31, 0 TO channels - 1) AS MODPlayerRef_NoteType
+
+    FOR p = 0 TO 2
+        FOR r = 0 TO 31
+            FOR c = 0 TO channels - 1
+                ' Every channel gets a note on the first row so that no effect runs without a period
+                IF (r + c) MOD 4 = 0 _ORELSE (p = 0 _ANDALSO r = 0) THEN
+                    MODPlayerRef_Pattern(p, r, c).note = 36 + (r * 7 + c * 5 + p * 3) MOD 36
+                    MODPlayerRef_Pattern(p, r, c).instrument = 1 + (r \ 4 + c) MOD 3
+                ELSE
+                    MODPlayerRef_Pattern(p, r, c).note = MODPLAYERREF_NOTE_NONE
+                END IF
+                IF (r + c) MOD 8 = 4 THEN MODPlayerRef_Pattern(p, r, c).volume = 40 ELSE MODPlayerRef_Pattern(p, r, c).volume = MODPLAYERREF_NOTE_NO_VOLUME
+
+                k = (r + c * 3 + p * 5) MOD 24
+                IF p = 0 _ANDALSO r = 0 THEN k = 23
+
+                SELECT CASE k
+                    CASE 0: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_ARPEGGIO: MODPlayerRef_Pattern(p, r, c).operand = &H37
+                    CASE 1: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_PORTAMENTO_UP: MODPlayerRef_Pattern(p, r, c).operand = &H02
+                    CASE 2: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_PORTAMENTO_DOWN: MODPlayerRef_Pattern(p, r, c).operand = &H03
+                    CASE 3: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_PORTAMENTO: MODPlayerRef_Pattern(p, r, c).operand = &H10
+                    CASE 4: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_VIBRATO: MODPlayerRef_Pattern(p, r, c).operand = &H46
+                    CASE 5: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_PORTAMENTO_VOLUME_SLIDE: MODPlayerRef_Pattern(p, r, c).operand = &H02
+                    CASE 6: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_VIBRATO_VOLUME_SLIDE: MODPlayerRef_Pattern(p, r, c).operand = &H20
+                    CASE 7: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_TREMOLO: MODPlayerRef_Pattern(p, r, c).operand = &H58
+                    CASE 8: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_PANNING_8: MODPlayerRef_Pattern(p, r, c).operand = (c * 40 + r) MOD 256
+                    CASE 9: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_SAMPLE_OFFSET: MODPlayerRef_Pattern(p, r, c).operand = &H02
+                    CASE 10: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_VOLUME_SLIDE: MODPlayerRef_Pattern(p, r, c).operand = &H03
+                    CASE 11: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_VOLUME: MODPlayerRef_Pattern(p, r, c).operand = &H30
+                    CASE 12: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_EXTENDED: MODPlayerRef_Pattern(p, r, c).operand = extended((r + p + c) MOD 15)
+                    CASE 13: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_VOLUME_FINE_SLIDE: IF r MOD 2 THEN MODPlayerRef_Pattern(p, r, c).operand = &H2F ELSE MODPlayerRef_Pattern(p, r, c).operand = &HF2
+                    CASE 14: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_PORTAMENTO_EXTRA_FINE_DOWN: MODPlayerRef_Pattern(p, r, c).operand = &HE3
+                    CASE 15: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_PORTAMENTO_EXTRA_FINE_UP: MODPlayerRef_Pattern(p, r, c).operand = &HF1
+                    CASE 16: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_TREMOR: MODPlayerRef_Pattern(p, r, c).operand = &H21
+                    CASE 17: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_VIBRATO_VOLUME_FINE_SLIDE: MODPlayerRef_Pattern(p, r, c).operand = &H00
+                    CASE 18: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_CHANNEL_VOLUME: MODPlayerRef_Pattern(p, r, c).operand = &H28
+                    CASE 19: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_NOTE_RETRIGGER_VOLUME_SLIDE: MODPlayerRef_Pattern(p, r, c).operand = &H62 + (r MOD 3) * &H41 ' 62, A3 and E4
+                    CASE 20: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_VIBRATO_FINE: MODPlayerRef_Pattern(p, r, c).operand = &H34
+                    CASE 21: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_GLOBAL_VOLUME: MODPlayerRef_Pattern(p, r, c).operand = &H30 + r MOD 16
+                    CASE 22: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_EXTENDED: MODPlayerRef_Pattern(p, r, c).operand = &H91 + r MOD 3
+                    CASE ELSE: MODPlayerRef_Pattern(p, r, c).effect = MODPLAYERREF_FX_ARPEGGIO: MODPlayerRef_Pattern(p, r, c).operand = 0
+                END SELECT
+            NEXT c
+        NEXT r
+    NEXT p
+
+    ' Song flow effects on the first channel
+    MODPlayerRef_Pattern(0, 8, 0).effect = MODPLAYERREF_FX_SPEED_TEMPO: MODPlayerRef_Pattern(0, 8, 0).operand = 150
+    MODPlayerRef_Pattern(0, 12, 0).effect = MODPLAYERREF_FX_EXTENDED: MODPlayerRef_Pattern(0, 12, 0).operand = &H60
+    MODPlayerRef_Pattern(0, 15, 0).effect = MODPLAYERREF_FX_EXTENDED: MODPlayerRef_Pattern(0, 15, 0).operand = &H62
+    MODPlayerRef_Pattern(0, 20, 0).effect = MODPLAYERREF_FX_EXTENDED: MODPlayerRef_Pattern(0, 20, 0).operand = &HE2
+    MODPlayerRef_Pattern(0, 28, 0).effect = MODPLAYERREF_FX_PATTERN_BREAK: MODPlayerRef_Pattern(0, 28, 0).operand = &H10
+    MODPlayerRef_Pattern(1, 4, 0).effect = MODPLAYERREF_FX_SPEED: MODPlayerRef_Pattern(1, 4, 0).operand = 3
+    MODPlayerRef_Pattern(1, 16, 0).effect = MODPLAYERREF_FX_TEMPO: MODPlayerRef_Pattern(1, 16, 0).operand = &H7D
+    MODPlayerRef_Pattern(1, 24, 0).effect = MODPLAYERREF_FX_POSITION_JUMP: MODPlayerRef_Pattern(1, 24, 0).operand = 2
+    MODPlayerRef_Pattern(2, 6, 0).effect = MODPLAYERREF_FX_SPEED_TEMPO: MODPlayerRef_Pattern(2, 6, 0).operand = 5
+END SUB
+
+' Copies the reference player song to the native sequencer the same way __MODPlayer_UploadSong does
+SUB Test_MODPlayerUploadSong
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+    SHARED MODPlayerRef_Order() AS _UNSIGNED INTEGER
+    SHARED MODPlayerRef_Pattern() AS MODPlayerRef_NoteType
+    SHARED MODPlayerRef_Instrument() AS MODPlayerRef_InstrumentType
+    SHARED MODPlayerRef_PeriodTable() AS _UNSIGNED INTEGER
+    SHARED MODPlayerRef_SineTable() AS _UNSIGNED _BYTE
+    SHARED MODPlayerRef_InvertLoopSpeedTable() AS _UNSIGNED _BYTE
+
+    DIM AS LONG i, r, c
+
+    TEST_REQUIRE __MODPlayer_Initialize(MODPlayerRef_Song.channels, MODPlayerRef_Song.orders, MODPlayerRef_Song.rows, MODPlayerRef_Song.patterns, MODPlayerRef_Song.instruments, MODPlayerRef_Song.endJumpOrder, MODPlayerRef_Song.defaultSpeed, MODPlayerRef_Song.defaultBPM, MODPlayerRef_Song.useST300VolumeSlides), "__MODPlayer_Initialize"
+    __MODPlayer_SetTables MODPlayerRef_PeriodTable(0), MODPlayerRef_Song.periodTableMax + 1, MODPlayerRef_SineTable(0), UBOUND(MODPlayerRef_SineTable) + 1, MODPlayerRef_InvertLoopSpeedTable(0), UBOUND(MODPlayerRef_InvertLoopSpeedTable) + 1
+    __MODPlayer_SetOrders MODPlayerRef_Order(0)
+
+    FOR i = 0 TO MODPlayerRef_Song.instruments - 1
+        __MODPlayer_SetInstrument i, MODPlayerRef_Instrument(i).length, MODPlayerRef_Instrument(i).c2Spd, MODPlayerRef_Instrument(i).volume, MODPlayerRef_Instrument(i).loopStart, MODPlayerRef_Instrument(i).loopEnd, MODPlayerRef_Instrument(i).playMode, MODPlayerRef_Instrument(i).bytesPerSample, MODPlayerRef_Instrument(i).channels
+    NEXT i
+
+    FOR i = 0 TO MODPlayerRef_Song.patterns - 1
+        FOR r = 0 TO MODPlayerRef_Song.rows - 1
+            FOR c = 0 TO MODPlayerRef_Song.channels - 1
+                __MODPlayer_SetNote i, r, c, MODPlayerRef_Pattern(i, r, c).note, MODPlayerRef_Pattern(i, r, c).instrument, MODPlayerRef_Pattern(i, r, c).volume, MODPlayerRef_Pattern(i, r, c).effect, MODPlayerRef_Pattern(i, r, c).operand
+            NEXT c
+        NEXT r
+    NEXT i
+END SUB
+
+' (Re)starts the mixer with fresh instrument samples. The invert loop effect changes sample data, so each run needs its own copy
+SUB Test_MODPlayerStartSoftSynth (channels AS _UNSIGNED LONG)
+    DIM i AS LONG, sample8 AS STRING, sample16 AS STRING
+
+    sample8 = SPACE$(4000)
+    FOR i = 0 TO 3999
+        ASC(sample8, i + 1) = (i * 37) MOD 256
+    NEXT i
+
+    sample16 = SPACE$(8000)
+    FOR i = 0 TO 3999
+        MID$(sample16, i * 2 + 1, 2) = MKI$((i * 1013) MOD 65536 - 32768)
+    NEXT i
+
+    __SoftSynth_Finalize
+    TEST_REQUIRE __SoftSynth_Initialize(44100), "__SoftSynth_Initialize(44100)"
+    __SoftSynth_LoadSound 0, sample8, LEN(sample8), 1, 1
+    __SoftSynth_LoadSound 1, sample16, LEN(sample16), 2, 1
+    __SoftSynth_LoadSound 2, sample8, LEN(sample8), 1, 1
+    SoftSynth_SetTotalVoices channels
+END SUB
+
+SUB Test_MODPlayer
+    SHARED MODPlayerRef_Song AS MODPlayerRef_SongType
+
+    CONST TEST_CHANNELS = 8
+    CONST TEST_TICKS_MAX = 4000
+    CONST TEST_BENCH_CHANNELS = 32
+    CONST TEST_BENCH_TICKS = 2000
+
+    DIM AS LONG i, v, ticks, nativeTicks, mismatches
+    DIM frames AS _UNSIGNED LONG, sum AS DOUBLE
+    DIM frequency(0 TO TEST_TICKS_MAX - 1, 0 TO TEST_CHANNELS - 1) AS _UNSIGNED LONG
+    DIM volume(0 TO TEST_TICKS_MAX - 1, 0 TO TEST_CHANNELS - 1) AS SINGLE
+    DIM balance(0 TO TEST_TICKS_MAX - 1, 0 TO TEST_CHANNELS - 1) AS SINGLE
+    DIM position(0 TO TEST_TICKS_MAX - 1) AS LONG, row(0 TO TEST_TICKS_MAX - 1) AS INTEGER
+    DIM speed(0 TO TEST_TICKS_MAX - 1) AS _UNSIGNED _BYTE, bpm(0 TO TEST_TICKS_MAX - 1) AS _UNSIGNED _BYTE
+    DIM tickFrames(0 TO TEST_TICKS_MAX - 1) AS _UNSIGNED LONG, mixSum(0 TO TEST_TICKS_MAX - 1) AS DOUBLE
+    DIM buffer(0 TO 16383) AS SINGLE
+
+    TEST_CASE_BEGIN "MODPlayer: Native sequencer matches BASIC"
+    Test_MODPlayerMakeSong TEST_CHANNELS
+    Test_MODPlayerUploadSong ' before the reference player runs, since finetune effects change its instruments
+
+    ' Record the voice state and mixer output of every tick of the BASIC sequencer
+    Test_MODPlayerStartSoftSynth TEST_CHANNELS
+    MODPlayerRef_Play
+    DO
+        frames = MODPlayerRef_Update
+        IF frames = 0 THEN EXIT DO
+
+        FOR v = 0 TO TEST_CHANNELS - 1
+            frequency(ticks, v) = SoftSynth_GetVoiceFrequency(v)
+            volume(ticks, v) = SoftSynth_GetVoiceVolume(v)
+            balance(ticks, v) = SoftSynth_GetVoiceBalance(v)
+        NEXT v
+        position(ticks) = MODPlayerRef_Song.orderPosition
+        row(ticks) = MODPlayerRef_Song.patternRow
+        speed(ticks) = MODPlayerRef_Song.speed
+        bpm(ticks) = MODPlayerRef_Song.BPM
+        tickFrames(ticks) = frames
+
+        __SoftSynth_Update buffer(0), frames
+        sum = 0
+        FOR i = 0 TO frames * 2 - 1
+            sum = sum + buffer(i)
+        NEXT i
+        mixSum(ticks) = sum
+
+        ticks = ticks + 1
+    LOOP WHILE ticks < TEST_TICKS_MAX
+    TEST_CHECK ticks > 300 _ANDALSO ticks < TEST_TICKS_MAX, "ticks > 300 _ANDALSO ticks < TEST_TICKS_MAX"
+    TEST_CHECK_FALSE MODPlayerRef_Song.isPlaying, "MODPlayerRef_Song.isPlaying"
+
+    ' Play the same song with the native sequencer and compare every tick
+    Test_MODPlayerStartSoftSynth TEST_CHANNELS
+    __MODPlayer_Play
+    DO
+        frames = __MODPlayer_Update
+        IF frames = 0 _ORELSE nativeTicks >= ticks THEN EXIT DO
+
+        FOR v = 0 TO TEST_CHANNELS - 1
+            IF SoftSynth_GetVoiceFrequency(v) <> frequency(nativeTicks, v) _ORELSE SoftSynth_GetVoiceVolume(v) <> volume(nativeTicks, v) _ORELSE ABS(SoftSynth_GetVoiceBalance(v) - balance(nativeTicks, v)) > 0.00001! THEN
+                IF mismatches = 0 THEN PRINT "  voice"; v; "differs at tick"; nativeTicks
+                mismatches = mismatches + 1
+            END IF
+        NEXT v
+        IF __MODPlayer_GetPosition <> position(nativeTicks) _ORELSE __MODPlayer_GetRow <> row(nativeTicks) _ORELSE __MODPlayer_GetSpeed <> speed(nativeTicks) _ORELSE __MODPlayer_GetBPM <> bpm(nativeTicks) _ORELSE frames <> tickFrames(nativeTicks) THEN
+            IF mismatches = 0 THEN PRINT "  song state differs at tick"; nativeTicks
+            mismatches = mismatches + 1
+        END IF
+
+        __SoftSynth_Update buffer(0), frames
+        sum = 0
+        FOR i = 0 TO frames * 2 - 1
+            sum = sum + buffer(i)
+        NEXT i
+        IF ABS(sum - mixSum(nativeTicks)) > 0.001# THEN
+            IF mismatches = 0 THEN PRINT "  mixer output differs at tick"; nativeTicks
+            mismatches = mismatches + 1
+        END IF
+
+        nativeTicks = nativeTicks + 1
+    LOOP
+    TEST_CHECK nativeTicks = ticks, "nativeTicks = ticks"
+    TEST_CHECK mismatches = 0, "mismatches = 0"
+    TEST_CHECK_FALSE __MODPlayer_IsPlaying, "__MODPlayer_IsPlaying"
+    TEST_CASE_END
+
+    ' The time taken by the sequencer alone to process one tick of a looping song
+    DIM startTime AS DOUBLE, elapsed(0 TO 1) AS DOUBLE
+
+    TEST_CASE_BEGIN "MODPlayer: Sequencer performance"
+    Test_MODPlayerMakeSong TEST_BENCH_CHANNELS
+    Test_MODPlayerUploadSong
+    Test_MODPlayerStartSoftSynth TEST_BENCH_CHANNELS
+
+    MODPlayerRef_Play
+    MODPlayerRef_Song.isLooping = _TRUE
+    ticks = 0
+    startTime = TIMER(0.001)
+    FOR i = 1 TO TEST_BENCH_TICKS
+        IF MODPlayerRef_Update THEN ticks = ticks + 1
+    NEXT i
+    elapsed(0) = TIMER(0.001) - startTime
+    TEST_CHECK ticks = TEST_BENCH_TICKS, "ticks = TEST_BENCH_TICKS"
+
+    __MODPlayer_Play
+    __MODPlayer_SetLooping _TRUE
+    nativeTicks = 0
+    startTime = TIMER(0.001)
+    FOR i = 1 TO TEST_BENCH_TICKS
+        IF __MODPlayer_Update THEN nativeTicks = nativeTicks + 1
+    NEXT i
+    elapsed(1) = TIMER(0.001) - startTime
+    TEST_CHECK nativeTicks = TEST_BENCH_TICKS, "nativeTicks = TEST_BENCH_TICKS"
+
+    FOR i = 0 TO 1
+        IF elapsed(i) < 0 THEN elapsed(i) = elapsed(i) + 86400 ' midnight rollover
+    NEXT i
+    TEST_CASE_END
+    PRINT USING "  ####.## us per tick (BASIC), ####.## us per tick (native)"; elapsed(0) * 1000000# / TEST_BENCH_TICKS; elapsed(1) * 1000000# / TEST_BENCH_TICKS
+
+    __MODPlayer_Finalize
+    __SoftSynth_Finalize
+END SUB
+
+'$INCLUDE:'MODPlayerRef.bas'
 '$INCLUDE:'../DS/HashTable.bas'
+'$INCLUDE:'../DS/MemFile.bas'
 '$INCLUDE:'../Debug/Test.bas'